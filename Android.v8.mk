@@ -267,8 +267,10 @@ LOCAL_SRC_FILES := \
 	src/gdb-jit.cc \
 	src/global-handles.cc \
 	src/handles.cc \
+	src/heap/array-buffer-collector.cc \
 	src/heap/array-buffer-tracker.cc \
 	src/heap/code-stats.cc \
+	src/heap/concurrent-marking.cc \
 	src/heap/embedder-tracing.cc \
 	src/heap/gc-idle-time-handler.cc \
 	src/heap/gc-tracer.cc \
@@ -356,6 +358,7 @@ LOCAL_SRC_FILES := \
 	src/profiler/cpu-profiler.cc \
 	src/profiler/heap-profiler.cc \
 	src/profiler/heap-snapshot-generator.cc \
+	src/profiler/pprof-profile-builder.cc \
 	src/profiler/profile-generator.cc \
 	src/profiler/profiler-listener.cc \
 	src/profiler/sampling-heap-profiler.cc \
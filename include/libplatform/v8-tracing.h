@@ -112,6 +112,10 @@ class V8_PLATFORM_EXPORT TraceWriter {
   virtual void Flush() = 0;
 
   static TraceWriter* CreateJSONTraceWriter(std::ostream& stream);
+  // Writes a compact binary trace that can be converted to the JSON trace
+  // format with tools/trace-binary-to-json.py. The stream must be opened in
+  // binary mode.
+  static TraceWriter* CreateBinaryTraceWriter(std::ostream& stream);
 
  private:
   // Disallow copy and assign
@@ -15,6 +15,7 @@
 namespace v8 {
 
 class HeapGraphNode;
+class OutputStream;
 struct HeapStatsUpdate;
 
 typedef uint32_t SnapshotObjectId;
@@ -266,6 +267,14 @@ class V8_EXPORT CpuProfile {
    */
   int64_t GetEndTime() const;
 
+  /**
+   * Writes the profile to |stream| in the pprof protocol buffer format, see
+   * https://github.com/google/pprof/blob/master/proto/profile.proto.
+   * Code inlined into optimized functions is reported as separate frames and
+   * ticks are reported per source line. Returns false if the stream aborted.
+   */
+  bool WritePprof(OutputStream* stream) const;
+
   /**
    * Deletes the profile and removes it from CpuProfiler's list.
    * All pointers to nodes previously returned become invalid.
@@ -329,6 +338,12 @@ class V8_EXPORT CpuProfiler {
    */
   void SetIdle(bool is_idle);
 
+  /**
+   * Returns the number of samples dropped since the profiler was created
+   * because the profiler could not keep up with the sampling rate.
+   */
+  unsigned GetDroppedSamplesCount() const;
+
  private:
   CpuProfiler();
   ~CpuProfiler();
@@ -628,6 +643,10 @@ class V8_EXPORT HeapProfiler {
   enum SamplingFlags {
     kSamplingNoFlags = 0,
     kSamplingForceGC = 1 << 0,
+    // Only sampled allocations are recorded, not whether the sampled
+    // objects are still alive. The recorded stacks are bounded and are
+    // retrieved and reset with WriteAllocationProfileDelta.
+    kSamplingDeltaProfiles = 1 << 1,
   };
 
   typedef std::unordered_set<const v8::PersistentBase<v8::Value>*>
@@ -711,6 +730,18 @@ class V8_EXPORT HeapProfiler {
       ActivityControl* control = NULL,
       ObjectNameResolver* global_object_name_resolver = NULL);
 
+  /**
+   * Takes a heap snapshot and writes it to |stream| in a compact binary
+   * format while the heap is being traversed. Unlike TakeHeapSnapshot, the
+   * references between objects are not kept in memory, which bounds the
+   * memory used by the profiler when snapshotting large heaps. The snapshot
+   * is not retained. Returns false if it was aborted by |control| or by
+   * the stream.
+   */
+  bool TakeStreamingHeapSnapshot(
+      OutputStream* stream, ActivityControl* control = NULL,
+      ObjectNameResolver* global_object_name_resolver = NULL);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
@@ -789,6 +820,18 @@ class V8_EXPORT HeapProfiler {
    */
   AllocationProfile* GetAllocationProfile();
 
+  /**
+   * Writes the allocations sampled since the previous call, or since
+   * StartSamplingHeapProfiler was called, to |stream| as an uncompressed pprof
+   * protocol buffer and discards them. Each sample carries the estimated
+   * number and size of allocations with their stack trace. Requires the
+   * sampling heap profiler to be started with kSamplingDeltaProfiles.
+   * Meant to be called periodically for continuous allocation profiling.
+   * Returns false if the profiler is not running in that mode or the stream
+   * aborted.
+   */
+  bool WriteAllocationProfileDelta(OutputStream* stream);
+
   /**
    * Deletes all snapshots taken. All previously returned pointers to
    * snapshots and their contents become invalid after this call.
@@ -565,6 +565,14 @@ template <class T> class PersistentBase {
    */
   V8_INLINE void RegisterExternalReference(Isolate* isolate) const;
 
+  /**
+   * Like |RegisterExternalReference| but may be called from the tracing task
+   * with the given id while the embedder is asked to trace its heap through
+   * EmbedderHeapTracer::AdvanceTracingInParallel.
+   */
+  V8_INLINE void RegisterExternalReferenceConcurrently(Isolate* isolate,
+                                                       int task_id) const;
+
   /**
    * Marks the reference to this object independent. Garbage collector is free
    * to ignore any object groups containing this object. Weak callback for an
@@ -4003,6 +4011,10 @@ class V8_EXPORT ArrayBuffer : public Object {
     /**
      * Free the memory block of size |length|, pointed to by |data|.
      * That memory is guaranteed to be previously allocated by |Allocate|.
+     *
+     * With --concurrent-array-buffer-freeing, V8 calls this method on a
+     * background thread, concurrently to calls on the isolate's thread. The
+     * allocator must be thread-safe in that case.
      */
     virtual void Free(void* data, size_t length) = 0;
 
@@ -5737,6 +5749,26 @@ class V8_EXPORT ResourceConstraints {
   void set_max_zone_pool_size(const size_t bytes) {
     max_zone_pool_size_ = bytes;
   }
+  double gc_overhead_target() const { return gc_overhead_target_; }
+  /**
+   * Sets the fraction of time (e.g. 0.05 for 5%) that the old generation
+   * garbage collector should take. The heap limit is then derived from the
+   * measured garbage collection and allocation throughputs to meet this
+   * target instead of using the default heuristics. Zero selects the default
+   * heuristics.
+   */
+  void set_gc_overhead_target(double fraction) {
+    gc_overhead_target_ = fraction;
+  }
+  size_t heap_growing_cap() const { return heap_growing_cap_; }
+  /**
+   * Sets a soft cap for growing the old generation. The heap does not grow
+   * its limit beyond the cap but collects garbage more often instead, even if
+   * this exceeds the GC overhead target. Zero means no cap.
+   */
+  void set_heap_growing_cap(size_t limit_in_mb) {
+    heap_growing_cap_ = limit_in_mb;
+  }
 
  private:
   int max_semi_space_size_;
@@ -5745,6 +5777,8 @@ class V8_EXPORT ResourceConstraints {
   uint32_t* stack_limit_;
   size_t code_range_size_;
   size_t max_zone_pool_size_;
+  double gc_overhead_target_;
+  size_t heap_growing_cap_;
 };
 
 
@@ -6091,6 +6125,16 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * Aggregated statistics of a runtime function, builtin, API function or other
+ * instrumented V8 scope, see Isolate::GetRuntimeCallStatistics.
+ */
+struct RuntimeCallStatisticsEntry {
+  const char* name;
+  int64_t count;
+  int64_t time_in_us;
+};
+
 class RetainedObjectInfo;
 
 
@@ -6242,6 +6286,14 @@ class V8_EXPORT PersistentHandleVisitor {  // NOLINT
  */
 enum class MemoryPressureLevel { kNone, kModerate, kCritical };
 
+/**
+ * Pretenuring decision of an allocation site. kAutomatic lets V8 decide
+ * based on the survival rate of the objects allocated at the site. kTenured
+ * and kNotTenured pin the decision to allocating in the old or young
+ * generation, respectively.
+ */
+enum class PretenuringMode { kAutomatic, kTenured, kNotTenured };
+
 /**
  * Interface for tracing through the embedder heap. During a v8 garbage
  * collection, v8 collects hidden fields of all potential wrappers, and at the
@@ -6317,6 +6369,31 @@ class V8_EXPORT EmbedderHeapTracer {
    */
   virtual size_t NumberOfWrappersToTrace() { return 0; }
 
+  /**
+   * Returns the number of tasks that may trace the embedder heap in parallel
+   * through |AdvanceTracingInParallel|. Returning 0 (the default) means that
+   * tracing only happens on the main thread through |AdvanceTracing|.
+   */
+  virtual int NumberOfParallelTracingTasks() { return 0; }
+
+  /**
+   * Called to make a tracing step for the task with the given id, possibly on
+   * a worker thread. Task ids are in the range [0, n), where n is at most
+   * |NumberOfParallelTracingTasks|, and task 0 runs on the main thread. Steps
+   * of different tasks run concurrently, so the embedder is expected to share
+   * its marking work in a thread-safe way.
+   *
+   * Reachable wrappers must be reported through
+   * |PersistentBase::RegisterExternalReferenceConcurrently| with the same task
+   * id. Heap objects must not be accessed or allocated.
+   *
+   * Returns true if there is still work to do.
+   */
+  virtual bool AdvanceTracingInParallel(int task_id, double deadline_in_ms,
+                                        AdvanceTracingActions actions) {
+    return false;
+  }
+
  protected:
   virtual ~EmbedderHeapTracer() = default;
 };
@@ -6735,6 +6812,17 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Appends the runtime call statistics aggregated since the last reset to
+   * |entries|, skipping entries without any calls or time, and resets them
+   * if |reset| is true. Statistics are only collected with
+   * --runtime-call-stats, which times every instrumented scope, or with
+   * --runtime-call-stats-sampling, which only attributes CPU profiler ticks
+   * to the innermost scope and is cheap enough for production use.
+   */
+  void GetRuntimeCallStatistics(
+      std::vector<RuntimeCallStatisticsEntry>* entries, bool reset);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -7142,6 +7230,17 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Pins the pretenuring decision of the allocation sites of |function|,
+   * i.e., of the object and array literals and Array constructor calls in
+   * its body, including nested literals. Only sites that have been created
+   * by executing the function are affected. Pinned decisions are not changed
+   * by V8's heuristics until the mode is reset to kAutomatic.
+   *
+   * Returns the number of allocation sites that were updated.
+   */
+  int SetPretenuringMode(Local<Function> function, PretenuringMode mode);
+
   /**
    * Optional notification to tell V8 the current isolate is used for debugging
    * and requires higher heap limit.
@@ -7716,6 +7815,8 @@ class V8_EXPORT V8 {
 
   static void RegisterExternallyReferencedObject(internal::Object** object,
                                                  internal::Isolate* isolate);
+  static void RegisterExternallyReferencedObjectConcurrently(
+      internal::Object** object, internal::Isolate* isolate, int task_id);
 
   template <class K, class V, class T>
   friend class PersistentValueMapBase;
@@ -8815,6 +8916,15 @@ void PersistentBase<T>::RegisterExternalReference(Isolate* isolate) const {
       reinterpret_cast<internal::Isolate*>(isolate));
 }
 
+template <class T>
+void PersistentBase<T>::RegisterExternalReferenceConcurrently(
+    Isolate* isolate, int task_id) const {
+  if (IsEmpty()) return;
+  V8::RegisterExternallyReferencedObjectConcurrently(
+      reinterpret_cast<internal::Object**>(this->val_),
+      reinterpret_cast<internal::Isolate*>(isolate), task_id);
+}
+
 template <class T>
 void PersistentBase<T>::MarkIndependent() {
   typedef internal::Internals I;
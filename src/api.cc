@@ -803,7 +803,9 @@ ResourceConstraints::ResourceConstraints()
       max_executable_size_(0),
       stack_limit_(NULL),
       code_range_size_(0),
-      max_zone_pool_size_(0) {}
+      max_zone_pool_size_(0),
+      gc_overhead_target_(0),
+      heap_growing_cap_(0) {}
 
 void ResourceConstraints::ConfigureDefaults(uint64_t physical_memory,
                                             uint64_t virtual_memory_limit) {
@@ -867,6 +869,11 @@ void SetResourceConstraints(i::Isolate* isolate,
                                    max_executable_size, code_range_size);
   }
   isolate->allocator()->ConfigureSegmentPool(max_pool_size);
+  if (constraints.gc_overhead_target() != 0 ||
+      constraints.heap_growing_cap() != 0) {
+    isolate->heap()->ConfigureHeapGrowing(constraints.gc_overhead_target(),
+                                          constraints.heap_growing_cap());
+  }
 
   if (constraints.stack_limit() != NULL) {
     uintptr_t limit = reinterpret_cast<uintptr_t>(constraints.stack_limit());
@@ -902,6 +909,15 @@ void V8::RegisterExternallyReferencedObject(i::Object** object,
   isolate->heap()->RegisterExternallyReferencedObject(object);
 }
 
+void V8::RegisterExternallyReferencedObjectConcurrently(i::Object** object,
+                                                        i::Isolate* isolate,
+                                                        int task_id) {
+  isolate->heap()
+      ->local_embedder_heap_tracer()
+      ->RegisterExternallyReferencedObjectConcurrently(
+          task_id, i::HeapObject::cast(*object));
+}
+
 void V8::MakeWeak(i::Object** location, void* parameter,
                   int internal_field_index1, int internal_field_index2,
                   WeakCallbackInfo<void>::Callback weak_callback) {
@@ -8398,6 +8414,23 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+void Isolate::GetRuntimeCallStatistics(
+    std::vector<RuntimeCallStatisticsEntry>* entries, bool reset) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::RuntimeCallStats* stats = isolate->counters()->runtime_call_stats();
+  stats->CommitActiveTimers();
+  for (int index = 0; index < i::RuntimeCallStats::counters_count; ++index) {
+    i::RuntimeCallCounter* counter =
+        &(stats->*(i::RuntimeCallStats::counters[index]));
+    if (counter->count() == 0 && counter->time() == base::TimeDelta()) {
+      continue;
+    }
+    entries->push_back({counter->name(), counter->count(),
+                        counter->time().InMicroseconds()});
+  }
+  if (reset) stats->ResetCounters();
+}
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   RegisterState regs = state;
@@ -8627,6 +8660,28 @@ void Isolate::MemoryPressureNotification(MemoryPressureLevel level) {
                                                              on_isolate_thread);
 }
 
+int Isolate::SetPretenuringMode(Local<Function> function,
+                                PretenuringMode mode) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  ENTER_V8(isolate);
+  i::Handle<i::JSReceiver> receiver = Utils::OpenHandle(*function);
+  if (!receiver->IsJSFunction()) return 0;
+  i::AllocationSite::PinnedMode pinned_mode;
+  switch (mode) {
+    case PretenuringMode::kTenured:
+      pinned_mode = i::AllocationSite::kPinnedTenured;
+      break;
+    case PretenuringMode::kNotTenured:
+      pinned_mode = i::AllocationSite::kPinnedNotTenured;
+      break;
+    default:
+      pinned_mode = i::AllocationSite::kNotPinned;
+      break;
+  }
+  return isolate->heap()->SetPretenuringMode(
+      i::Handle<i::JSFunction>::cast(receiver), pinned_mode);
+}
+
 void Isolate::SetRAILMode(RAILMode rail_mode) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   return isolate->SetRAILMode(rail_mode);
@@ -9736,6 +9791,10 @@ int64_t CpuProfile::GetEndTime() const {
   return (profile->end_time() - base::TimeTicks()).InMicroseconds();
 }
 
+bool CpuProfile::WritePprof(OutputStream* stream) const {
+  return reinterpret_cast<const i::CpuProfile*>(this)->WritePprof(stream);
+}
+
 
 int CpuProfile::GetSamplesCount() const {
   return reinterpret_cast<const i::CpuProfile*>(this)->samples_count();
@@ -9758,6 +9817,10 @@ void CpuProfiler::CollectSample() {
   reinterpret_cast<i::CpuProfiler*>(this)->CollectSample();
 }
 
+unsigned CpuProfiler::GetDroppedSamplesCount() const {
+  return reinterpret_cast<const i::CpuProfiler*>(this)->dropped_samples();
+}
+
 void CpuProfiler::StartProfiling(Local<String> title, bool record_samples) {
   reinterpret_cast<i::CpuProfiler*>(this)->StartProfiling(
       *Utils::OpenHandle(*title), record_samples);
@@ -9968,6 +10031,14 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
 }
 
 
+bool HeapProfiler::TakeStreamingHeapSnapshot(OutputStream* stream,
+                                             ActivityControl* control,
+                                             ObjectNameResolver* resolver) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->TakeStreamingSnapshot(
+      stream, control, resolver);
+}
+
+
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
       track_allocations);
@@ -10003,6 +10074,12 @@ AllocationProfile* HeapProfiler::GetAllocationProfile() {
 }
 
 
+bool HeapProfiler::WriteAllocationProfileDelta(OutputStream* stream) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->WriteAllocationProfileDelta(
+      stream);
+}
+
+
 void HeapProfiler::DeleteAllHeapSnapshots() {
   reinterpret_cast<i::HeapProfiler*>(this)->DeleteAllSnapshots();
 }
@@ -14,6 +14,7 @@
 #endif
 #include <sched.h>  // for sched_yield
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -153,6 +154,121 @@ void OS::Unprotect(void* address, const size_t size) {
 #endif
 }
 
+size_t OS::HugePageSize() {
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  return 2 * 1024 * 1024;
+#else
+  return 0;
+#endif
+}
+
+bool OS::AdviseHugePages(void* address, const size_t size) {
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+size_t OS::HugePageBackedBytes(void* start, void* end) {
+#if V8_OS_LINUX
+  FILE* fp = fopen("/proc/self/smaps", "r");
+  if (fp == nullptr) return 0;
+  const uintptr_t range_start = reinterpret_cast<uintptr_t>(start);
+  const uintptr_t range_end = reinterpret_cast<uintptr_t>(end);
+  bool in_range = false;
+  size_t result = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != nullptr) {
+    uintptr_t mapping_start, mapping_end;
+    size_t kb;
+    if (sscanf(line, "%" V8PRIxPTR "-%" V8PRIxPTR, &mapping_start,
+               &mapping_end) == 2) {
+      in_range = mapping_start >= range_start && mapping_end <= range_end;
+    } else if (in_range && sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+      result += kb * 1024;
+    }
+  }
+  fclose(fp);
+  return result;
+#else
+  return 0;
+#endif
+}
+
+#if V8_OS_LINUX
+// Reads a single unsigned value from the given file. Fails for non-numeric
+// contents such as "max", which cgroup v2 uses for "no limit".
+static bool ReadUint64FromFile(const char* path, uint64_t* value) {
+  FILE* fp = fopen(path, "r");
+  if (fp == nullptr) return false;
+  unsigned long long result;  // NOLINT(runtime/int)
+  bool success = fscanf(fp, "%llu", &result) == 1;
+  fclose(fp);
+  if (success) *value = static_cast<uint64_t>(result);
+  return success;
+}
+#endif
+
+bool OS::GetCgroupMemoryInfo(uint64_t* usage, uint64_t* limit) {
+#if V8_OS_LINUX
+  // cgroup v1 reports a page-rounded LLONG_MAX if no limit is set.
+  const uint64_t kNoLimit = static_cast<uint64_t>(1) << 62;
+  char cgroup[256] = "";
+  FILE* fp = fopen("/proc/self/cgroup", "r");
+  if (fp != nullptr) {
+    char line[320];
+    while (fgets(line, sizeof(line), fp) != nullptr) {
+      // The unified hierarchy of cgroup v2 has the entry "0::<path>".
+      if (sscanf(line, "0::%255s", cgroup) == 1) break;
+      cgroup[0] = '\0';
+    }
+    fclose(fp);
+  }
+  char usage_path[320];
+  char limit_path[320];
+  if (cgroup[0] != '\0') {
+    if (strcmp(cgroup, "/") == 0) cgroup[0] = '\0';
+    snprintf(usage_path, sizeof(usage_path),
+             "/sys/fs/cgroup%s/memory.current", cgroup);
+    snprintf(limit_path, sizeof(limit_path), "/sys/fs/cgroup%s/memory.max",
+             cgroup);
+    if (ReadUint64FromFile(usage_path, usage) &&
+        ReadUint64FromFile(limit_path, limit)) {
+      return *limit > 0;
+    }
+  }
+  if (ReadUint64FromFile("/sys/fs/cgroup/memory/memory.usage_in_bytes",
+                         usage) &&
+      ReadUint64FromFile("/sys/fs/cgroup/memory/memory.limit_in_bytes",
+                         limit)) {
+    return *limit > 0 && *limit < kNoLimit;
+  }
+  return false;
+#else
+  return false;
+#endif
+}
+
+bool OS::GetMemoryPressureStall(double* some_avg10, double* full_avg10) {
+#if V8_OS_LINUX
+  FILE* fp = fopen("/proc/pressure/memory", "r");
+  if (fp == nullptr) return false;
+  bool has_some = false;
+  bool has_full = false;
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != nullptr) {
+    if (sscanf(line, "some avg10=%lf", some_avg10) == 1) has_some = true;
+    if (sscanf(line, "full avg10=%lf", full_avg10) == 1) has_full = true;
+  }
+  fclose(fp);
+  if (has_some && !has_full) *full_avg10 = 0;
+  return has_some;
+#else
+  return false;
+#endif
+}
+
 static LazyInstance<RandomNumberGenerator>::type
     platform_random_number_generator = LAZY_INSTANCE_INITIALIZER;
 
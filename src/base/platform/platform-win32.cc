@@ -829,6 +829,20 @@ void OS::Unprotect(void* address, const size_t size) {
   DCHECK_IMPLIES(result != nullptr, GetLastError() == 0);
 }
 
+size_t OS::HugePageSize() { return 0; }
+
+bool OS::AdviseHugePages(void* address, const size_t size) { return false; }
+
+size_t OS::HugePageBackedBytes(void* start, void* end) { return 0; }
+
+bool OS::GetCgroupMemoryInfo(uint64_t* usage, uint64_t* limit) {
+  return false;
+}
+
+bool OS::GetMemoryPressureStall(double* some_avg10, double* full_avg10) {
+  return false;
+}
+
 void OS::Sleep(TimeDelta interval) {
   ::Sleep(static_cast<DWORD>(interval.InMilliseconds()));
 }
@@ -196,6 +196,29 @@ class V8_BASE_EXPORT OS {
   // Make a region of memory readable and writable.
   static void Unprotect(void* address, const size_t size);
 
+  // Returns the size of a transparent huge page or 0 if the platform does not
+  // support them.
+  static size_t HugePageSize();
+
+  // Advises the OS to back the committed region [address, address + size)
+  // with transparent huge pages. The advice is dropped when the region is
+  // remapped, i.e., it has to be repeated after committing the region again.
+  // Returns false if the advice is not supported.
+  static bool AdviseHugePages(void* address, const size_t size);
+
+  // Returns the number of bytes in mappings within [start, end) that are
+  // currently backed by transparent huge pages, or 0 if unknown.
+  static size_t HugePageBackedBytes(void* start, void* end);
+
+  // Reads the memory usage and limit of the cgroup (v2 or v1) of the current
+  // process. Returns false if the usage is unknown or no limit is set.
+  static bool GetCgroupMemoryInfo(uint64_t* usage, uint64_t* limit);
+
+  // Reads the 10s averages of the "some" and "full" memory stall percentages
+  // from the pressure stall information (PSI) of the kernel. Returns false if
+  // PSI is not available.
+  static bool GetMemoryPressureStall(double* some_avg10, double* full_avg10);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
@@ -17,6 +17,8 @@ void RuntimeCallTimer::Start(RuntimeCallCounter* counter,
   parent_.SetValue(parent);
   if (FLAG_runtime_stats ==
       v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLING) {
+    // Time is attributed by profiler ticks, only count the call.
+    counter->Increment();
     return;
   }
   base::TimeTicks now = Now();
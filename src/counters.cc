@@ -276,12 +276,13 @@ class RuntimeCallStatEntries {
 void RuntimeCallCounter::Reset() {
   count_ = 0;
   time_ = base::TimeDelta();
+  sampled_time_in_us_.SetValue(0);
 }
 
 void RuntimeCallCounter::Dump(v8::tracing::TracedValue* value) {
   value->BeginArray(name_);
   value->AppendDouble(count_);
-  value->AppendDouble(time_.InMicroseconds());
+  value->AppendDouble(time().InMicroseconds());
   value->EndArray();
 }
 
@@ -402,6 +403,27 @@ void RuntimeCallStats::Reset() {
   in_use_ = true;
 }
 
+void RuntimeCallStats::ResetCounters() {
+  for (const RuntimeCallStats::CounterId counter_id :
+       RuntimeCallStats::counters) {
+    RuntimeCallCounter* counter = &(this->*counter_id);
+    counter->Reset();
+  }
+}
+
+void RuntimeCallStats::CommitActiveTimers() {
+  RuntimeCallTimer* timer = current_timer_.Value();
+  // Timers are not started in sampling mode.
+  if (timer != nullptr && timer->IsStarted()) timer->Snapshot();
+}
+
+void RuntimeCallStats::AttributeSample(base::TimeDelta interval) {
+  RuntimeCallTimer* timer = current_timer_.Value();
+  if (timer == nullptr) return;
+  RuntimeCallCounter* counter = timer->counter();
+  if (counter != nullptr) counter->AddSample(interval);
+}
+
 void RuntimeCallStats::Dump(v8::tracing::TracedValue* value) {
   for (const RuntimeCallStats::CounterId counter_id :
        RuntimeCallStats::counters) {
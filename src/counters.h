@@ -493,14 +493,25 @@ class RuntimeCallCounter final {
 
   const char* name() const { return name_; }
   int64_t count() const { return count_; }
-  base::TimeDelta time() const { return time_; }
+  base::TimeDelta time() const {
+    return time_ +
+           base::TimeDelta::FromMicroseconds(sampled_time_in_us_.Value());
+  }
   void Increment() { count_++; }
   void Add(base::TimeDelta delta) { time_ += delta; }
+  // Unlike Add, this can be called by the sampler while the thread owning
+  // the counter is interrupted or suspended.
+  void AddSample(base::TimeDelta interval) {
+    sampled_time_in_us_.Increment(
+        static_cast<intptr_t>(interval.InMicroseconds()));
+  }
 
  private:
   const char* name_;
   int64_t count_ = 0;
   base::TimeDelta time_;
+  // Time attributed by profiler ticks.
+  base::AtomicNumber<intptr_t> sampled_time_in_us_;
 };
 
 // RuntimeCallTimer is used to keep track of the stack of currently active
@@ -866,6 +877,18 @@ class RuntimeCallStats final : public ZoneObject {
                                                         CounterId counter_id);
 
   V8_EXPORT_PRIVATE void Reset();
+  // Resets the counters without stopping the active timers, so that it can
+  // be called while instrumented scopes are active.
+  void ResetCounters();
+  // Commits the time elapsed so far in active timers to their counters.
+  void CommitActiveTimers();
+  // Attributes a profiler tick of |interval| to the counter of the innermost
+  // active timer. Used with --runtime-call-stats-sampling, where timers do
+  // not read the clock. Called by the sampler, either from a signal handler
+  // interrupting the isolate's thread or from the sampler thread while the
+  // isolate's thread is suspended, so it only reads the atomic timer stack
+  // pointer and updates the counter atomically.
+  void AttributeSample(base::TimeDelta interval);
   // Add all entries from another stats object.
   void Add(RuntimeCallStats* other);
   V8_EXPORT_PRIVATE void Print(std::ostream& os);
@@ -1084,6 +1107,17 @@ class RuntimeCallTimerScope {
      V8.GCCompactorCausedByOldspaceExhaustion)                                 \
   SC(gc_last_resort_from_js, V8.GCLastResortFromJS)                            \
   SC(gc_last_resort_from_handles, V8.GCLastResortFromHandles)                  \
+  /* Memory reclaimed by code flushing. */                                     \
+  SC(code_flushing_flushed_functions, V8.CodeFlushingFlushedFunctions)         \
+  SC(code_flushing_flushed_code_bytes, V8.CodeFlushingFlushedCodeBytes)        \
+  SC(code_flushing_flushed_bytecode_bytes,                                     \
+     V8.CodeFlushingFlushedBytecodeBytes)                                      \
+  SC(code_flushing_flushed_feedback_vector_bytes,                              \
+     V8.CodeFlushingFlushedFeedbackVectorBytes)                                \
+  SC(gc_idle_time_prediction_misses, V8.GCIdleTimePredictionMisses)            \
+  SC(sampling_heap_profiler_truncated_samples,                                 \
+     V8.SamplingHeapProfilerTruncatedSamples)                                  \
+  SC(cpu_profiler_dropped_samples, V8.CpuProfilerDroppedSamples)               \
   SC(ic_keyed_load_generic_smi, V8.ICKeyedLoadGenericSmi)                      \
   SC(ic_keyed_load_generic_symbol, V8.ICKeyedLoadGenericSymbol)                \
   SC(ic_keyed_load_generic_slow, V8.ICKeyedLoadGenericSlow)                    \
@@ -1581,6 +1581,8 @@ Handle<JSFunction> Factory::NewFunctionFromSharedFunctionInfo(
     Compiler::PostInstantiation(result, pretenure);
   }
 
+  isolate()->heap()->mark_compact_collector()->RecordBlackAllocatedClosure(
+      *result);
   return result;
 }
 
@@ -1611,6 +1613,8 @@ Handle<JSFunction> Factory::NewFunctionFromSharedFunctionInfo(
     Compiler::PostInstantiation(result, pretenure);
   }
 
+  isolate()->heap()->mark_compact_collector()->RecordBlackAllocatedClosure(
+      *result);
   return result;
 }
 
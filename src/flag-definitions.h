@@ -620,6 +620,9 @@ DEFINE_BOOL(trace_idle_notification, false,
             "print one trace line following each idle notification")
 DEFINE_BOOL(trace_idle_notification_verbose, false,
             "prints the heap state used by the idle notification")
+DEFINE_BOOL(predictive_idle_time_scheduling, false,
+            "pick idle time GC actions based on recorded GC speeds and the "
+            "allocation rate")
 DEFINE_BOOL(trace_gc_verbose, false,
             "print more details following each garbage collection")
 DEFINE_INT(trace_allocation_stack_interval, -1,
@@ -635,9 +638,17 @@ DEFINE_BOOL(trace_code_flushing, false, "trace code flushing progress")
 DEFINE_BOOL(age_code, true,
             "track un-executed functions to age code and flush only "
             "old code (required for code flushing)")
+DEFINE_BOOL(flush_bytecode, false,
+            "flush bytecode and feedback of functions that were not executed "
+            "for --bytecode_flush_age mark-compacts")
+DEFINE_INT(bytecode_flush_age, 3,
+           "number of mark-compacts without execution after which bytecode "
+           "is flushed (1-5)")
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
 DEFINE_BOOL(incremental_marking_wrappers, true,
             "use incremental marking for marking wrappers")
+DEFINE_BOOL(parallel_embedder_tracing, true,
+            "trace wrappers on worker threads if the embedder supports it")
 DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
            "keep finalizing incremental marking as long as we discover at "
            "least this many unmarked objects")
@@ -645,11 +656,23 @@ DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(minor_mc, false, "perform young generation mark compact GCs")
 DEFINE_NEG_IMPLICATION(minor_mc, incremental_marking)
+DEFINE_BOOL(minor_mc_parallel_marking, true,
+            "use parallel marking for the young generation")
 DEFINE_BOOL(black_allocation, true, "use black allocation")
+DEFINE_BOOL(early_code_and_map_black_allocation, false,
+            "allocate black in code and map space from the start of "
+            "incremental marking")
+DEFINE_BOOL(concurrent_marking, false, "use concurrent marking")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_BOOL(huge_pages, false,
+            "reserve heap pages in huge page aligned regions and advise them "
+            "and the code range for transparent huge pages (Linux only)")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
+DEFINE_BOOL(parallel_scavenge, false, "use parallel scavenge")
+DEFINE_BOOL(parallel_global_handles, true,
+            "identify and update weak global handles in parallel")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
@@ -671,8 +694,28 @@ DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
 #endif
 DEFINE_BOOL(move_object_start, true, "enable moving of object starts")
 DEFINE_BOOL(memory_reducer, true, "use memory reducer")
+DEFINE_BOOL(memory_pressure_from_system, false,
+            "derive memory pressure from cgroup memory limits and pressure "
+            "stall information on Linux")
+DEFINE_INT(memory_pressure_sample_interval, 500,
+           "minimum time (in ms) between two samples of the system memory "
+           "pressure")
+DEFINE_BOOL(concurrent_array_buffer_freeing, false,
+            "free backing stores of dead array buffers on a background thread "
+            "(requires a thread-safe ArrayBuffer::Allocator::Free)")
+DEFINE_INT(array_buffer_freeing_budget, 64,
+           "maximum size (in MB) of dead array buffer backing stores that are "
+           "waiting to be freed before allocation helps freeing them")
+DEFINE_INT(page_pool_size, 8,
+           "maximum size (in MB) of freed pages that are kept committed for "
+           "reuse while the memory reducer is inactive")
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
+DEFINE_INT(gc_overhead_target_percent, 0,
+           "derive the heap growing factor from the measured GC and mutator "
+           "throughputs such that GC takes the given percentage of time")
+DEFINE_INT(heap_growing_cap, 0,
+           "soft cap (in MB) for growing the old generation allocation limit")
 DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
 DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
@@ -696,6 +739,9 @@ DEFINE_BOOL(manual_evacuation_candidates_selection, false,
             "candidates pages (requires --stress_compaction).")
 DEFINE_BOOL(fast_promotion_new_space, false,
             "fast promote new space on high survival rates")
+DEFINE_BOOL(young_large_objects, false,
+            "allocate large objects in the young generation and promote "
+            "them in place when they survive a scavenge")
 
 // assembler-ia32.cc / assembler-arm.cc / assembler-x64.cc
 DEFINE_BOOL(debug_code, DEBUG_BOOL,
@@ -871,6 +917,9 @@ DEFINE_BOOL(heap_profiler_trace_objects, false,
 // sampling-heap-profiler.cc
 DEFINE_BOOL(sampling_heap_profiler_suppress_randomness, false,
             "Use constant sample intervals to eliminate test flakiness")
+DEFINE_INT(sampling_heap_profiler_max_nodes, 4096,
+           "maximum number of stack nodes kept between two delta profiles "
+           "of the sampling heap profiler")
 
 
 // v8.cc
@@ -891,6 +940,12 @@ DEFINE_BOOL(native_code_counters, false,
 
 // objects.cc
 DEFINE_BOOL(thin_strings, false, "Enable ThinString support")
+DEFINE_BOOL(string_deduplication, false,
+            "turn duplicate sequential strings into ThinStrings after "
+            "mark-compact")
+DEFINE_IMPLICATION(string_deduplication, thin_strings)
+DEFINE_INT(string_deduplication_min_length, 16,
+           "minimum length of strings considered for deduplication")
 DEFINE_BOOL(trace_weak_arrays, false, "Trace WeakFixedArray usage")
 DEFINE_BOOL(trace_prototype_users, false,
             "Trace updates to prototype user tracking")
@@ -966,6 +1021,12 @@ DEFINE_BOOL(runtime_call_stats, false, "report runtime call counts and times")
 DEFINE_INT(runtime_stats, 0,
            "internal usage only for controlling runtime statistics")
 DEFINE_VALUE_IMPLICATION(runtime_call_stats, runtime_stats, 1)
+DEFINE_BOOL(runtime_call_stats_sampling, false,
+            "collect runtime call counts and attribute CPU profiler ticks to "
+            "them instead of timing every call")
+DEFINE_VALUE_IMPLICATION(
+    runtime_call_stats_sampling, runtime_stats,
+    v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLING)
 
 // snapshot-common.cc
 DEFINE_BOOL(profile_deserialization, false,
@@ -1126,6 +1187,11 @@ DEFINE_BOOL(prof_browser_mode, true,
             "Used with --prof, turns on browser-compatible mode for profiling.")
 DEFINE_STRING(logfile, "v8.log", "Specify the name of the log file.")
 DEFINE_BOOL(logfile_per_isolate, true, "Separate log files for each isolate.")
+DEFINE_BOOL(log_async, false,
+            "Write the log file in batches on a background thread.")
+DEFINE_INT(log_async_flush_interval, 100,
+           "Interval in ms after which pending --log-async output is written "
+           "(at least 1).")
 DEFINE_BOOL(ll_prof, false, "Enable low-level linux profiler.")
 DEFINE_BOOL(perf_basic_prof, false,
             "Enable perf linux profiler (basic support).")
@@ -1244,9 +1310,15 @@ DEFINE_VALUE_IMPLICATION(single_threaded, wasm_num_compilation_tasks, 0)
 //
 
 DEFINE_BOOL(single_threaded, false, "disable the use of background tasks")
+DEFINE_NEG_IMPLICATION(single_threaded, concurrent_array_buffer_freeing)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_recompilation)
+DEFINE_NEG_IMPLICATION(single_threaded, concurrent_marking)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_sweeping)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_global_handles)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_embedder_tracing)
+DEFINE_NEG_IMPLICATION(single_threaded, minor_mc_parallel_marking)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compaction)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_scavenge)
 
 
 #undef FLAG
@@ -14,6 +14,7 @@
 #include "src/base/platform/platform.h"
 #include "src/list-inl.h"
 #include "src/ostreams.h"
+#include "src/tracing/tracing-category-observer.h"
 #include "src/utils.h"
 #include "src/wasm/wasm-limits.h"
 
@@ -4,7 +4,11 @@
 
 #include "src/global-handles.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "src/api.h"
+#include "src/base/platform/semaphore.h"
 #include "src/cancelable-task.h"
 #include "src/objects-inl.h"
 #include "src/v8.h"
@@ -511,6 +515,84 @@ class GlobalHandles::NodeIterator {
   DISALLOW_COPY_AND_ASSIGN(NodeIterator);
 };
 
+namespace {
+
+// Processes one range of GlobalHandles::ProcessInParallel.
+template <typename Callback>
+class ProcessNodeRangeTask : public CancelableTask {
+ public:
+  ProcessNodeRangeTask(Isolate* isolate, Callback* process, int start,
+                       int end, base::Semaphore* on_finish)
+      : CancelableTask(isolate),
+        process_(process),
+        start_(start),
+        end_(end),
+        on_finish_(on_finish) {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    (*process_)(start_, end_);
+    on_finish_->Signal();
+  }
+
+  Callback* process_;
+  int start_;
+  int end_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessNodeRangeTask);
+};
+
+// Nodes of new space handles are processed in ranges of at least this size.
+const int kMinNewSpaceNodesPerTask = 4 * KB;
+
+}  // namespace
+
+template <typename Callback>
+void GlobalHandles::ProcessInParallel(int length, int min_length_per_task,
+                                      Callback process) {
+  const int kMaxTasks = 8;
+  if (length == 0) return;
+  int num_tasks = 1;
+  if (FLAG_parallel_global_handles) {
+    num_tasks = Min(
+        kMaxTasks,
+        Min(static_cast<int>(V8::GetCurrentPlatform()
+                                 ->NumberOfAvailableBackgroundThreads()) +
+                1,
+            length / min_length_per_task));
+  }
+  if (num_tasks <= 1) {
+    process(0, length);
+    return;
+  }
+  base::Semaphore pending_tasks(0);
+  uint32_t task_ids[kMaxTasks];
+  const int length_per_task = (length + num_tasks - 1) / num_tasks;
+  for (int i = 1; i < num_tasks; i++) {
+    const int start = Min(length, i * length_per_task);
+    const int end = Min(length, start + length_per_task);
+    ProcessNodeRangeTask<Callback>* task = new ProcessNodeRangeTask<Callback>(
+        isolate_, &process, start, end, &pending_tasks);
+    task_ids[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+  // Contribute on the main thread.
+  process(0, Min(length, length_per_task));
+  for (int i = 1; i < num_tasks; i++) {
+    if (isolate_->cancelable_task_manager()->TryAbort(task_ids[i]) ==
+        CancelableTaskManager::kTaskAborted) {
+      // The task did not start, so its range is processed here.
+      const int start = Min(length, i * length_per_task);
+      process(start, Min(length, start + length_per_task));
+    } else {
+      pending_tasks.Wait();
+    }
+  }
+}
+
 class GlobalHandles::PendingPhantomCallbacksSecondPassTask
     : public v8::internal::CancelableTask {
  public:
@@ -645,11 +727,24 @@ void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
 
 
 void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeak() && f(it.node()->location())) {
-      it.node()->MarkPending();
-    }
-  }
+  std::vector<NodeBlock*> blocks;
+  for (NodeBlock* block = first_used_block_; block != nullptr;
+       block = block->next_used()) {
+    blocks.push_back(block);
+  }
+  ProcessInParallel(
+      static_cast<int>(blocks.size()),
+      kMinNewSpaceNodesPerTask / NodeBlock::kSize,
+      [&blocks, f](int start, int end) {
+        for (int i = start; i < end; i++) {
+          for (int j = 0; j < NodeBlock::kSize; j++) {
+            Node* node = blocks[i]->node_at(j);
+            if (node->IsWeak() && f(node->location())) {
+              node->MarkPending();
+            }
+          }
+        }
+      });
 }
 
 
@@ -667,14 +762,19 @@ void GlobalHandles::IterateNewSpaceStrongAndDependentRoots(ObjectVisitor* v) {
 
 void GlobalHandles::IdentifyNewSpaceWeakIndependentHandles(
     WeakSlotCallbackWithHeap f) {
-  for (int i = 0; i < new_space_nodes_.length(); ++i) {
-    Node* node = new_space_nodes_[i];
-    DCHECK(node->is_in_new_space_list());
-    if (node->is_independent() && node->IsWeak() &&
-        f(isolate_->heap(), node->location())) {
-      node->MarkPending();
-    }
-  }
+  Heap* heap = isolate_->heap();
+  ProcessInParallel(
+      new_space_nodes_.length(), kMinNewSpaceNodesPerTask,
+      [this, heap, f](int start, int end) {
+        for (int i = start; i < end; ++i) {
+          Node* node = new_space_nodes_[i];
+          DCHECK(node->is_in_new_space_list());
+          if (node->is_independent() && node->IsWeak() &&
+              f(heap, node->location())) {
+            node->MarkPending();
+          }
+        }
+      });
 }
 
 
@@ -700,25 +800,34 @@ void GlobalHandles::IterateNewSpaceWeakIndependentRoots(ObjectVisitor* v) {
 
 void GlobalHandles::IdentifyWeakUnmodifiedObjects(
     WeakSlotCallback is_unmodified) {
-  for (int i = 0; i < new_space_nodes_.length(); ++i) {
-    Node* node = new_space_nodes_[i];
-    if (node->IsWeak() && !is_unmodified(node->location())) {
-      node->set_active(true);
-    }
-  }
+  ProcessInParallel(new_space_nodes_.length(), kMinNewSpaceNodesPerTask,
+                    [this, is_unmodified](int start, int end) {
+                      for (int i = start; i < end; ++i) {
+                        Node* node = new_space_nodes_[i];
+                        if (node->IsWeak() &&
+                            !is_unmodified(node->location())) {
+                          node->set_active(true);
+                        }
+                      }
+                    });
 }
 
 
 void GlobalHandles::MarkNewSpaceWeakUnmodifiedObjectsPending(
     WeakSlotCallbackWithHeap is_unscavenged) {
-  for (int i = 0; i < new_space_nodes_.length(); ++i) {
-    Node* node = new_space_nodes_[i];
-    DCHECK(node->is_in_new_space_list());
-    if ((node->is_independent() || !node->is_active()) && node->IsWeak() &&
-        is_unscavenged(isolate_->heap(), node->location())) {
-      node->MarkPending();
-    }
-  }
+  Heap* heap = isolate_->heap();
+  ProcessInParallel(
+      new_space_nodes_.length(), kMinNewSpaceNodesPerTask,
+      [this, heap, is_unscavenged](int start, int end) {
+        for (int i = start; i < end; ++i) {
+          Node* node = new_space_nodes_[i];
+          DCHECK(node->is_in_new_space_list());
+          if ((node->is_independent() || !node->is_active()) &&
+              node->IsWeak() && is_unscavenged(heap, node->location())) {
+            node->MarkPending();
+          }
+        }
+      });
 }
 
 template <GlobalHandles::IterationMode mode>
@@ -986,23 +1095,52 @@ int GlobalHandles::PostMarkSweepProcessing(
 
 
 void GlobalHandles::UpdateListOfNewSpaceNodes() {
+  // Each range is compacted in place. The compacted ranges are concatenated
+  // afterwards, which keeps the order of the nodes.
+  struct CompactedRange {
+    int start;
+    int end;
+    int promoted;
+    int died;
+    bool operator<(const CompactedRange& other) const {
+      return start < other.start;
+    }
+  };
+  Heap* heap = isolate_->heap();
+  base::Mutex mutex;
+  std::vector<CompactedRange> ranges;
+  ProcessInParallel(
+      new_space_nodes_.length(), kMinNewSpaceNodesPerTask,
+      [this, heap, &mutex, &ranges](int start, int end) {
+        CompactedRange range = {start, start, 0, 0};
+        for (int i = start; i < end; ++i) {
+          Node* node = new_space_nodes_[i];
+          DCHECK(node->is_in_new_space_list());
+          if (node->IsRetainer()) {
+            if (heap->InNewSpace(node->object())) {
+              new_space_nodes_[range.end++] = node;
+            } else {
+              node->set_in_new_space_list(false);
+              range.promoted++;
+            }
+          } else {
+            node->set_in_new_space_list(false);
+            range.died++;
+          }
+        }
+        base::LockGuard<base::Mutex> guard(&mutex);
+        ranges.push_back(range);
+      });
+  std::sort(ranges.begin(), ranges.end());
   int last = 0;
-  for (int i = 0; i < new_space_nodes_.length(); ++i) {
-    Node* node = new_space_nodes_[i];
-    DCHECK(node->is_in_new_space_list());
-    if (node->IsRetainer()) {
-      if (isolate_->heap()->InNewSpace(node->object())) {
-        new_space_nodes_[last++] = node;
-        isolate_->heap()->IncrementNodesCopiedInNewSpace();
-      } else {
-        node->set_in_new_space_list(false);
-        isolate_->heap()->IncrementNodesPromoted();
-      }
-    } else {
-      node->set_in_new_space_list(false);
-      isolate_->heap()->IncrementNodesDiedInNewSpace();
+  for (const CompactedRange& range : ranges) {
+    for (int i = range.start; i < range.end; ++i) {
+      new_space_nodes_[last++] = new_space_nodes_[i];
     }
+    heap->IncrementNodesPromoted(range.promoted);
+    heap->IncrementNodesDiedInNewSpace(range.died);
   }
+  heap->IncrementNodesCopiedInNewSpace(last);
   new_space_nodes_.Rewind(last);
   new_space_nodes_.Trim();
 }
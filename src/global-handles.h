@@ -321,6 +321,14 @@ class GlobalHandles {
   int DispatchPendingPhantomCallbacks(bool synchronous_second_pass);
   void UpdateListOfNewSpaceNodes();
 
+  // Splits [0, length) into disjoint ranges and calls |process(start, end)|
+  // for each of them. Ranges are processed on background tasks if there is
+  // enough work (--parallel_global_handles). |process| may only touch the
+  // nodes in its range and must not allocate.
+  template <typename Callback>
+  void ProcessInParallel(int length, int min_length_per_task,
+                         Callback process);
+
   // Internal node structures.
   class Node;
   class NodeBlock;
@@ -0,0 +1,136 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/array-buffer-collector.h"
+
+#include "src/cancelable-task.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/isolate.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class ArrayBufferCollector::FreeingTask : public v8::Task {
+ public:
+  explicit FreeingTask(ArrayBufferCollector* collector)
+      : collector_(collector) {}
+
+ private:
+  // v8::Task overrides.
+  void Run() override {
+    collector_->freeing_task_pending_.SetValue(false);
+    collector_->FreeAllocations();
+    collector_->pending_freeing_tasks_semaphore_.Signal();
+  }
+
+  ArrayBufferCollector* collector_;
+  DISALLOW_COPY_AND_ASSIGN(FreeingTask);
+};
+
+// Frees backing stores on the main thread when concurrent freeing is
+// disabled. Canceled when the isolate is torn down.
+class ArrayBufferCollector::ForegroundFreeingTask : public CancelableTask {
+ public:
+  ForegroundFreeingTask(Isolate* isolate, ArrayBufferCollector* collector)
+      : CancelableTask(isolate), collector_(collector) {}
+
+ private:
+  // CancelableTask overrides.
+  void RunInternal() override {
+    collector_->freeing_task_pending_.SetValue(false);
+    collector_->FreeAllocations();
+  }
+
+  ArrayBufferCollector* collector_;
+  DISALLOW_COPY_AND_ASSIGN(ForegroundFreeingTask);
+};
+
+void ArrayBufferCollector::AddGarbageAllocations(
+    std::vector<Allocation>* allocations) {
+  if (allocations->empty()) return;
+  size_t bytes = 0;
+  for (const Allocation& allocation : *allocations) {
+    bytes += allocation.second;
+  }
+  {
+    base::LockGuard<base::Mutex> guard(&allocations_mutex_);
+    allocations_.push_back(std::move(*allocations));
+  }
+  allocations->clear();
+  pending_bytes_.Increment(bytes);
+  // The sweeper adds garbage after the GC epilogue, so the freeing task
+  // cannot be scheduled only from there.
+  ScheduleFreeingTask();
+}
+
+void ArrayBufferCollector::ScheduleFreeingTask() {
+  // Remaining backing stores are freed by TearDown.
+  if (tearing_down_.Value()) return;
+  if (!freeing_task_pending_.TrySetValue(false, true)) return;
+  if (FLAG_concurrent_array_buffer_freeing) {
+    concurrent_freeing_tasks_active_.Increment(1);
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new FreeingTask(this), v8::Platform::kShortRunningTask);
+  } else {
+    Isolate* isolate = heap_->isolate();
+    V8::GetCurrentPlatform()->CallOnForegroundThread(
+        reinterpret_cast<v8::Isolate*>(isolate),
+        new ForegroundFreeingTask(isolate, this));
+  }
+}
+
+void ArrayBufferCollector::FreeAllocationsAfterGC() {
+  // Reap tasks that finished in the meantime without blocking.
+  while (concurrent_freeing_tasks_active_.Value() > 0 &&
+         pending_freeing_tasks_semaphore_.WaitFor(
+             base::TimeDelta::FromSeconds(0))) {
+    concurrent_freeing_tasks_active_.Decrement(1);
+  }
+  if (pending_bytes_.Value() == 0) return;
+  ScheduleFreeingTask();
+}
+
+void ArrayBufferCollector::FreeAllocations() {
+  v8::ArrayBuffer::Allocator* allocator =
+      heap_->isolate()->array_buffer_allocator();
+  std::vector<Allocation> batch;
+  while (true) {
+    {
+      base::LockGuard<base::Mutex> guard(&allocations_mutex_);
+      if (allocations_.empty()) return;
+      batch = std::move(allocations_.back());
+      allocations_.pop_back();
+    }
+    size_t bytes = 0;
+    for (const Allocation& allocation : batch) {
+      allocator->Free(allocation.first, allocation.second);
+      bytes += allocation.second;
+    }
+    pending_bytes_.Decrement(bytes);
+  }
+}
+
+void ArrayBufferCollector::EnsureWithinBudget() {
+  if (pending_bytes_.Value() <=
+      static_cast<size_t>(FLAG_array_buffer_freeing_budget) * MB) {
+    return;
+  }
+  // Freeing tasks and the main thread take batches from the same list, so
+  // this only frees what the tasks have not picked up yet.
+  FreeAllocations();
+}
+
+void ArrayBufferCollector::TearDown() {
+  while (concurrent_freeing_tasks_active_.Value() > 0) {
+    pending_freeing_tasks_semaphore_.Wait();
+    concurrent_freeing_tasks_active_.Decrement(1);
+  }
+  FreeAllocations();
+  DCHECK_EQ(0u, pending_bytes_.Value());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,91 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_ARRAY_BUFFER_COLLECTOR_H_
+#define V8_HEAP_ARRAY_BUFFER_COLLECTOR_H_
+
+#include <utility>
+#include <vector>
+
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// To support background freeing of backing stores, dead array buffers are
+// not freed during the GC pause. Instead, their backing stores are handed to
+// the collector in batches and freed on a background task
+// (--concurrent_array_buffer_freeing), or on a foreground task otherwise.
+//
+// The amount of pending garbage is bounded by --array_buffer_freeing_budget.
+// When the budget is exceeded, the main thread helps freeing before new
+// backing stores are allocated.
+class ArrayBufferCollector {
+ public:
+  // A backing store and its length as passed to the embedder's allocator.
+  typedef std::pair<void*, size_t> Allocation;
+
+  explicit ArrayBufferCollector(Heap* heap)
+      : heap_(heap),
+        pending_bytes_(0),
+        pending_freeing_tasks_semaphore_(0),
+        concurrent_freeing_tasks_active_(0),
+        freeing_task_pending_(false),
+        tearing_down_(false) {}
+
+  // Adds backing stores that should be freed and schedules a task for
+  // freeing them. Takes ownership of the contents of |allocations|. Can be
+  // called concurrently.
+  void AddGarbageAllocations(std::vector<Allocation>* allocations);
+
+  // Reaps finished freeing tasks and makes sure that a task frees the
+  // pending backing stores after the GC pause. Main thread only.
+  void FreeAllocationsAfterGC();
+
+  // Frees all pending backing stores on the calling thread.
+  void FreeAllocations();
+
+  // Applies back-pressure to allocation: if the pending garbage exceeds the
+  // budget, the main thread frees backing stores itself. Main thread only.
+  void EnsureWithinBudget();
+
+  // Stops scheduling freeing tasks. Called before the spaces hand their
+  // remaining backing stores to the collector, at which point foreground
+  // tasks can no longer be posted.
+  void StartTearDown() { tearing_down_.SetValue(true); }
+
+  // Waits for freeing tasks and frees all remaining backing stores.
+  void TearDown();
+
+  size_t pending_bytes() { return pending_bytes_.Value(); }
+
+ private:
+  class FreeingTask;
+  class ForegroundFreeingTask;
+
+  // Posts a freeing task unless one is pending already.
+  void ScheduleFreeingTask();
+
+  Heap* heap_;
+  base::Mutex allocations_mutex_;
+  std::vector<std::vector<Allocation>> allocations_;
+  base::AtomicNumber<size_t> pending_bytes_;
+  base::Semaphore pending_freeing_tasks_semaphore_;
+  base::AtomicNumber<intptr_t> concurrent_freeing_tasks_active_;
+  // Set while a posted task has not started freeing yet.
+  base::AtomicValue<bool> freeing_task_pending_;
+  base::AtomicValue<bool> tearing_down_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArrayBufferCollector);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_ARRAY_BUFFER_COLLECTOR_H_
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/array-buffer-collector.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/heap.h"
 
@@ -15,14 +16,14 @@ LocalArrayBufferTracker::~LocalArrayBufferTracker() {
 
 template <LocalArrayBufferTracker::FreeMode free_mode>
 void LocalArrayBufferTracker::Free() {
+  std::vector<ArrayBufferCollector::Allocation> garbage;
   size_t freed_memory = 0;
   for (TrackingData::iterator it = array_buffers_.begin();
        it != array_buffers_.end();) {
     JSArrayBuffer* buffer = reinterpret_cast<JSArrayBuffer*>(it->first);
     if ((free_mode == kFreeAll) || ObjectMarking::IsWhite(buffer)) {
       const size_t len = it->second;
-      heap_->isolate()->array_buffer_allocator()->Free(buffer->backing_store(),
-                                                       len);
+      garbage.push_back(std::make_pair(buffer->backing_store(), len));
       freed_memory += len;
       it = array_buffers_.erase(it);
     } else {
@@ -30,6 +31,7 @@ void LocalArrayBufferTracker::Free() {
     }
   }
   if (freed_memory > 0) {
+    heap_->array_buffer_collector()->AddGarbageAllocations(&garbage);
     heap_->update_external_memory_concurrently_freed(
         static_cast<intptr_t>(freed_memory));
   }
@@ -37,6 +39,7 @@ void LocalArrayBufferTracker::Free() {
 
 template <typename Callback>
 void LocalArrayBufferTracker::Process(Callback callback) {
+  std::vector<ArrayBufferCollector::Allocation> garbage;
   JSArrayBuffer* new_buffer = nullptr;
   size_t freed_memory = 0;
   for (TrackingData::iterator it = array_buffers_.begin();
@@ -61,8 +64,7 @@ void LocalArrayBufferTracker::Process(Callback callback) {
       it = array_buffers_.erase(it);
     } else if (result == kRemoveEntry) {
       const size_t len = it->second;
-      heap_->isolate()->array_buffer_allocator()->Free(
-          it->first->backing_store(), len);
+      garbage.push_back(std::make_pair(it->first->backing_store(), len));
       freed_memory += len;
       it = array_buffers_.erase(it);
     } else {
@@ -70,6 +72,7 @@ void LocalArrayBufferTracker::Process(Callback callback) {
     }
   }
   if (freed_memory > 0) {
+    heap_->array_buffer_collector()->AddGarbageAllocations(&garbage);
     heap_->update_external_memory_concurrently_freed(
         static_cast<intptr_t>(freed_memory));
   }
@@ -0,0 +1,293 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-marking.h"
+
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/incremental-marking.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/mark-compact.h"
+#include "src/heap/objects-visiting.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class ConcurrentMarking::Visitor final : public ObjectVisitor {
+ public:
+  Visitor(ConcurrentMarking* concurrent_marking, int task_id)
+      : concurrent_marking_(concurrent_marking),
+        collector_(concurrent_marking->heap()->mark_compact_collector()),
+        task_id_(task_id),
+        live_bytes_(&concurrent_marking->task_state_[task_id].live_bytes),
+        host_(nullptr) {}
+
+  // Blackens and visits the given grey object. Returns the size of the
+  // object if it was visited by this task and 0 otherwise.
+  int Visit(HeapObject* object) {
+    Map* map = object->synchronized_map();
+    InstanceType type = map->instance_type();
+    // The object may have been trimmed or turned into a filler by the main
+    // thread after it was pushed.
+    if (type == FILLER_TYPE || type == FREE_SPACE_TYPE) return 0;
+    if (!CanVisitConcurrently(object, map)) {
+      concurrent_marking_->bailout_.Push(task_id_, object);
+      return 0;
+    }
+    if (!Marking::GreyToBlack<MarkBit::ATOMIC>(
+            ObjectMarking::MarkBitFrom(object))) {
+      // The main thread blackened the object in the meantime.
+      return 0;
+    }
+    // Pairs with the barrier in IncrementalMarking::BaseRecordWrite: either
+    // the mutator sees the object black and greys the stored value, or the
+    // fields read below already contain the stored value.
+    base::MemoryBarrier();
+    int size = object->SizeFromMap(map);
+    (*live_bytes_)[MemoryChunk::FromAddress(object->address())] += size;
+    host_ = object;
+    VisitPointer(HeapObject::RawField(object, HeapObject::kMapOffset));
+    object->IterateBody(type, size, this);
+    return size;
+  }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** slot = start; slot < end; slot++) {
+      Object* value = reinterpret_cast<Object*>(base::NoBarrier_Load(
+          reinterpret_cast<const base::AtomicWord*>(slot)));
+      if (!value->IsHeapObject()) continue;
+      HeapObject* target = HeapObject::cast(value);
+      collector_->RecordSlot(host_, slot, target);
+      if (ObjectMarking::WhiteToGrey<MarkBit::ATOMIC>(target)) {
+        concurrent_marking_->shared_.Push(task_id_, target);
+      }
+    }
+  }
+
+ private:
+  // Objects whose visitation involves weakness, code flushing, embedder
+  // tracing, or progress bar bookkeeping are left to the main thread.
+  static bool CanVisitConcurrently(HeapObject* object, Map* map) {
+    switch (static_cast<StaticVisitorBase::VisitorId>(map->visitor_id())) {
+      case StaticVisitorBase::kVisitFixedArray:
+        return !MemoryChunk::FromAddress(object->address())
+                    ->IsFlagSet(MemoryChunk::HAS_PROGRESS_BAR);
+      case StaticVisitorBase::kVisitSeqOneByteString:
+      case StaticVisitorBase::kVisitSeqTwoByteString:
+      case StaticVisitorBase::kVisitShortcutCandidate:
+      case StaticVisitorBase::kVisitConsString:
+      case StaticVisitorBase::kVisitSlicedString:
+      case StaticVisitorBase::kVisitThinString:
+      case StaticVisitorBase::kVisitByteArray:
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+      case StaticVisitorBase::kVisitFixedTypedArray:
+      case StaticVisitorBase::kVisitFixedFloat64Array:
+      case StaticVisitorBase::kVisitSymbol:
+      case StaticVisitorBase::kVisitOddball:
+      case StaticVisitorBase::kVisitCell:
+        return true;
+      default:
+        break;
+    }
+    int id = map->visitor_id();
+    return (id >= StaticVisitorBase::kVisitDataObject &&
+            id <= StaticVisitorBase::kVisitDataObjectGeneric) ||
+           (id >= StaticVisitorBase::kVisitJSObject &&
+            id <= StaticVisitorBase::kVisitJSObjectGeneric) ||
+           (id >= StaticVisitorBase::kVisitStruct &&
+            id <= StaticVisitorBase::kVisitStructGeneric);
+  }
+
+  ConcurrentMarking* concurrent_marking_;
+  MarkCompactCollector* collector_;
+  int task_id_;
+  LiveBytesMap* live_bytes_;
+  HeapObject* host_;
+
+  DISALLOW_COPY_AND_ASSIGN(Visitor);
+};
+
+class ConcurrentMarking::Task : public v8::Task {
+ public:
+  Task(ConcurrentMarking* concurrent_marking, int task_id)
+      : concurrent_marking_(concurrent_marking), task_id_(task_id) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::Task overrides.
+  void Run() override { concurrent_marking_->Run(task_id_); }
+
+  ConcurrentMarking* concurrent_marking_;
+  int task_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+ConcurrentMarking::ConcurrentMarking(Heap* heap)
+    : heap_(heap),
+      pending_task_semaphore_(0),
+      task_count_(0) {
+  layout_change_waiters_.SetValue(0);
+  STATIC_ASSERT(kMaxTasks < MarkingWorklist::kMaxNumTasks);
+  for (int i = 0; i <= kMaxTasks; i++) {
+    task_state_[i].current_object.SetValue(nullptr);
+    task_state_[i].marked_bytes = 0;
+  }
+  abort_.SetValue(false);
+}
+
+ConcurrentMarking::~ConcurrentMarking() {
+  abort_.SetValue(true);
+  for (int i = 0; i < task_count_; i++) {
+    pending_task_semaphore_.Wait();
+  }
+  shared_.Clear();
+  bailout_.Clear();
+}
+
+void ConcurrentMarking::Run(int task_id) {
+  TaskState& state = task_state_[task_id];
+  Visitor visitor(this, task_id);
+  HeapObject* object;
+  while (!abort_.Value() && shared_.Pop(task_id, &object)) {
+    state.current_object.SetValue(object);
+    base::MemoryBarrier();
+    state.marked_bytes += visitor.Visit(object);
+    FinishedVisitingObject(&state);
+  }
+  shared_.FlushToGlobal(task_id);
+  bailout_.FlushToGlobal(task_id);
+  if (FLAG_trace_gc_verbose) {
+    heap_->isolate()->PrintWithTimestamp(
+        "Concurrent marking task %d: marked %" PRIuS " bytes\n", task_id,
+        state.marked_bytes);
+  }
+  pending_task_count_.Decrement(1);
+  pending_task_semaphore_.Signal();
+}
+
+void ConcurrentMarking::FinishedVisitingObject(TaskState* state) {
+  state->current_object.SetValue(nullptr);
+  // Pairs with the barrier in NotifyObjectLayoutChange so that either the
+  // waiter sees the cleared object or the task sees the waiter.
+  base::MemoryBarrier();
+  if (layout_change_waiters_.Value() > 0) {
+    base::LockGuard<base::Mutex> guard(&visit_mutex_);
+    visit_done_.NotifyAll();
+  }
+}
+
+void ConcurrentMarking::ScheduleTasks() {
+  if (!FLAG_concurrent_marking || heap_->gc_state() != Heap::NOT_IN_GC) return;
+  if (IsRunning()) return;
+  // All tasks of the previous round have finished. Consume their signals
+  // and publish their results before starting a new round.
+  for (int i = 0; i < task_count_; i++) {
+    pending_task_semaphore_.Wait();
+  }
+  task_count_ = 0;
+  MergeLiveBytes();
+  FlushBailoutToMarkingDeque();
+  MarkingDeque* marking_deque =
+      heap_->mark_compact_collector()->marking_deque();
+  if (marking_deque->IsEmpty()) return;
+  ShareWorkFromMarkingDeque();
+  task_count_ =
+      Min(kMaxTasks,
+          static_cast<int>(
+              V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
+  if (task_count_ < 1) task_count_ = 1;
+  pending_task_count_.SetValue(task_count_);
+  for (int i = 1; i <= task_count_; i++) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new Task(this, i), v8::Platform::kShortRunningTask);
+  }
+}
+
+void ConcurrentMarking::EnsureCompleted() {
+  if (task_count_ == 0 && shared_.IsGlobalEmpty() &&
+      bailout_.IsGlobalEmpty()) {
+    return;
+  }
+  abort_.SetValue(true);
+  for (int i = 0; i < task_count_; i++) {
+    pending_task_semaphore_.Wait();
+  }
+  abort_.SetValue(false);
+  task_count_ = 0;
+  MergeLiveBytes();
+  // Grey objects that were not visited yet go back to the marking deque.
+  // Objects that do not fit are left grey and are recovered by the overflow
+  // handling of the marking deque.
+  MarkingDeque* marking_deque =
+      heap_->mark_compact_collector()->marking_deque();
+  HeapObject* object;
+  while (shared_.Pop(kMainThread, &object)) {
+    marking_deque->Push(object);
+  }
+  FlushBailoutToMarkingDeque();
+}
+
+void ConcurrentMarking::FlushBailoutToMarkingDeque() {
+  MarkingDeque* marking_deque =
+      heap_->mark_compact_collector()->marking_deque();
+  HeapObject* object;
+  while (bailout_.Pop(kMainThread, &object)) {
+    marking_deque->Push(object);
+  }
+}
+
+void ConcurrentMarking::NotifyObjectLayoutChange(HeapObject* object) {
+  if (!IsRunning()) return;
+  // Visiting the object on the main thread before the layout change makes
+  // sure that tasks will not pick it up anymore.
+  if (ObjectMarking::WhiteToBlack<MarkBit::ATOMIC>(object) ||
+      ObjectMarking::GreyToBlack<MarkBit::ATOMIC>(object)) {
+    heap_->incremental_marking()->IterateBlackObject(object);
+  }
+  // A task may have blackened the object right before. Wait until it is done
+  // visiting it.
+  layout_change_waiters_.Increment(1);
+  base::MemoryBarrier();
+  {
+    base::LockGuard<base::Mutex> guard(&visit_mutex_);
+    for (int i = 1; i <= kMaxTasks; i++) {
+      while (task_state_[i].current_object.Value() == object) {
+        visit_done_.Wait(&visit_mutex_);
+      }
+    }
+  }
+  layout_change_waiters_.Decrement(1);
+}
+
+void ConcurrentMarking::ShareWorkFromMarkingDeque() {
+  MarkingDeque* marking_deque =
+      heap_->mark_compact_collector()->marking_deque();
+  // Keep half of the work on the main thread so that incremental marking
+  // steps can make progress without waiting for the tasks.
+  int count = ((marking_deque->top() - marking_deque->bottom()) &
+               marking_deque->mask()) /
+              2;
+  if (count == 0) count = 1;
+  for (int i = 0; i < count && !marking_deque->IsEmpty(); i++) {
+    shared_.Push(kMainThread, marking_deque->Pop());
+  }
+  shared_.FlushToGlobal(kMainThread);
+}
+
+void ConcurrentMarking::MergeLiveBytes() {
+  for (int i = 1; i <= kMaxTasks; i++) {
+    for (auto& pair : task_state_[i].live_bytes) {
+      pair.first->IncrementLiveBytes(static_cast<int>(pair.second));
+    }
+    task_state_[i].live_bytes.clear();
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
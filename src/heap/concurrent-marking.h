@@ -0,0 +1,114 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONCURRENT_MARKING_H_
+#define V8_HEAP_CONCURRENT_MARKING_H_
+
+#include <unordered_map>
+
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/heap/worklist.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+class MemoryChunk;
+
+// Marks objects on background threads while incremental marking is active
+// (--concurrent_marking). The main thread hands over grey objects from the
+// marking deque via a shared worklist. Tasks blacken and visit the objects
+// using atomic mark bit transitions and push newly discovered grey objects
+// onto their private worklist segments. Objects that need main-thread-only
+// processing (weakness, code flushing, embedder tracing, etc.) are pushed
+// onto a bailout worklist and are visited by incremental marking steps.
+//
+// Tasks only run while the mutator runs. They are stopped before any
+// garbage collection, at which point all remaining work is moved back to
+// the marking deque.
+class ConcurrentMarking {
+ public:
+  static const int kMaxTasks = 4;
+  // Task id used by the main thread for accessing the worklists.
+  static const int kMainThread = 0;
+
+  typedef Worklist<HeapObject*, 64> MarkingWorklist;
+
+  explicit ConcurrentMarking(Heap* heap);
+  ~ConcurrentMarking();
+
+  // Moves work from the marking deque to the shared worklist and starts
+  // marking tasks unless they are already running.
+  void ScheduleTasks();
+
+  // Stops the marking tasks, waits for them to finish, and moves remaining
+  // work back to the marking deque.
+  void EnsureCompleted();
+
+  // Moves objects that could not be visited concurrently to the marking
+  // deque.
+  void FlushBailoutToMarkingDeque();
+
+  // Must be called by the main thread before changing the layout of an
+  // object, e.g., by migrating it to a map with a different field layout.
+  // Ensures that no task visits the object concurrently to the change.
+  void NotifyObjectLayoutChange(HeapObject* object);
+
+  bool IsRunning() { return pending_task_count_.Value() > 0; }
+
+  Heap* heap() { return heap_; }
+
+ private:
+  class Task;
+  class Visitor;
+
+  typedef std::unordered_map<MemoryChunk*, intptr_t> LiveBytesMap;
+
+  struct TaskState {
+    // The object that is currently visited by the task, if any.
+    base::AtomicValue<HeapObject*> current_object;
+    // Live bytes are accounted locally and merged into the pages on the
+    // main thread after the task finished.
+    LiveBytesMap live_bytes;
+    size_t marked_bytes;
+    char cache_line_padding[64];
+  };
+
+  // Entry point of a marking task. Task ids start at 1 since the main thread
+  // uses kMainThread for accessing the worklists.
+  void Run(int task_id);
+
+  // Called by a task after it finished visiting an object. Wakes up the main
+  // thread if it waits in NotifyObjectLayoutChange.
+  void FinishedVisitingObject(TaskState* state);
+
+  void ShareWorkFromMarkingDeque();
+  void MergeLiveBytes();
+
+  Heap* heap_;
+  MarkingWorklist shared_;
+  MarkingWorklist bailout_;
+  TaskState task_state_[kMaxTasks + 1];
+  base::AtomicNumber<intptr_t> pending_task_count_;
+  base::AtomicValue<bool> abort_;
+  base::Semaphore pending_task_semaphore_;
+  int task_count_;
+  // Number of main thread waiters in NotifyObjectLayoutChange. Tasks only
+  // take |visit_mutex_| when there is a waiter.
+  base::AtomicNumber<int> layout_change_waiters_;
+  base::Mutex visit_mutex_;
+  base::ConditionVariable visit_done_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMarking);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONCURRENT_MARKING_H_
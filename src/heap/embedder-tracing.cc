@@ -5,6 +5,12 @@
 #include "src/heap/embedder-tracing.h"
 
 #include "src/base/logging.h"
+#include "src/base/platform/semaphore.h"
+#include "src/cancelable-task.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/isolate.h"
+#include "src/v8.h"
 
 namespace v8 {
 namespace internal {
@@ -28,6 +34,7 @@ void LocalEmbedderHeapTracer::AbortTracing() {
   if (!InUse()) return;
 
   cached_wrappers_to_trace_.clear();
+  discovered_objects_.Clear();
   remote_tracer_->AbortTracing();
 }
 
@@ -42,9 +49,101 @@ bool LocalEmbedderHeapTracer::Trace(
   if (!InUse()) return false;
 
   DCHECK_EQ(0, NumberOfCachedWrappersToTrace());
+  const int num_tasks = NumberOfParallelTracingTasks();
+  if (num_tasks > 1) return TraceInParallel(num_tasks, deadline, actions);
   return remote_tracer_->AdvanceTracing(deadline, actions);
 }
 
+class LocalEmbedderHeapTracer::TracingTask : public CancelableTask {
+ public:
+  TracingTask(Isolate* isolate, LocalEmbedderHeapTracer* tracer, int task_id,
+              double deadline,
+              EmbedderHeapTracer::AdvanceTracingActions actions,
+              bool* work_left, base::Semaphore* on_finish)
+      : CancelableTask(isolate),
+        tracer_(tracer),
+        task_id_(task_id),
+        deadline_(deadline),
+        actions_(actions),
+        work_left_(work_left),
+        on_finish_(on_finish) {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    *work_left_ = tracer_->RunTracingTask(task_id_, deadline_, actions_);
+    on_finish_->Signal();
+  }
+
+  LocalEmbedderHeapTracer* tracer_;
+  int task_id_;
+  double deadline_;
+  EmbedderHeapTracer::AdvanceTracingActions actions_;
+  bool* work_left_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(TracingTask);
+};
+
+int LocalEmbedderHeapTracer::NumberOfParallelTracingTasks() {
+  STATIC_ASSERT(kMaxTasks <= DiscoveredObjectsWorklist::kMaxNumTasks);
+  if (!FLAG_parallel_embedder_tracing) return 0;
+  return Min(kMaxTasks,
+             Min(remote_tracer_->NumberOfParallelTracingTasks(),
+                 static_cast<int>(V8::GetCurrentPlatform()
+                                      ->NumberOfAvailableBackgroundThreads()) +
+                     1));
+}
+
+bool LocalEmbedderHeapTracer::TraceInParallel(
+    int num_tasks, double deadline,
+    EmbedderHeapTracer::AdvanceTracingActions actions) {
+  Isolate* isolate = heap_->isolate();
+  base::Semaphore pending_tasks(0);
+  uint32_t task_ids[kMaxTasks];
+  bool work_left[kMaxTasks] = {false};
+  for (int i = 1; i < num_tasks; i++) {
+    TracingTask* task = new TracingTask(isolate, this, i, deadline, actions,
+                                        &work_left[i], &pending_tasks);
+    task_ids[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+  work_left[kMainThread] = RunTracingTask(kMainThread, deadline, actions);
+  for (int i = 1; i < num_tasks; i++) {
+    if (isolate->cancelable_task_manager()->TryAbort(task_ids[i]) ==
+        CancelableTaskManager::kTaskAborted) {
+      // The task did not start. The embedder may have partitioned work by
+      // task id, so its share is traced on the main thread.
+      work_left[i] = RunTracingTask(i, deadline, actions);
+    } else {
+      pending_tasks.Wait();
+    }
+  }
+  MarkDiscoveredObjects();
+  bool result = false;
+  for (int i = 0; i < num_tasks; i++) result |= work_left[i];
+  return result;
+}
+
+bool LocalEmbedderHeapTracer::RunTracingTask(
+    int task_id, double deadline,
+    EmbedderHeapTracer::AdvanceTracingActions actions) {
+  bool work_left =
+      remote_tracer_->AdvanceTracingInParallel(task_id, deadline, actions);
+  // Make the objects found by this task visible to the main thread.
+  discovered_objects_.FlushToGlobal(task_id);
+  return work_left;
+}
+
+void LocalEmbedderHeapTracer::MarkDiscoveredObjects() {
+  HeapObject* object;
+  while (discovered_objects_.Pop(kMainThread, &object)) {
+    heap_->RegisterExternallyReferencedObject(
+        reinterpret_cast<Object**>(&object));
+  }
+}
+
 size_t LocalEmbedderHeapTracer::NumberOfWrappersToTrace() {
   return (InUse())
              ? cached_wrappers_to_trace_.size() +
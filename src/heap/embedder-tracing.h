@@ -8,18 +8,26 @@
 #include "include/v8.h"
 #include "src/flags.h"
 #include "src/globals.h"
+#include "src/heap/worklist.h"
 
 namespace v8 {
 namespace internal {
 
 class Heap;
+class HeapObject;
 
 class V8_EXPORT_PRIVATE LocalEmbedderHeapTracer final {
  public:
   typedef std::pair<void*, void*> WrapperInfo;
 
-  LocalEmbedderHeapTracer()
-      : remote_tracer_(nullptr), num_v8_marking_deque_was_empty_(0) {}
+  // Task id used by the main thread during parallel tracing.
+  static const int kMainThread = 0;
+  static const int kMaxTasks = 8;
+
+  explicit LocalEmbedderHeapTracer(Heap* heap)
+      : heap_(heap),
+        remote_tracer_(nullptr),
+        num_v8_marking_deque_was_empty_(0) {}
 
   void SetRemoteTracer(EmbedderHeapTracer* tracer) { remote_tracer_ = tracer; }
   bool InUse() { return remote_tracer_ != nullptr; }
@@ -31,6 +39,17 @@ class V8_EXPORT_PRIVATE LocalEmbedderHeapTracer final {
   bool Trace(double deadline,
              EmbedderHeapTracer::AdvanceTracingActions actions);
 
+  // Called by the embedder from tracing task |task_id| during parallel
+  // tracing. The object is only recorded; it is marked by the main thread
+  // once all tasks of the tracing step have finished.
+  void RegisterExternallyReferencedObjectConcurrently(int task_id,
+                                                      HeapObject* object) {
+    // The task id comes from the embedder.
+    CHECK_LE(0, task_id);
+    CHECK_LT(task_id, kMaxTasks);
+    discovered_objects_.Push(task_id, object);
+  }
+
   size_t NumberOfWrappersToTrace();
   size_t NumberOfCachedWrappersToTrace() {
     return cached_wrappers_to_trace_.size();
@@ -55,8 +74,20 @@ class V8_EXPORT_PRIVATE LocalEmbedderHeapTracer final {
 
  private:
   typedef std::vector<WrapperInfo> WrapperCache;
+  typedef Worklist<HeapObject*, 64> DiscoveredObjectsWorklist;
+
+  class TracingTask;
+
+  int NumberOfParallelTracingTasks();
+  bool TraceInParallel(int num_tasks, double deadline,
+                       EmbedderHeapTracer::AdvanceTracingActions actions);
+  bool RunTracingTask(int task_id, double deadline,
+                      EmbedderHeapTracer::AdvanceTracingActions actions);
+  void MarkDiscoveredObjects();
 
+  Heap* const heap_;
   EmbedderHeapTracer* remote_tracer_;
+  DiscoveredObjectsWorklist discovered_objects_;
   WrapperCache cached_wrappers_to_trace_;
   size_t num_v8_marking_deque_was_empty_;
 };
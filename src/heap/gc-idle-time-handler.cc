@@ -15,6 +15,9 @@ const double GCIdleTimeHandler::kConservativeTimeRatio = 0.9;
 const size_t GCIdleTimeHandler::kMaxFinalIncrementalMarkCompactTimeInMs = 1000;
 const double GCIdleTimeHandler::kHighContextDisposalRate = 100;
 const size_t GCIdleTimeHandler::kMinTimeForOverApproximatingWeakClosureInMs = 1;
+const double GCIdleTimeHandler::kMaxPredictionSlackFactor = 4.0;
+const double GCIdleTimeHandler::kPredictionSlackGrowFactor = 1.5;
+const double GCIdleTimeHandler::kPredictionSlackDecayFactor = 0.9;
 
 
 void GCIdleTimeAction::Print() {
@@ -27,14 +30,20 @@ void GCIdleTimeAction::Print() {
       break;
     case DO_INCREMENTAL_STEP:
       PrintF("incremental step");
-      if (additional_work) {
+      if (finalize_marking) {
         PrintF("; finalized marking");
       }
+      if (step_size_in_bytes > 0) {
+        PrintF("; %" PRIuS " bytes", step_size_in_bytes);
+      }
       break;
     case DO_FULL_GC:
       PrintF("full GC");
       break;
   }
+  if (estimated_time_in_ms > 0) {
+    PrintF("; estimated %.2f ms", estimated_time_in_ms);
+  }
 }
 
 
@@ -43,6 +52,13 @@ void GCIdleTimeHeapState::Print() {
   PrintF("contexts_disposal_rate=%f ", contexts_disposal_rate);
   PrintF("size_of_objects=%" PRIuS " ", size_of_objects);
   PrintF("incremental_marking_stopped=%d ", incremental_marking_stopped);
+  PrintF("incremental_marking_ready_to_finalize=%d ",
+         incremental_marking_ready_to_finalize);
+  PrintF("incremental_marking_speed=%.f ",
+         incremental_marking_speed_in_bytes_per_ms);
+  PrintF("final_incremental_mark_compact_speed=%.f ",
+         final_incremental_mark_compact_speed_in_bytes_per_ms);
+  PrintF("allocation_throughput=%.f ", allocation_throughput_in_bytes_per_ms);
 }
 
 size_t GCIdleTimeHandler::EstimateMarkingStepSize(
@@ -143,9 +159,73 @@ GCIdleTimeAction GCIdleTimeHandler::Compute(double idle_time_in_ms,
     return GCIdleTimeAction::Done();
   }
 
+  if (FLAG_predictive_idle_time_scheduling) {
+    return ComputeIncrementalMarkingAction(idle_time_in_ms, heap_state);
+  }
+
   return GCIdleTimeAction::IncrementalStep();
 }
 
+// The predictive scheduler works on a time budget, i.e., the idle time pruned
+// by kConservativeTimeRatio and by the slack learned from previous misses:
+// (1) If marking is ready to be finalized and the finalization predicted from
+// the recorded final mark-compact speed fits the budget, finalize first.
+// (2) If finalization does not fit, a marking step only pays off when the
+// mutator keeps producing marking work through the write barrier, i.e., when
+// the allocation rate is not low. Otherwise wait for a longer idle period.
+// (3) If marking work is left and the budget allows for at least one step,
+// size the step from the recorded marking speed. The step processes exactly
+// that many bytes, so its duration checks how well the speed predicted it.
+GCIdleTimeAction GCIdleTimeHandler::ComputeIncrementalMarkingAction(
+    double idle_time_in_ms, const GCIdleTimeHeapState& heap_state) {
+  double budget_in_ms =
+      idle_time_in_ms * kConservativeTimeRatio / prediction_slack_factor_;
+  if (heap_state.incremental_marking_ready_to_finalize) {
+    double finalization_time_in_ms = EstimateFinalIncrementalMarkCompactTime(
+        heap_state.size_of_objects,
+        heap_state.final_incremental_mark_compact_speed_in_bytes_per_ms);
+    if (finalization_time_in_ms <= budget_in_ms) {
+      return GCIdleTimeAction::FinalizeMarking(finalization_time_in_ms);
+    }
+    if (heap_state.allocation_throughput_in_bytes_per_ms <=
+        kLowAllocationThroughput) {
+      return NothingOrDone(idle_time_in_ms);
+    }
+  }
+  if (budget_in_ms < kIncrementalMarkingStepTimeInMs) {
+    return NothingOrDone(idle_time_in_ms);
+  }
+  double marking_speed_in_bytes_per_ms =
+      heap_state.incremental_marking_speed_in_bytes_per_ms;
+  if (marking_speed_in_bytes_per_ms == 0) {
+    marking_speed_in_bytes_per_ms = kInitialConservativeMarkingSpeed;
+  }
+  size_t step_size_in_bytes =
+      EstimateMarkingStepSize(budget_in_ms, marking_speed_in_bytes_per_ms);
+  return GCIdleTimeAction::IncrementalStep(
+      step_size_in_bytes, step_size_in_bytes / marking_speed_in_bytes_per_ms);
+}
+
+bool GCIdleTimeHandler::RecordOutcome(const GCIdleTimeAction& action,
+                                      double idle_time_in_ms,
+                                      double used_time_in_ms) {
+  if (action.estimated_time_in_ms == 0) return false;
+  predicted_actions_++;
+  // Overruns within the margin that kConservativeTimeRatio leaves to the
+  // deadline are not counted as misses.
+  if (used_time_in_ms * kConservativeTimeRatio >
+      action.estimated_time_in_ms) {
+    prediction_misses_++;
+    prediction_slack_factor_ = Min(
+        prediction_slack_factor_ * kPredictionSlackGrowFactor,
+        kMaxPredictionSlackFactor);
+    return true;
+  }
+  prediction_slack_factor_ =
+      Max(prediction_slack_factor_ * kPredictionSlackDecayFactor, 1.0);
+  return false;
+}
+
 bool GCIdleTimeHandler::Enabled() { return FLAG_incremental_marking; }
 
 }  // namespace internal
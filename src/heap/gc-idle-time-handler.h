@@ -24,6 +24,9 @@ class GCIdleTimeAction {
     GCIdleTimeAction result;
     result.type = DONE;
     result.additional_work = false;
+    result.finalize_marking = false;
+    result.step_size_in_bytes = 0;
+    result.estimated_time_in_ms = 0;
     return result;
   }
 
@@ -31,6 +34,9 @@ class GCIdleTimeAction {
     GCIdleTimeAction result;
     result.type = DO_NOTHING;
     result.additional_work = false;
+    result.finalize_marking = false;
+    result.step_size_in_bytes = 0;
+    result.estimated_time_in_ms = 0;
     return result;
   }
 
@@ -38,6 +44,31 @@ class GCIdleTimeAction {
     GCIdleTimeAction result;
     result.type = DO_INCREMENTAL_STEP;
     result.additional_work = false;
+    result.finalize_marking = false;
+    result.step_size_in_bytes = 0;
+    result.estimated_time_in_ms = 0;
+    return result;
+  }
+
+  // An incremental step that processes the given number of bytes instead of
+  // marking until the deadline.
+  static GCIdleTimeAction IncrementalStep(size_t step_size_in_bytes,
+                                          double estimated_time_in_ms) {
+    GCIdleTimeAction result = IncrementalStep();
+    result.step_size_in_bytes = step_size_in_bytes;
+    result.estimated_time_in_ms = estimated_time_in_ms;
+    return result;
+  }
+
+  // An incremental step that tries to finalize marking before doing any
+  // further marking work.
+  static GCIdleTimeAction FinalizeMarking(double estimated_time_in_ms) {
+    GCIdleTimeAction result;
+    result.type = DO_INCREMENTAL_STEP;
+    result.additional_work = false;
+    result.finalize_marking = true;
+    result.step_size_in_bytes = 0;
+    result.estimated_time_in_ms = estimated_time_in_ms;
     return result;
   }
 
@@ -45,6 +76,9 @@ class GCIdleTimeAction {
     GCIdleTimeAction result;
     result.type = DO_FULL_GC;
     result.additional_work = false;
+    result.finalize_marking = false;
+    result.step_size_in_bytes = 0;
+    result.estimated_time_in_ms = 0;
     return result;
   }
 
@@ -52,6 +86,13 @@ class GCIdleTimeAction {
 
   GCIdleTimeActionType type;
   bool additional_work;
+  // Finalize marking before doing any further marking work.
+  bool finalize_marking;
+  // Bytes to process in an incremental step. Zero if the step marks until
+  // the deadline.
+  size_t step_size_in_bytes;
+  // Predicted duration of the action. Zero if no prediction was made.
+  double estimated_time_in_ms;
 };
 
 
@@ -63,6 +104,11 @@ class GCIdleTimeHeapState {
   double contexts_disposal_rate;
   size_t size_of_objects;
   bool incremental_marking_stopped;
+  // Marking has no work left and only waits for finalization.
+  bool incremental_marking_ready_to_finalize;
+  double incremental_marking_speed_in_bytes_per_ms;
+  double final_incremental_mark_compact_speed_in_bytes_per_ms;
+  double allocation_throughput_in_bytes_per_ms;
 };
 
 
@@ -120,7 +166,18 @@ class V8_EXPORT_PRIVATE GCIdleTimeHandler {
   // ensure we don't keep scheduling idle tasks and making no progress.
   static const int kMaxNoProgressIdleTimes = 10;
 
-  GCIdleTimeHandler() : idle_times_which_made_no_progress_(0) {}
+  // Bounds and adjustment factors of the safety margin that the predictive
+  // scheduler applies to its time estimates. The margin grows whenever an
+  // action overran its estimate and decays back on actions that fit.
+  static const double kMaxPredictionSlackFactor;
+  static const double kPredictionSlackGrowFactor;
+  static const double kPredictionSlackDecayFactor;
+
+  GCIdleTimeHandler()
+      : idle_times_which_made_no_progress_(0),
+        prediction_slack_factor_(1.0),
+        predicted_actions_(0),
+        prediction_misses_(0) {}
 
   GCIdleTimeAction Compute(double idle_time_in_ms,
                            GCIdleTimeHeapState heap_state);
@@ -129,6 +186,15 @@ class V8_EXPORT_PRIVATE GCIdleTimeHandler {
 
   void ResetNoProgressCounter() { idle_times_which_made_no_progress_ = 0; }
 
+  // Feeds the outcome of a performed action back into the predictive
+  // scheduler. Returns true if the action took longer than estimated.
+  bool RecordOutcome(const GCIdleTimeAction& action, double idle_time_in_ms,
+                     double used_time_in_ms);
+
+  double prediction_slack_factor() const { return prediction_slack_factor_; }
+  int predicted_actions() const { return predicted_actions_; }
+  int prediction_misses() const { return prediction_misses_; }
+
   static size_t EstimateMarkingStepSize(double idle_time_in_ms,
                                         double marking_speed_in_bytes_per_ms);
 
@@ -147,9 +213,20 @@ class V8_EXPORT_PRIVATE GCIdleTimeHandler {
  private:
   GCIdleTimeAction NothingOrDone(double idle_time_in_ms);
 
+  // Picks an incremental marking action based on the recorded GC speeds and
+  // the allocation rate (--predictive_idle_time_scheduling).
+  GCIdleTimeAction ComputeIncrementalMarkingAction(
+      double idle_time_in_ms, const GCIdleTimeHeapState& heap_state);
+
   // Idle notifications with no progress.
   int idle_times_which_made_no_progress_;
 
+  // Safety margin applied to predictions, >= 1.
+  double prediction_slack_factor_;
+  // Actions with a prediction and how many of them overran their estimate.
+  int predicted_actions_;
+  int prediction_misses_;
+
   DISALLOW_COPY_AND_ASSIGN(GCIdleTimeHandler);
 };
 
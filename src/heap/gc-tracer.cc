@@ -112,6 +112,9 @@ GCTracer::GCTracer(Heap* heap)
       new_space_allocation_in_bytes_since_gc_(0),
       old_generation_allocation_in_bytes_since_gc_(0),
       combined_mark_compact_speed_cache_(0.0),
+      deduplicated_strings_(0),
+      deduplicated_string_bytes_(0),
+      string_deduplication_duration_(0.0),
       start_counter_(0) {
   current_.end_time = heap_->MonotonicallyIncreasingTimeInMs();
 }
@@ -128,6 +131,9 @@ void GCTracer::ResetForTesting() {
   new_space_allocation_in_bytes_since_gc_ = 0.0;
   old_generation_allocation_in_bytes_since_gc_ = 0.0;
   combined_mark_compact_speed_cache_ = 0.0;
+  deduplicated_strings_ = 0;
+  deduplicated_string_bytes_ = 0;
+  string_deduplication_duration_ = 0.0;
   recorded_minor_gcs_total_.Reset();
   recorded_minor_gcs_survived_.Reset();
   recorded_compactions_.Reset();
@@ -369,6 +375,20 @@ void GCTracer::AddSurvivalRatio(double promotion_ratio) {
   recorded_survival_ratios_.Push(promotion_ratio);
 }
 
+void GCTracer::AddStringDeduplication(double duration, size_t strings,
+                                      size_t bytes) {
+  deduplicated_strings_ += strings;
+  deduplicated_string_bytes_ += bytes;
+  string_deduplication_duration_ += duration;
+  Output(
+      "[%d:%p] String deduplication: %" PRIuS " strings, %" PRIuS
+      " KB in %.1f ms (total: %" PRIuS " strings, %" PRIuS " KB in %.1f ms)\n",
+      base::OS::GetCurrentProcessId(),
+      reinterpret_cast<void*>(heap_->isolate()), strings, bytes / KB,
+      duration, deduplicated_strings_, deduplicated_string_bytes_ / KB,
+      string_deduplication_duration_);
+}
+
 void GCTracer::AddIncrementalMarkingStep(double duration, size_t bytes) {
   if (bytes > 0) {
     incremental_marking_bytes_ += bytes;
@@ -519,13 +539,43 @@ void GCTracer::PrintNVP() const {
           "mutator=%.1f "
           "gc=%s "
           "reduce_memory=%d "
+          "minor_mc=%.2f "
           "mark=%.2f "
           "mark.roots=%.2f "
-          "mark.old_to_new=%.2f\n",
+          "mark.old_to_new=%.2f "
+          "mark.weak=%.2f "
+          "mark.global_handles=%.2f "
+          "clear=%.2f "
+          "clear.string_table=%.2f "
+          "clear.weak_lists=%.2f "
+          "evacuate=%.2f "
+          "evacuate.copy=%.2f "
+          "evacuate.update_pointers=%.2f "
+          "evacuate.update_pointers.to_new=%.2f "
+          "evacuate.update_pointers.weak=%.2f "
+          "evacuate.rebalance=%.2f "
+          "evacuate.clean_up=%.2f "
+          "promoted=%" PRIuS
+          " "
+          "semi_space_copy_rate=%.1f%%\n",
           duration, spent_in_mutator, "mmc", current_.reduce_memory,
+          current_.scopes[Scope::MINOR_MC],
           current_.scopes[Scope::MINOR_MC_MARK],
           current_.scopes[Scope::MINOR_MC_MARK_ROOTS],
-          current_.scopes[Scope::MINOR_MC_MARK_OLD_TO_NEW_POINTERS]);
+          current_.scopes[Scope::MINOR_MC_MARK_OLD_TO_NEW_POINTERS],
+          current_.scopes[Scope::MINOR_MC_MARK_WEAK],
+          current_.scopes[Scope::MINOR_MC_MARK_GLOBAL_HANDLES],
+          current_.scopes[Scope::MINOR_MC_CLEAR],
+          current_.scopes[Scope::MINOR_MC_CLEAR_STRING_TABLE],
+          current_.scopes[Scope::MINOR_MC_CLEAR_WEAK_LISTS],
+          current_.scopes[Scope::MC_EVACUATE],
+          current_.scopes[Scope::MC_EVACUATE_COPY],
+          current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS],
+          current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW],
+          current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_WEAK],
+          current_.scopes[Scope::MC_EVACUATE_REBALANCE],
+          current_.scopes[Scope::MC_EVACUATE_CLEAN_UP],
+          heap_->promoted_objects_size(), heap_->semi_space_copied_rate_);
       break;
     case Event::MARK_COMPACTOR:
     case Event::INCREMENTAL_MARK_COMPACTOR:
@@ -82,6 +82,10 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   F(MC_SWEEP_CODE)                            \
   F(MC_SWEEP_MAP)                             \
   F(MC_SWEEP_OLD)                             \
+  F(MINOR_MC)                                 \
+  F(MINOR_MC_CLEAR)                           \
+  F(MINOR_MC_CLEAR_STRING_TABLE)              \
+  F(MINOR_MC_CLEAR_WEAK_LISTS)                \
   F(MINOR_MC_MARK)                            \
   F(MINOR_MC_MARK_CODE_FLUSH_CANDIDATES)      \
   F(MINOR_MC_MARK_GLOBAL_HANDLES)             \
@@ -254,6 +258,15 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void AddSurvivalRatio(double survival_ratio);
 
+  // Log a string deduplication pass that turned |strings| strings into
+  // ThinStrings, saving |bytes| bytes.
+  void AddStringDeduplication(double duration, size_t strings, size_t bytes);
+
+  size_t deduplicated_strings() const { return deduplicated_strings_; }
+  size_t deduplicated_string_bytes() const {
+    return deduplicated_string_bytes_;
+  }
+
   // Log an incremental marking step.
   void AddIncrementalMarkingStep(double duration, size_t bytes);
 
@@ -421,6 +434,11 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   double combined_mark_compact_speed_cache_;
 
+  // Totals of string deduplication passes.
+  size_t deduplicated_strings_;
+  size_t deduplicated_string_bytes_;
+  double string_deduplication_duration_;
+
   // Counts how many tracers were started without stopping.
   int start_counter_;
 
@@ -4,6 +4,9 @@
 
 #include "src/heap/heap.h"
 
+#include <unordered_map>
+#include <vector>
+
 #include "src/accessors.h"
 #include "src/api.h"
 #include "src/assembler-inl.h"
@@ -20,8 +23,10 @@
 #include "src/deoptimizer.h"
 #include "src/feedback-vector.h"
 #include "src/global-handles.h"
+#include "src/heap/array-buffer-collector.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/code-stats.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/heap/embedder-tracing.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
@@ -43,6 +48,7 @@
 #include "src/snapshot/serializer-common.h"
 #include "src/snapshot/snapshot.h"
 #include "src/tracing/trace-event.h"
+#include "src/tracing/traced-value.h"
 #include "src/utils.h"
 #include "src/v8.h"
 #include "src/v8threads.h"
@@ -96,6 +102,9 @@ Heap::Heap()
       survived_last_scavenge_(0),
       always_allocate_scope_count_(0),
       memory_pressure_level_(MemoryPressureLevel::kNone),
+      system_memory_pressure_level_(MemoryPressureLevel::kNone),
+      system_memory_headroom_(SIZE_MAX),
+      last_system_memory_pressure_sample_ms_(0),
       out_of_memory_callback_(nullptr),
       out_of_memory_callback_data_(nullptr),
       contexts_disposed_(0),
@@ -117,6 +126,8 @@ Heap::Heap()
       allocation_timeout_(0),
 #endif  // DEBUG
       old_generation_allocation_limit_(initial_old_generation_size_),
+      target_mutator_utilization_(0),
+      heap_growing_cap_(0),
       inline_allocation_disabled_(false),
       tracer_(nullptr),
       promoted_objects_size_(0),
@@ -135,6 +146,8 @@ Heap::Heap()
       memory_allocator_(nullptr),
       store_buffer_(nullptr),
       incremental_marking_(nullptr),
+      concurrent_marking_(nullptr),
+      array_buffer_collector_(nullptr),
       gc_idle_time_handler_(nullptr),
       memory_reducer_(nullptr),
       live_object_stats_(nullptr),
@@ -331,6 +344,15 @@ void Heap::PrintShortHeapStatistics() {
                          " available: %6" PRIuS " KB\n",
                memory_allocator()->Size() / KB,
                memory_allocator()->Available() / KB);
+  if (FLAG_huge_pages) {
+    const size_t committed = CommittedMemory();
+    const size_t huge_page_backed = memory_allocator()->HugePageBackedMemory();
+    PrintIsolate(isolate_, "Huge pages,       backed: %6" PRIuS
+                           " KB"
+                           ", coverage: %.1f%%\n",
+                 huge_page_backed / KB,
+                 committed > 0 ? 100.0 * huge_page_backed / committed : 0.0);
+  }
   PrintIsolate(isolate_, "New space,          used: %6" PRIuS
                          " KB"
                          ", available: %6" PRIuS
@@ -413,6 +435,11 @@ void Heap::IncrementDeferredCount(v8::Isolate::UseCounterFeature feature) {
 bool Heap::UncommitFromSpace() { return new_space_->UncommitFromSpace(); }
 
 void Heap::GarbageCollectionPrologue() {
+  // Marking tasks must not run concurrently to a garbage collection.
+  concurrent_marking()->EnsureCompleted();
+  // Refresh the container headroom for the allocation limit computed at the
+  // end of this garbage collection.
+  SampleSystemMemoryPressure();
   {
     AllowHeapAllocation for_the_first_part_of_prologue;
     gc_count_++;
@@ -550,6 +577,33 @@ class Heap::PretenuringScope {
 };
 
 
+namespace {
+
+void AppendPretenuringSiteStats(v8::tracing::TracedValue* value,
+                                AllocationSite* site, int create_count,
+                                int found_count,
+                                AllocationSite::PretenureDecision previous,
+                                bool deopt) {
+  char address[32];
+  SNPrintF(ArrayVector(address), "%p", static_cast<void*>(site));
+  value->BeginDictionary();
+  value->SetString("site", address);
+  value->SetInteger("created", create_count);
+  value->SetInteger("found", found_count);
+  value->SetDouble("ratio",
+                   create_count > 0
+                       ? static_cast<double>(found_count) / create_count
+                       : 0.0);
+  value->SetString("previous", site->PretenureDecisionName(previous));
+  value->SetString("decision",
+                   site->PretenureDecisionName(site->pretenure_decision()));
+  value->SetBoolean("pinned", site->is_pretenure_decision_pinned());
+  value->SetBoolean("deopt", deopt);
+  value->EndDictionary();
+}
+
+}  // namespace
+
 void Heap::ProcessPretenuringFeedback() {
   bool trigger_deoptimization = false;
   if (FLAG_allocation_site_pretenuring) {
@@ -558,9 +612,21 @@ void Heap::ProcessPretenuringFeedback() {
     int allocation_mementos_found = 0;
     int allocation_sites = 0;
     int active_allocation_sites = 0;
+    int deopt_decisions = 0;
 
     AllocationSite* site = nullptr;
 
+    // Per-site statistics are only collected when the tracing category is
+    // enabled.
+    std::unique_ptr<v8::tracing::TracedValue> site_stats;
+    bool tracing_enabled = false;
+    TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+        TRACE_DISABLED_BY_DEFAULT("v8.gc.pretenuring"), &tracing_enabled);
+    if (tracing_enabled) {
+      site_stats = v8::tracing::TracedValue::Create();
+      site_stats->BeginArray("sites");
+    }
+
     // Step 1: Digest feedback for recorded allocation sites.
     bool maximum_size_scavenge = MaximumSizeScavenge();
     for (base::HashMap::Entry* e = global_pretenuring_feedback_->Start();
@@ -575,8 +641,16 @@ void Heap::ProcessPretenuringFeedback() {
         DCHECK(site->IsAllocationSite());
         active_allocation_sites++;
         allocation_mementos_found += found_count;
-        if (site->DigestPretenuringFeedback(maximum_size_scavenge)) {
+        AllocationSite::PretenureDecision previous = site->pretenure_decision();
+        int create_count = site->memento_create_count();
+        bool deopt = site->DigestPretenuringFeedback(maximum_size_scavenge);
+        if (deopt) {
           trigger_deoptimization = true;
+          deopt_decisions++;
+        }
+        if (site_stats) {
+          AppendPretenuringSiteStats(site_stats.get(), site, create_count,
+                                     found_count, previous, deopt);
         }
         if (site->GetPretenureMode() == TENURED) {
           tenure_decisions++;
@@ -597,6 +671,7 @@ void Heap::ProcessPretenuringFeedback() {
         if (site->IsMaybeTenure()) {
           site->set_deopt_dependent_code(true);
           trigger_deoptimization = true;
+          deopt_decisions++;
         }
         list_element = site->weak_next();
       }
@@ -606,6 +681,19 @@ void Heap::ProcessPretenuringFeedback() {
       isolate_->stack_guard()->RequestDeoptMarkedAllocationSites();
     }
 
+    if (site_stats) {
+      site_stats->EndArray();
+      site_stats->SetInteger("visited_sites", allocation_sites);
+      site_stats->SetInteger("active_sites", active_allocation_sites);
+      site_stats->SetInteger("mementos", allocation_mementos_found);
+      site_stats->SetInteger("tenured", tenure_decisions);
+      site_stats->SetInteger("not_tenured", dont_tenure_decisions);
+      site_stats->SetInteger("deopts", deopt_decisions);
+      TRACE_EVENT_INSTANT1(TRACE_DISABLED_BY_DEFAULT("v8.gc.pretenuring"),
+                           "V8.GC_Pretenuring", TRACE_EVENT_SCOPE_THREAD,
+                           "stats", std::move(site_stats));
+    }
+
     if (FLAG_trace_pretenuring_statistics &&
         (allocation_mementos_found > 0 || tenure_decisions > 0 ||
          dont_tenure_decisions > 0)) {
@@ -621,6 +709,31 @@ void Heap::ProcessPretenuringFeedback() {
 }
 
 
+int Heap::SetPretenuringMode(Handle<JSFunction> function,
+                             AllocationSite::PinnedMode mode) {
+  if (!function->has_feedback_vector()) return 0;
+  DisallowHeapAllocation no_gc;
+  FeedbackVector* vector = function->feedback_vector();
+  int updated_sites = 0;
+  bool trigger_deoptimization = false;
+  // Literal and Array constructor call slots hold the allocation site of the
+  // top-level literal, which links the sites of nested literals.
+  for (int i = FeedbackVector::kReservedIndexCount; i < vector->length();
+       i++) {
+    Object* current = vector->get(i);
+    while (current->IsAllocationSite()) {
+      AllocationSite* site = AllocationSite::cast(current);
+      if (site->SetPinnedMode(mode)) trigger_deoptimization = true;
+      updated_sites++;
+      current = site->nested_site();
+    }
+  }
+  if (trigger_deoptimization) {
+    isolate_->stack_guard()->RequestDeoptMarkedAllocationSites();
+  }
+  return updated_sites;
+}
+
 void Heap::DeoptMarkedAllocationSites() {
   // TODO(hpayer): If iterating over the allocation sites list becomes a
   // performance issue, use a cache data structure in heap instead.
@@ -639,6 +752,10 @@ void Heap::DeoptMarkedAllocationSites() {
 
 
 void Heap::GarbageCollectionEpilogue() {
+  // Backing stores of array buffers that died are released by a task after
+  // the GC pause.
+  array_buffer_collector()->FreeAllocationsAfterGC();
+
   // In release mode, we only zap the from space under heap verification.
   if (Heap::ShouldZapGarbage()) {
     ZapFromSpace();
@@ -963,6 +1080,21 @@ void Heap::EnsureFillerObjectAtTop() {
   }
 }
 
+class StringDeduplicationTask : public CancelableTask {
+ public:
+  explicit StringDeduplicationTask(Heap* heap)
+      : CancelableTask(heap->isolate()), heap_(heap) {}
+
+  virtual ~StringDeduplicationTask() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override { heap_->DeduplicateStrings(); }
+
+  Heap* heap_;
+  DISALLOW_COPY_AND_ASSIGN(StringDeduplicationTask);
+};
+
 bool Heap::CollectGarbage(GarbageCollector collector,
                           GarbageCollectionReason gc_reason,
                           const char* collector_reason,
@@ -1041,6 +1173,15 @@ bool Heap::CollectGarbage(GarbageCollector collector,
     tracer()->Stop(collector);
   }
 
+  // Deduplication allocates and may trigger another GC, so it runs after the
+  // GC finished.
+  if (collector == MARK_COMPACTOR && FLAG_string_deduplication &&
+      !mark_compact_collector()->string_deduplication_candidates_.is_empty()) {
+    V8::GetCurrentPlatform()->CallOnForegroundThread(
+        reinterpret_cast<v8::Isolate*>(isolate()),
+        new StringDeduplicationTask(this));
+  }
+
   if (collector == MARK_COMPACTOR &&
       (gc_callback_flags & (kGCCallbackFlagForced |
                             kGCCallbackFlagCollectAllAvailableGarbage)) != 0) {
@@ -1061,6 +1202,63 @@ bool Heap::CollectGarbage(GarbageCollector collector,
 }
 
 
+void Heap::DeduplicateStrings() {
+  List<String*>* candidates =
+      &mark_compact_collector()->string_deduplication_candidates_;
+  if (candidates->is_empty()) return;
+  // Candidates are in old space and are neither moved nor freed until the
+  // next mark-compact, which collects new candidates.
+  if (mark_compact_collector()->string_deduplication_ms_count_ != ms_count_) {
+    candidates->Clear();
+    return;
+  }
+  double start = MonotonicallyIncreasingTimeInMs();
+  HandleScope scope(isolate());
+  std::vector<Handle<String>> strings;
+  strings.reserve(candidates->length());
+  for (int i = 0; i < candidates->length(); i++) {
+    strings.push_back(handle(candidates->at(i), isolate()));
+  }
+  candidates->Clear();
+
+  // The first string with a given content is only internalized once a
+  // duplicate shows up. Internalization happens in place since candidates
+  // are in old space.
+  std::unordered_multimap<uint32_t, Handle<String>> seen;
+  size_t deduplicated_strings = 0;
+  size_t deduplicated_bytes = 0;
+  for (Handle<String> string : strings) {
+    // Strings may have been internalized in the meantime.
+    if (!string->IsSeqString() || string->IsInternalizedString()) continue;
+    int size = string->Size();
+    bool duplicate =
+        !StringTable::LookupStringIfExists(isolate(), string).is_null();
+    if (!duplicate) {
+      uint32_t hash = string->Hash();
+      auto range = seen.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->IsInternalizedString()) continue;
+        if (!String::Equals(it->second, string)) continue;
+        StringTable::LookupString(isolate(), it->second);
+        duplicate = true;
+        break;
+      }
+      if (!duplicate) {
+        seen.insert(std::make_pair(hash, string));
+        continue;
+      }
+    }
+    StringTable::LookupString(isolate(), string);
+    if (string->IsThinString()) {
+      deduplicated_strings++;
+      deduplicated_bytes += size - ThinString::kSize;
+    }
+  }
+  tracer()->AddStringDeduplication(MonotonicallyIncreasingTimeInMs() - start,
+                                   deduplicated_strings, deduplicated_bytes);
+}
+
+
 int Heap::NotifyContextDisposed(bool dependant_context) {
   if (!dependant_context) {
     tracer()->ResetSurvivalEvents();
@@ -1483,7 +1681,29 @@ void Heap::MarkCompact() {
   }
 }
 
-void Heap::MinorMarkCompact() { UNREACHABLE(); }
+void Heap::MinorMarkCompact() {
+  DCHECK(FLAG_minor_mc);
+
+  PauseAllocationObserversScope pause_observers(this);
+  SetGCState(MINOR_MARK_COMPACT);
+  LOG(isolate_, ResourceEvent("MinorMarkCompact", "begin"));
+
+  TRACE_GC(tracer(), GCTracer::Scope::MINOR_MC);
+  AlwaysAllocateScope always_allocate(isolate());
+  size_t survived_watermark = PromotedSpaceSizeOfObjects();
+
+  // The young generation marker does not know about large objects. They are
+  // kept alive conservatively.
+  PromoteYoungLargeObjects();
+
+  mark_compact_collector()->CollectGarbageInYoungGeneration();
+
+  IncrementYoungSurvivorsCounter(PromotedSpaceSizeOfObjects() +
+                                 new_space_->Size() - survived_watermark);
+
+  LOG(isolate_, ResourceEvent("MinorMarkCompact", "end"));
+  SetGCState(NOT_IN_GC);
+}
 
 void Heap::MarkCompactEpilogue() {
   TRACE_GC(tracer(), GCTracer::Scope::MC_EPILOGUE);
@@ -1513,6 +1733,53 @@ void Heap::MarkCompactPrologue() {
 
   FlushNumberStringCache();
   ClearNormalizedMapCaches();
+
+  PromoteYoungLargeObjects();
+}
+
+class RecordPromotedLargeObjectSlotsVisitor final : public ObjectVisitor {
+ public:
+  RecordPromotedLargeObjectSlotsVisitor(Heap* heap, HeapObject* host)
+      : heap_(heap),
+        host_(host),
+        chunk_(MemoryChunk::FromAddress(host->address())) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** slot = start; slot < end; slot++) {
+      Object* target = *slot;
+      if (!target->IsHeapObject()) continue;
+      if (heap_->InNewSpace(target)) {
+        // Slots of large objects may lie beyond the first page of the chunk,
+        // so the chunk of the host is used.
+        RememberedSet<OLD_TO_NEW>::Insert(chunk_,
+                                          reinterpret_cast<Address>(slot));
+      } else {
+        heap_->mark_compact_collector()->RecordSlot(host_, slot, target);
+      }
+    }
+  }
+
+ private:
+  Heap* heap_;
+  HeapObject* host_;
+  MemoryChunk* chunk_;
+};
+
+void Heap::PromoteYoungLargeObjects() {
+  if (!lo_space_->HasYoungObjects()) return;
+  std::vector<HeapObject*> promoted;
+  for (LargePage* page : *lo_space_) {
+    HeapObject* object = page->GetObject();
+    if (page->InNewSpace() && lo_space_->PromoteYoungObject(object)) {
+      promoted.push_back(object);
+    }
+  }
+  // Slots are recorded once all objects are old, so that pointers between
+  // promoted objects are not recorded as old-to-new.
+  for (HeapObject* object : promoted) {
+    RecordPromotedLargeObjectSlotsVisitor visitor(this, object);
+    object->IterateBody(&visitor);
+  }
 }
 
 
@@ -1535,7 +1802,7 @@ void Heap::CheckNewSpaceExpansionCriteria() {
 }
 
 
-static bool IsUnscavengedHeapObject(Heap* heap, Object** p) {
+bool Heap::IsUnscavengedHeapObject(Heap* heap, Object** p) {
   return heap->InNewSpace(*p) &&
          !HeapObject::cast(*p)->map_word().IsForwardingAddress();
 }
@@ -1622,6 +1889,7 @@ void Heap::EvacuateYoungGeneration() {
     if (incremental_marking()->IsMarking())
       mark_compact_collector()->RecordLiveSlotsOnPage(p);
   }
+  PromoteYoungLargeObjects();
 
   // Reset new space.
   if (!new_space()->Rebalance()) {
@@ -1670,6 +1938,7 @@ void Heap::Scavenge() {
   // live objects.
   new_space_->Flip();
   new_space_->ResetAllocationInfo();
+  lo_space_->FlipYoungPages();
 
   // We need to sweep newly copied objects which can be either in the
   // to space or promoted to the old generation.  For to-space
@@ -1696,60 +1965,67 @@ void Heap::Scavenge() {
   isolate()->global_handles()->IdentifyWeakUnmodifiedObjects(
       &IsUnmodifiedHeapObject);
 
-  {
-    // Copy roots.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
-    IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
-  }
+  if (scavenge_collector_->CanScavengeInParallel()) {
+    scavenge_collector_->ScavengeInParallel();
+    new_space_front = new_space_->top();
+  } else {
+    {
+      // Copy roots.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+      IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+    }
 
-  {
-    // Copy objects reachable from the old generation.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
-    RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
-      return Scavenger::CheckAndScavengeObject(this, addr);
-    });
-
-    RememberedSet<OLD_TO_NEW>::IterateTyped(
-        this, [this](SlotType type, Address host_addr, Address addr) {
-          return UpdateTypedSlotHelper::UpdateTypedSlot(
-              isolate(), type, addr, [this](Object** addr) {
-                // We expect that objects referenced by code are long living.
-                // If we do not force promotion, then we need to clear
-                // old_to_new slots in dead code objects after mark-compact.
-                return Scavenger::CheckAndScavengeObject(
-                    this, reinterpret_cast<Address>(addr));
-              });
-        });
-  }
+    {
+      // Copy objects reachable from the old generation.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
+      RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
+        return Scavenger::CheckAndScavengeObject(this, addr);
+      });
+
+      RememberedSet<OLD_TO_NEW>::IterateTyped(
+          this, [this](SlotType type, Address host_addr, Address addr) {
+            return UpdateTypedSlotHelper::UpdateTypedSlot(
+                isolate(), type, addr, [this](Object** addr) {
+                  // We expect that objects referenced by code are long living.
+                  // If we do not force promotion, then we need to clear
+                  // old_to_new slots in dead code objects after mark-compact.
+                  return Scavenger::CheckAndScavengeObject(
+                      this, reinterpret_cast<Address>(addr));
+                });
+          });
+    }
 
-  {
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
-    // Copy objects reachable from the encountered weak collections list.
-    scavenge_visitor.VisitPointer(&encountered_weak_collections_);
-  }
+    {
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
+      // Copy objects reachable from the encountered weak collections list.
+      scavenge_visitor.VisitPointer(&encountered_weak_collections_);
+    }
 
-  {
-    // Copy objects reachable from the code flushing candidates list.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
-    MarkCompactCollector* collector = mark_compact_collector();
-    if (collector->is_code_flushing_enabled()) {
-      collector->code_flusher()->IteratePointersToFromSpace(&scavenge_visitor);
+    {
+      // Copy objects reachable from the code flushing candidates list.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
+      MarkCompactCollector* collector = mark_compact_collector();
+      if (collector->is_code_flushing_enabled()) {
+        collector->code_flusher()->IteratePointersToFromSpace(
+            &scavenge_visitor);
+      }
     }
-  }
 
-  {
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
-    new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
-  }
+    {
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
+      new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
+    }
 
-  isolate()->global_handles()->MarkNewSpaceWeakUnmodifiedObjectsPending(
-      &IsUnscavengedHeapObject);
+    isolate()->global_handles()->MarkNewSpaceWeakUnmodifiedObjectsPending(
+        &IsUnscavengedHeapObject);
 
-  isolate()
-      ->global_handles()
-      ->IterateNewSpaceWeakUnmodifiedRoots<
-          GlobalHandles::HANDLE_PHANTOM_NODES_VISIT_OTHERS>(&scavenge_visitor);
-  new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
+    isolate()
+        ->global_handles()
+        ->IterateNewSpaceWeakUnmodifiedRoots<
+            GlobalHandles::HANDLE_PHANTOM_NODES_VISIT_OTHERS>(
+            &scavenge_visitor);
+    new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
+  }
 
   UpdateNewSpaceReferencesInExternalStringTable(
       &UpdateNewSpaceReferenceInExternalStringTableEntry);
@@ -1768,6 +2044,9 @@ void Heap::Scavenge() {
 
   ArrayBufferTracker::FreeDeadInNewSpace(this);
 
+  // Young large objects that survived have been promoted in place.
+  lo_space_->FreeDeadYoungObjects();
+
   // Update how much has survived scavenge.
   DCHECK_GE(PromotedSpaceSizeOfObjects(), survived_watermark);
   IncrementYoungSurvivorsCounter(PromotedSpaceSizeOfObjects() +
@@ -1798,6 +2077,13 @@ void Heap::ComputeFastPromotionMode(double survival_rate) {
 
 String* Heap::UpdateNewSpaceReferenceInExternalStringTableEntry(Heap* heap,
                                                                 Object** p) {
+  if (!heap->InFromSpace(*p)) {
+    // Young large objects that survived have been promoted in place.
+    String* string = String::cast(*p);
+    if (string->IsThinString()) string = ThinString::cast(string)->actual();
+    return string->IsExternalString() ? string : nullptr;
+  }
+
   MapWord first_word = HeapObject::cast(*p)->map_word();
 
   if (!first_word.IsForwardingAddress()) {
@@ -1898,7 +2184,8 @@ void Heap::ResetAllAllocationSitesDependentCode(PretenureFlag flag) {
   bool marked = false;
   while (cur->IsAllocationSite()) {
     AllocationSite* casted = AllocationSite::cast(cur);
-    if (casted->GetPretenureMode() == flag) {
+    if (casted->GetPretenureMode() == flag &&
+        !casted->is_pretenure_decision_pinned()) {
       casted->ResetPretenureDecision();
       casted->set_deopt_dependent_code(true);
       marked = true;
@@ -3151,7 +3438,7 @@ void Heap::AdjustLiveBytes(HeapObject* object, int by) {
   // update while using HeapIterator because the iterator is temporarily
   // marking the whole object graph, without updating live bytes.
   if (lo_space()->Contains(object)) {
-    lo_space()->AdjustLiveBytes(by);
+    lo_space()->AdjustLiveBytes(object, by);
   } else if (!in_heap_iterator() &&
              !mark_compact_collector()->sweeping_in_progress() &&
              ObjectMarking::IsBlack(object)) {
@@ -3188,6 +3475,9 @@ FixedArrayBase* Heap::LeftTrimFixedArray(FixedArrayBase* object,
   Address old_start = object->address();
   Address new_start = old_start + bytes_to_trim;
 
+  // Marking tasks must not visit the object while its start moves.
+  concurrent_marking()->NotifyObjectLayoutChange(object);
+
   // Transfer the mark bits to their new location if the object is not within
   // a black area.
   if (!incremental_marking()->black_allocation() ||
@@ -3207,7 +3497,7 @@ FixedArrayBase* Heap::LeftTrimFixedArray(FixedArrayBase* object,
   if (incremental_marking()->black_allocation() &&
       Marking::IsBlackOrGrey(ObjectMarking::MarkBitFrom(object))) {
     Page* page = Page::FromAddress(old_start);
-    page->markbits()->ClearRange(
+    page->markbits()->ClearRange<MarkBit::ATOMIC>(
         page->AddressToMarkbitIndex(old_start),
         page->AddressToMarkbitIndex(old_start + bytes_to_trim));
   }
@@ -3268,6 +3558,9 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
     return;
   }
 
+  // Marking tasks must not visit the trimmed part of the object.
+  concurrent_marking()->NotifyObjectLayoutChange(object);
+
   // Calculate location of new array end.
   Address old_end = object->address() + object->Size();
   Address new_end = old_end - bytes_to_trim;
@@ -3287,7 +3580,7 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
     if (incremental_marking()->black_allocation() &&
         ObjectMarking::IsBlackOrGrey(filler)) {
       Page* page = Page::FromAddress(new_end);
-      page->markbits()->ClearRange(
+      page->markbits()->ClearRange<MarkBit::ATOMIC>(
           page->AddressToMarkbitIndex(new_end),
           page->AddressToMarkbitIndex(new_end + bytes_to_trim));
     }
@@ -4263,23 +4556,26 @@ void Heap::RegisterReservationsForBlackAllocation(Reservation* reservations) {
   // for marking. We just have to execute the special visiting side effect
   // code that adds objects to global data structures, e.g. for array buffers.
 
-  if (incremental_marking()->black_allocation()) {
-    // Iterate black objects in old space, code space, map space, and large
-    // object space for side effects.
-    for (int i = OLD_SPACE; i < Serializer::kNumberOfSpaces; i++) {
-      const Heap::Reservation& res = reservations[i];
-      for (auto& chunk : res) {
-        Address addr = chunk.start;
-        while (addr < chunk.end) {
-          HeapObject* obj = HeapObject::FromAddress(addr);
-          // There might be grey objects due to black to grey transitions in
-          // incremental marking. E.g. see VisitNativeContextIncremental.
-          DCHECK(ObjectMarking::IsBlackOrGrey(obj));
-          if (ObjectMarking::IsBlack(obj)) {
-            incremental_marking()->IterateBlackObject(obj);
-          }
-          addr += obj->Size();
+  // Iterate black objects in old space, code space, map space, and large
+  // object space for side effects. Code and map space may allocate black
+  // before the other spaces.
+  for (int i = OLD_SPACE; i < Serializer::kNumberOfSpaces; i++) {
+    if (!incremental_marking()->black_allocation_in(
+            static_cast<AllocationSpace>(i))) {
+      continue;
+    }
+    const Heap::Reservation& res = reservations[i];
+    for (auto& chunk : res) {
+      Address addr = chunk.start;
+      while (addr < chunk.end) {
+        HeapObject* obj = HeapObject::FromAddress(addr);
+        // There might be grey objects due to black to grey transitions in
+        // incremental marking. E.g. see VisitNativeContextIncremental.
+        DCHECK(ObjectMarking::IsBlackOrGrey(obj));
+        if (ObjectMarking::IsBlack(obj)) {
+          incremental_marking()->IterateBlackObject(obj);
         }
+        addr += obj->Size();
       }
     }
   }
@@ -4288,7 +4584,11 @@ void Heap::RegisterReservationsForBlackAllocation(Reservation* reservations) {
 void Heap::NotifyObjectLayoutChange(HeapObject* object,
                                     const DisallowHeapAllocation&) {
   if (FLAG_incremental_marking && incremental_marking()->IsMarking()) {
-    incremental_marking()->MarkGrey(this, object);
+    if (concurrent_marking()->IsRunning()) {
+      concurrent_marking()->NotifyObjectLayoutChange(object);
+    } else {
+      incremental_marking()->MarkGrey(this, object);
+    }
   }
 #ifdef VERIFY_HEAP
   DCHECK(pending_layout_change_object_ == nullptr);
@@ -4315,6 +4615,17 @@ GCIdleTimeHeapState Heap::ComputeHeapState() {
       tracer()->ContextDisposalRateInMilliseconds();
   heap_state.size_of_objects = static_cast<size_t>(SizeOfObjects());
   heap_state.incremental_marking_stopped = incremental_marking()->IsStopped();
+  heap_state.incremental_marking_ready_to_finalize =
+      !heap_state.incremental_marking_stopped &&
+      (incremental_marking()->IsComplete() ||
+       (mark_compact_collector()->marking_deque()->IsEmpty() &&
+        local_embedder_heap_tracer()->ShouldFinalizeIncrementalMarking()));
+  heap_state.incremental_marking_speed_in_bytes_per_ms =
+      tracer()->IncrementalMarkingSpeedInBytesPerMillisecond();
+  heap_state.final_incremental_mark_compact_speed_in_bytes_per_ms =
+      tracer()->FinalIncrementalMarkCompactSpeedInBytesPerMillisecond();
+  heap_state.allocation_throughput_in_bytes_per_ms =
+      tracer()->CurrentAllocationThroughputInBytesPerMillisecond();
   return heap_state;
 }
 
@@ -4328,6 +4639,29 @@ bool Heap::PerformIdleTimeAction(GCIdleTimeAction action,
       result = true;
       break;
     case DO_INCREMENTAL_STEP: {
+      // Finalization was predicted to fit the deadline and takes priority
+      // over further marking.
+      if (action.finalize_marking &&
+          TryFinalizeIdleIncrementalMarking(
+              deadline_in_ms - MonotonicallyIncreasingTimeInMs(),
+              GarbageCollectionReason::kFinalizeMarkingViaTask)) {
+        result = incremental_marking()->IsStopped();
+        break;
+      }
+      if (action.step_size_in_bytes > 0) {
+        // A sized step processes the bytes its duration was estimated for,
+        // so that the estimate can be checked afterwards.
+        HistogramTimerScope incremental_marking_scope(
+            isolate_->counters()->gc_incremental_marking());
+        TRACE_EVENT0("v8", "V8.GCIncrementalMarking");
+        TRACE_GC(tracer(), GCTracer::Scope::MC_INCREMENTAL);
+        incremental_marking()->Step(
+            action.step_size_in_bytes,
+            IncrementalMarking::NO_GC_VIA_STACK_GUARD,
+            IncrementalMarking::FORCE_COMPLETION, StepOrigin::kTask);
+        result = incremental_marking()->IsStopped();
+        break;
+      }
       const double remaining_idle_time_in_ms =
           incremental_marking()->AdvanceIncrementalMarking(
               deadline_in_ms, IncrementalMarking::NO_GC_VIA_STACK_GUARD,
@@ -4388,6 +4722,45 @@ void Heap::IdleNotificationEpilogue(GCIdleTimeAction action,
         static_cast<int>(-deadline_difference));
   }
 
+  double used_time_in_ms = idle_time_in_ms - deadline_difference;
+  bool missed = gc_idle_time_handler_->RecordOutcome(action, idle_time_in_ms,
+                                                     used_time_in_ms);
+  if (missed) {
+    isolate()->counters()->gc_idle_time_prediction_misses()->Increment();
+  }
+
+  bool tracing_enabled = false;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("v8.gc.idle"),
+                                     &tracing_enabled);
+  if (tracing_enabled) {
+    std::unique_ptr<v8::tracing::TracedValue> value =
+        v8::tracing::TracedValue::Create();
+    value->SetInteger("action", action.type);
+    value->SetBoolean("finalize_marking", action.finalize_marking);
+    value->SetInteger("step_size_in_bytes",
+                      static_cast<int>(action.step_size_in_bytes));
+    value->SetDouble("idle_time_ms", idle_time_in_ms);
+    value->SetDouble("estimated_time_ms", action.estimated_time_in_ms);
+    value->SetDouble("used_time_ms", used_time_in_ms);
+    value->SetBoolean("missed", missed);
+    value->SetDouble("slack_factor",
+                     gc_idle_time_handler_->prediction_slack_factor());
+    value->SetInteger("predicted_actions",
+                      gc_idle_time_handler_->predicted_actions());
+    value->SetInteger("prediction_misses",
+                      gc_idle_time_handler_->prediction_misses());
+    value->SetDouble("marking_speed",
+                     heap_state.incremental_marking_speed_in_bytes_per_ms);
+    value->SetDouble(
+        "final_mark_compact_speed",
+        heap_state.final_incremental_mark_compact_speed_in_bytes_per_ms);
+    value->SetDouble("allocation_throughput",
+                     heap_state.allocation_throughput_in_bytes_per_ms);
+    TRACE_EVENT_INSTANT1(TRACE_DISABLED_BY_DEFAULT("v8.gc.idle"),
+                         "V8.GCIdleTimeAction", TRACE_EVENT_SCOPE_THREAD,
+                         "stats", std::move(value));
+  }
+
   if ((FLAG_trace_idle_notification && action.type > DO_NOTHING) ||
       FLAG_trace_idle_notification_verbose) {
     isolate_->PrintWithTimestamp(
@@ -4547,6 +4920,63 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
   }
 }
 
+void Heap::SampleSystemMemoryPressure() {
+  if (!FLAG_memory_pressure_from_system) return;
+  // Usage ratios of the cgroup memory limit.
+  const double kModerateUsageRatio = 0.85;
+  const double kCriticalUsageRatio = 0.95;
+  // Percentages of time in which some or all tasks were stalled on memory.
+  const double kModerateStallPercent = 10;
+  const double kCriticalStallPercent = 30;
+
+  double now = MonotonicallyIncreasingTimeInMs();
+  if (now < last_system_memory_pressure_sample_ms_ +
+                FLAG_memory_pressure_sample_interval) {
+    return;
+  }
+  last_system_memory_pressure_sample_ms_ = now;
+
+  MemoryPressureLevel level = MemoryPressureLevel::kNone;
+  uint64_t usage, limit;
+  if (base::OS::GetCgroupMemoryInfo(&usage, &limit)) {
+    system_memory_headroom_ =
+        static_cast<size_t>(Min<uint64_t>(usage < limit ? limit - usage : 0,
+                                          SIZE_MAX));
+    double ratio = static_cast<double>(usage) / limit;
+    if (ratio >= kCriticalUsageRatio) {
+      level = MemoryPressureLevel::kCritical;
+    } else if (ratio >= kModerateUsageRatio) {
+      level = MemoryPressureLevel::kModerate;
+    }
+  } else {
+    system_memory_headroom_ = SIZE_MAX;
+  }
+  double some_stall, full_stall;
+  if (base::OS::GetMemoryPressureStall(&some_stall, &full_stall)) {
+    if (full_stall >= kCriticalStallPercent) {
+      level = MemoryPressureLevel::kCritical;
+    } else if (some_stall >= kModerateStallPercent &&
+               level == MemoryPressureLevel::kNone) {
+      level = MemoryPressureLevel::kModerate;
+    }
+  }
+
+  MemoryPressureLevel previous = system_memory_pressure_level_;
+  system_memory_pressure_level_ = level;
+  if (FLAG_trace_gc_verbose && level != previous) {
+    isolate_->PrintWithTimestamp(
+        "System memory pressure: level %d, headroom %" PRIuS " KB\n",
+        static_cast<int>(level),
+        system_memory_headroom_ == SIZE_MAX ? 0 : system_memory_headroom_ / KB);
+  }
+  // Only rising levels are reported. A sustained level would otherwise
+  // trigger a memory reducing GC after every mark-compact, which resets the
+  // level of the heap.
+  if (level > previous) {
+    MemoryPressureNotification(level, false);
+  }
+}
+
 void Heap::SetOutOfMemoryCallback(v8::debug::OutOfMemoryCallback callback,
                                   void* data) {
   out_of_memory_callback_ = callback;
@@ -4819,7 +5249,9 @@ class IterateAndScavengePromotedObjectsVisitor final : public ObjectVisitor {
 
   inline void VisitPointers(Object** start, Object** end) override {
     Address slot_address = reinterpret_cast<Address>(start);
-    Page* page = Page::FromAddress(slot_address);
+    // Use the chunk of the target since slots of large objects may lie
+    // beyond the first page of their chunk.
+    MemoryChunk* page = MemoryChunk::FromAddress(target_->address());
 
     while (slot_address < reinterpret_cast<Address>(end)) {
       Object** slot = reinterpret_cast<Object**>(slot_address);
@@ -5083,6 +5515,9 @@ bool Heap::ConfigureHeap(size_t max_semi_space_size, size_t max_old_space_size,
     max_executable_size_ = static_cast<size_t>(FLAG_max_executable_size) * MB;
   }
 
+  // Picks up the heap growing flags.
+  ConfigureHeapGrowing(0, 0);
+
   if (Page::kPageSize > MB) {
     max_semi_space_size_ = ROUND_UP(max_semi_space_size_, Page::kPageSize);
     max_old_generation_size_ =
@@ -5182,6 +5617,24 @@ void Heap::GetFromRingBuffer(char* buffer) {
 
 bool Heap::ConfigureHeapDefault() { return ConfigureHeap(0, 0, 0, 0); }
 
+void Heap::ConfigureHeapGrowing(double gc_overhead_target,
+                                size_t heap_growing_cap) {
+  // Flags take precedence over the configuration of the embedder.
+  if (FLAG_gc_overhead_target_percent > 0) {
+    gc_overhead_target = FLAG_gc_overhead_target_percent / 100.0;
+  }
+  if (FLAG_heap_growing_cap > 0) {
+    heap_growing_cap = static_cast<size_t>(FLAG_heap_growing_cap);
+  }
+  if (gc_overhead_target > 0) {
+    CHECK_LT(gc_overhead_target, 1.0);
+    target_mutator_utilization_ = 1.0 - gc_overhead_target;
+  }
+  if (heap_growing_cap > 0) {
+    heap_growing_cap_ = heap_growing_cap * MB;
+  }
+}
+
 
 void Heap::RecordStats(HeapStats* stats, bool take_snapshot) {
   *stats->start_marker = HeapStats::kStartMarker;
@@ -5226,8 +5679,10 @@ void Heap::RecordStats(HeapStats* stats, bool take_snapshot) {
 }
 
 size_t Heap::PromotedSpaceSizeOfObjects() {
+  // Young large objects belong to the young generation.
   return old_space_->SizeOfObjects() + code_space_->SizeOfObjects() +
-         map_space_->SizeOfObjects() + lo_space_->SizeOfObjects();
+         map_space_->SizeOfObjects() + lo_space_->SizeOfObjects() -
+         lo_space_->SizeOfYoungObjects();
 }
 
 uint64_t Heap::PromotedExternalMemorySize() {
@@ -5243,6 +5698,7 @@ const double Heap::kMaxHeapGrowingFactorMemoryConstrained = 2.0;
 const double Heap::kMaxHeapGrowingFactorIdle = 1.5;
 const double Heap::kConservativeHeapGrowingFactor = 1.3;
 const double Heap::kTargetMutatorUtilization = 0.97;
+const double Heap::kMaxHeapGrowingFactorGCOverheadTarget = 8.0;
 
 // Given GC speed in bytes per ms, the allocation throughput in bytes per ms
 // (mutator speed), this function returns the heap growing factor that will
@@ -5284,22 +5740,39 @@ const double Heap::kTargetMutatorUtilization = 0.97;
 //   F * (R * (1 - MU) - MU) / (R * (1 - MU)) = 1
 //   F = R * (1 - MU) / (R * (1 - MU) - MU)
 double Heap::HeapGrowingFactor(double gc_speed, double mutator_speed) {
-  if (gc_speed == 0 || mutator_speed == 0) return kMaxHeapGrowingFactor;
+  return HeapGrowingFactor(gc_speed, mutator_speed, kTargetMutatorUtilization,
+                           kMaxHeapGrowingFactor);
+}
+
+double Heap::HeapGrowingFactor(double gc_speed, double mutator_speed,
+                               double target_mutator_utilization,
+                               double max_factor) {
+  if (gc_speed == 0 || mutator_speed == 0) return max_factor;
 
   const double speed_ratio = gc_speed / mutator_speed;
-  const double mu = kTargetMutatorUtilization;
+  const double mu = target_mutator_utilization;
 
   const double a = speed_ratio * (1 - mu);
   const double b = speed_ratio * (1 - mu) - mu;
 
   // The factor is a / b, but we need to check for small b first.
-  double factor =
-      (a < b * kMaxHeapGrowingFactor) ? a / b : kMaxHeapGrowingFactor;
-  factor = Min(factor, kMaxHeapGrowingFactor);
+  double factor = (a < b * max_factor) ? a / b : max_factor;
+  factor = Min(factor, max_factor);
   factor = Max(factor, kMinHeapGrowingFactor);
   return factor;
 }
 
+double Heap::ComputeHeapGrowingFactor(double gc_speed, double mutator_speed) {
+  if (target_mutator_utilization_ == 0) {
+    return HeapGrowingFactor(gc_speed, mutator_speed);
+  }
+  // With an explicit target the factor may grow beyond the default maximum,
+  // e.g., for throughput-oriented workers that accept large heaps.
+  return HeapGrowingFactor(gc_speed, mutator_speed,
+                           target_mutator_utilization_,
+                           kMaxHeapGrowingFactorGCOverheadTarget);
+}
+
 size_t Heap::CalculateOldGenerationAllocationLimit(double factor,
                                                    size_t old_gen_size) {
   CHECK(factor > 1.0);
@@ -5310,7 +5783,20 @@ size_t Heap::CalculateOldGenerationAllocationLimit(double factor,
   limit += new_space_->Capacity();
   uint64_t halfway_to_the_max =
       (static_cast<uint64_t>(old_gen_size) + max_old_generation_size_) / 2;
-  return static_cast<size_t>(Min(limit, halfway_to_the_max));
+  limit = Min(limit, halfway_to_the_max);
+  if (system_memory_headroom_ != SIZE_MAX) {
+    // Do not grow beyond half of the memory that is left in the container.
+    uint64_t halfway_to_the_container_limit =
+        static_cast<uint64_t>(old_gen_size) +
+        Max(system_memory_headroom_ / 2, MinimumAllocationLimitGrowingStep());
+    limit = Min(limit, halfway_to_the_container_limit);
+  }
+  if (heap_growing_cap_ > 0) {
+    limit = Min(limit, Max<uint64_t>(heap_growing_cap_,
+                                     static_cast<uint64_t>(old_gen_size) +
+                                         MinimumAllocationLimitGrowingStep()));
+  }
+  return static_cast<size_t>(limit);
 }
 
 size_t Heap::MinimumAllocationLimitGrowingStep() {
@@ -5324,22 +5810,27 @@ size_t Heap::MinimumAllocationLimitGrowingStep() {
 
 void Heap::SetOldGenerationAllocationLimit(size_t old_gen_size, double gc_speed,
                                            double mutator_speed) {
-  double factor = HeapGrowingFactor(gc_speed, mutator_speed);
+  double factor = ComputeHeapGrowingFactor(gc_speed, mutator_speed);
 
   if (FLAG_trace_gc_verbose) {
     isolate_->PrintWithTimestamp(
         "Heap growing factor %.1f based on mu=%.3f, speed_ratio=%.f "
         "(gc=%.f, mutator=%.f)\n",
-        factor, kTargetMutatorUtilization, gc_speed / mutator_speed, gc_speed,
-        mutator_speed);
+        factor,
+        target_mutator_utilization_ == 0 ? kTargetMutatorUtilization
+                                         : target_mutator_utilization_,
+        gc_speed / mutator_speed, gc_speed, mutator_speed);
   }
 
-  if (IsMemoryConstrainedDevice()) {
+  // The memory constrained device limit is part of the default heuristics.
+  // An explicit GC overhead target replaces it.
+  if (IsMemoryConstrainedDevice() && target_mutator_utilization_ == 0) {
     factor = Min(factor, kMaxHeapGrowingFactorMemoryConstrained);
   }
 
   if (memory_reducer_->ShouldGrowHeapSlowly() ||
-      ShouldOptimizeForMemoryUsage()) {
+      ShouldOptimizeForMemoryUsage() ||
+      system_memory_pressure_level_ != MemoryPressureLevel::kNone) {
     factor = Min(factor, kConservativeHeapGrowingFactor);
   }
 
@@ -5364,7 +5855,7 @@ void Heap::SetOldGenerationAllocationLimit(size_t old_gen_size, double gc_speed,
 void Heap::DampenOldGenerationAllocationLimit(size_t old_gen_size,
                                               double gc_speed,
                                               double mutator_speed) {
-  double factor = HeapGrowingFactor(gc_speed, mutator_speed);
+  double factor = ComputeHeapGrowingFactor(gc_speed, mutator_speed);
   size_t limit = CalculateOldGenerationAllocationLimit(factor, old_gen_size);
   if (limit < old_generation_allocation_limit_) {
     if (FLAG_trace_gc_verbose) {
@@ -5510,6 +6001,9 @@ bool Heap::SetUp() {
   // Initialize incremental marking.
   incremental_marking_ = new IncrementalMarking(this);
 
+  concurrent_marking_ = new ConcurrentMarking(this);
+  array_buffer_collector_ = new ArrayBufferCollector(this);
+
   for (int i = 0; i <= LAST_SPACE; i++) {
     space_[i] = nullptr;
   }
@@ -5557,12 +6051,13 @@ bool Heap::SetUp() {
   mark_compact_collector_ = new MarkCompactCollector(this);
   gc_idle_time_handler_ = new GCIdleTimeHandler();
   memory_reducer_ = new MemoryReducer(this);
+  memory_reducer_->UpdatePagePoolLimit();
   if (V8_UNLIKELY(FLAG_gc_stats)) {
     live_object_stats_ = new ObjectStats(this);
     dead_object_stats_ = new ObjectStats(this);
   }
   scavenge_job_ = new ScavengeJob();
-  local_embedder_heap_tracer_ = new LocalEmbedderHeapTracer();
+  local_embedder_heap_tracer_ = new LocalEmbedderHeapTracer(this);
 
   LOG(isolate_, IntPtrTEvent("heap-capacity", Capacity()));
   LOG(isolate_, IntPtrTEvent("heap-available", Available()));
@@ -5678,6 +6173,10 @@ void Heap::TearDown() {
     PrintAlloctionsHash();
   }
 
+  // Foreground tasks were canceled already. Backing stores that the spaces
+  // release below are freed synchronously by the collector's TearDown.
+  array_buffer_collector_->StartTearDown();
+
   new_space()->RemoveAllocationObserver(idle_scavenge_observer_);
   delete idle_scavenge_observer_;
   idle_scavenge_observer_ = nullptr;
@@ -5685,6 +6184,10 @@ void Heap::TearDown() {
   delete scavenge_collector_;
   scavenge_collector_ = nullptr;
 
+  // Stops running marking tasks before the marking deque goes away.
+  delete concurrent_marking_;
+  concurrent_marking_ = nullptr;
+
   if (mark_compact_collector_ != nullptr) {
     mark_compact_collector_->TearDown();
     delete mark_compact_collector_;
@@ -5751,6 +6254,12 @@ void Heap::TearDown() {
     lo_space_ = NULL;
   }
 
+  // Tearing down the spaces hands the remaining backing stores to the
+  // collector.
+  array_buffer_collector_->TearDown();
+  delete array_buffer_collector_;
+  array_buffer_collector_ = nullptr;
+
   store_buffer()->TearDown();
 
   memory_allocator()->TearDown();
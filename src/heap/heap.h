@@ -317,7 +317,9 @@ using v8::MemoryPressureLevel;
 
 // Forward declarations.
 class AllocationObserver;
+class ArrayBufferCollector;
 class ArrayBufferTracker;
+class ConcurrentMarking;
 class GCIdleTimeAction;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
@@ -563,7 +565,7 @@ class Heap {
 
   enum FindMementoMode { kForRuntime, kForGC };
 
-  enum HeapState { NOT_IN_GC, SCAVENGE, MARK_COMPACT };
+  enum HeapState { NOT_IN_GC, SCAVENGE, MARK_COMPACT, MINOR_MARK_COMPACT };
 
   enum UpdateAllocationSiteMode { kGlobal, kCached };
 
@@ -633,6 +635,7 @@ class Heap {
   static const double kMaxHeapGrowingFactorIdle;
   static const double kConservativeHeapGrowingFactor;
   static const double kTargetMutatorUtilization;
+  static const double kMaxHeapGrowingFactorGCOverheadTarget;
 
   static const int kNoGCFlags = 0;
   static const int kReduceMemoryFootprintMask = 1;
@@ -681,6 +684,7 @@ class Heap {
   static bool RootCanBeWrittenAfterInitialization(RootListIndex root_index);
 
   static bool IsUnmodifiedHeapObject(Object** p);
+  static bool IsUnscavengedHeapObject(Heap* heap, Object** p);
 
   // Zapping is needed for verify heap, and always done in debug builds.
   static inline bool ShouldZapGarbage() {
@@ -717,6 +721,11 @@ class Heap {
 
   V8_EXPORT_PRIVATE static double HeapGrowingFactor(double gc_speed,
                                                     double mutator_speed);
+  // Computes the growing factor for which the mutator utilization is the
+  // given target, bounded by the min and the given max growing factor.
+  V8_EXPORT_PRIVATE static double HeapGrowingFactor(
+      double gc_speed, double mutator_speed, double target_mutator_utilization,
+      double max_factor);
 
   // Copy block of memory from src to dst. Size of block should be aligned
   // by pointer size.
@@ -828,9 +837,10 @@ class Heap {
   inline bool IsInGCPostProcessing() { return gc_post_processing_depth_ > 0; }
 
   // If an object has an AllocationMemento trailing it, return it, otherwise
-  // return NULL;
+  // return NULL. The map is passed explicitly since the map word of the
+  // object may already be overwritten by a concurrent evacuation.
   template <FindMementoMode mode>
-  inline AllocationMemento* FindAllocationMemento(HeapObject* object);
+  inline AllocationMemento* FindAllocationMemento(Map* map, HeapObject* object);
 
   // Returns false if not able to reserve.
   bool ReserveSpace(Reservation* reservations, List<Address>* maps);
@@ -849,6 +859,12 @@ class Heap {
                                   bool is_isolate_locked);
   void CheckMemoryPressure();
 
+  // Derives a memory pressure level from the cgroup memory limit and the
+  // pressure stall information of the system (--memory_pressure_from_system)
+  // and notifies the heap when the level rises. Rate limited, so it is cheap
+  // to call often.
+  void SampleSystemMemoryPressure();
+
   void SetOutOfMemoryCallback(v8::debug::OutOfMemoryCallback callback,
                               void* data);
 
@@ -917,6 +933,12 @@ class Heap {
 
   inline bool DeoptMaybeTenuredAllocationSites();
 
+  // Pins or unpins the pretenuring decision of all allocation sites found in
+  // the feedback vector of |function|, including nested literal sites.
+  // Returns the number of sites that were updated.
+  int SetPretenuringMode(Handle<JSFunction> function,
+                         AllocationSite::PinnedMode mode);
+
   void AddWeakNewSpaceObjectToCodeDependency(Handle<HeapObject> obj,
                                              Handle<WeakCell> code);
 
@@ -995,6 +1017,13 @@ class Heap {
                      size_t max_executable_size, size_t code_range_size);
   bool ConfigureHeapDefault();
 
+  // Switches heap growing to the GC overhead target policy if
+  // |gc_overhead_target| is not zero. The old generation limit does not grow
+  // beyond |heap_growing_cap| MB if it is not zero. Can be called at any time
+  // and takes effect with the next limit computation.
+  void ConfigureHeapGrowing(double gc_overhead_target,
+                            size_t heap_growing_cap);
+
   // Prepares the heap, setting up memory areas that are needed in the isolate
   // without actually creating any objects.
   bool SetUp();
@@ -1238,6 +1267,12 @@ class Heap {
 
   IncrementalMarking* incremental_marking() { return incremental_marking_; }
 
+  ConcurrentMarking* concurrent_marking() { return concurrent_marking_; }
+
+  ArrayBufferCollector* array_buffer_collector() {
+    return array_buffer_collector_;
+  }
+
   // The runtime uses this function to notify potentially unsafe object layout
   // changes that require special synchronization with the concurrent marker.
   // A layout change is unsafe if
@@ -1392,11 +1427,17 @@ class Heap {
     return promoted_objects_size_ + semi_space_copied_object_size_;
   }
 
-  inline void IncrementNodesDiedInNewSpace() { nodes_died_in_new_space_++; }
+  inline void IncrementNodesDiedInNewSpace(int count = 1) {
+    nodes_died_in_new_space_ += count;
+  }
 
-  inline void IncrementNodesCopiedInNewSpace() { nodes_copied_in_new_space_++; }
+  inline void IncrementNodesCopiedInNewSpace(int count = 1) {
+    nodes_copied_in_new_space_ += count;
+  }
 
-  inline void IncrementNodesPromoted() { nodes_promoted_++; }
+  inline void IncrementNodesPromoted(int count = 1) {
+    nodes_promoted_ += count;
+  }
 
   inline void IncrementYoungSurvivorsCounter(size_t survived) {
     survived_last_scavenge_ = survived;
@@ -1492,7 +1533,7 @@ class Heap {
   // in the hash map is created. Otherwise the entry (including a the count
   // value) is cached on the local pretenuring feedback.
   template <UpdateAllocationSiteMode mode>
-  inline void UpdateAllocationSite(HeapObject* object,
+  inline void UpdateAllocationSite(Map* map, HeapObject* object,
                                    base::HashMap* pretenuring_feedback);
 
   // Removes an entry from the global pretenuring storage.
@@ -1772,6 +1813,10 @@ class Heap {
 
   void CollectGarbageOnMemoryPressure();
 
+  // Turns duplicates among the string deduplication candidates of the last
+  // mark-compact into ThinStrings referring to an internalized copy.
+  void DeduplicateStrings();
+
   void InvokeOutOfMemoryCallback();
 
   void ComputeFastPromotionMode(double survival_rate);
@@ -1821,6 +1866,10 @@ class Heap {
   void Scavenge();
   void EvacuateYoungGeneration();
 
+  // Moves all young large objects to the old generation and records their
+  // slots. Used by collectors that do not handle them individually.
+  void PromoteYoungLargeObjects();
+
   Address DoScavenge(ObjectVisitor* scavenge_visitor, Address new_space_front);
 
   void UpdateNewSpaceReferencesInExternalStringTable(
@@ -1894,6 +1943,9 @@ class Heap {
 
   size_t MinimumAllocationLimitGrowingStep();
 
+  // Returns the growing factor of the configured heap growing policy.
+  double ComputeHeapGrowingFactor(double gc_speed, double mutator_speed);
+
   size_t old_generation_allocation_limit() const {
     return old_generation_allocation_limit_;
   }
@@ -2175,6 +2227,13 @@ class Heap {
   // and reset by a mark-compact garbage collection.
   base::AtomicValue<MemoryPressureLevel> memory_pressure_level_;
 
+  // The memory pressure level and the remaining memory of the container as
+  // seen by the last SampleSystemMemoryPressure call. The headroom is
+  // SIZE_MAX if there is no known limit.
+  MemoryPressureLevel system_memory_pressure_level_;
+  size_t system_memory_headroom_;
+  double last_system_memory_pressure_sample_ms_;
+
   v8::debug::OutOfMemoryCallback out_of_memory_callback_;
   void* out_of_memory_callback_data_;
 
@@ -2231,6 +2290,13 @@ class Heap {
   // generation and on every allocation in large object space.
   size_t old_generation_allocation_limit_;
 
+  // The mutator utilization targeted by heap growing, or 0 for the default
+  // heuristics. See ConfigureHeapGrowing.
+  double target_mutator_utilization_;
+
+  // Soft cap for the old generation allocation limit, or 0 if there is none.
+  size_t heap_growing_cap_;
+
   // Indicates that inline bump-pointer allocation has been globally disabled
   // for all spaces. This is used to disable allocations in generated code.
   bool inline_allocation_disabled_;
@@ -2291,6 +2357,10 @@ class Heap {
 
   IncrementalMarking* incremental_marking_;
 
+  ConcurrentMarking* concurrent_marking_;
+
+  ArrayBufferCollector* array_buffer_collector_;
+
   GCIdleTimeHandler* gc_idle_time_handler_;
 
   MemoryReducer* memory_reducer_;
@@ -2388,6 +2458,7 @@ class Heap {
   friend class PagedSpace;
   friend class Scavenger;
   friend class StoreBuffer;
+  friend class StringDeduplicationTask;
   friend class TestMemoryAllocatorScope;
 
   // The allocator interface.
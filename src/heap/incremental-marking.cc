@@ -7,6 +7,7 @@
 #include "src/code-stubs.h"
 #include "src/compilation-cache.h"
 #include "src/conversions.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
@@ -32,6 +33,7 @@ IncrementalMarking::IncrementalMarking(Heap* heap)
       should_hurry_(false),
       was_activated_(false),
       black_allocation_(false),
+      code_and_map_black_allocation_(false),
       finalize_marking_completed_(false),
       trace_wrappers_toggle_(false),
       request_type_(NONE),
@@ -42,7 +44,11 @@ bool IncrementalMarking::BaseRecordWrite(HeapObject* obj, Object* value) {
   HeapObject* value_heap_obj = HeapObject::cast(value);
   DCHECK(!ObjectMarking::IsImpossible(value_heap_obj));
   DCHECK(!ObjectMarking::IsImpossible(obj));
-  const bool is_black = ObjectMarking::IsBlack(obj);
+  // The field was stored before. Pairs with the barrier in the concurrent
+  // marking visitor after blackening an object and before reading its
+  // fields.
+  if (FLAG_concurrent_marking) base::MemoryBarrier();
+  const bool is_black = ObjectMarking::IsBlack<MarkBit::ATOMIC>(obj);
 
   if (is_black && ObjectMarking::IsWhite(value_heap_obj)) {
     WhiteToGreyAndPush(value_heap_obj);
@@ -117,15 +123,16 @@ void IncrementalMarking::RecordWriteIntoCodeSlow(Code* host, RelocInfo* rinfo,
 }
 
 void IncrementalMarking::WhiteToGreyAndPush(HeapObject* obj) {
-  ObjectMarking::WhiteToGrey(obj);
-  heap_->mark_compact_collector()->marking_deque()->Push(obj);
+  if (ObjectMarking::WhiteToGrey<MarkBit::ATOMIC>(obj)) {
+    heap_->mark_compact_collector()->marking_deque()->Push(obj);
+  }
 }
 
 
 static void MarkObjectGreyDoNotEnqueue(Object* obj) {
   if (obj->IsHeapObject()) {
     HeapObject* heap_obj = HeapObject::cast(obj);
-    ObjectMarking::AnyToGrey(heap_obj);
+    ObjectMarking::AnyToGrey<MarkBit::ATOMIC>(heap_obj);
   }
 }
 
@@ -151,12 +158,12 @@ void IncrementalMarking::TransferMark(Heap* heap, HeapObject* from,
 #endif
 
   if (Marking::IsBlack(old_mark_bit)) {
-    Marking::BlackToWhite(old_mark_bit);
-    Marking::WhiteToBlack(new_mark_bit);
+    Marking::BlackToWhite<MarkBit::ATOMIC>(old_mark_bit);
+    Marking::WhiteToBlack<MarkBit::ATOMIC>(new_mark_bit);
     return;
   } else if (Marking::IsGrey(old_mark_bit)) {
-    Marking::GreyToWhite(old_mark_bit);
-    Marking::WhiteToGrey(new_mark_bit);
+    Marking::GreyToWhite<MarkBit::ATOMIC>(old_mark_bit);
+    Marking::WhiteToGrey<MarkBit::ATOMIC>(new_mark_bit);
     heap->mark_compact_collector()->marking_deque()->Push(to);
     heap->incremental_marking()->RestartIfNotMarking();
   }
@@ -261,8 +268,7 @@ class IncrementalMarkingMarkingVisitor
   INLINE(static bool MarkObjectWithoutPush(Heap* heap, Object* obj)) {
     HeapObject* heap_object = HeapObject::cast(obj);
     if (ObjectMarking::IsWhite(heap_object)) {
-      ObjectMarking::WhiteToBlack(heap_object);
-      return true;
+      return ObjectMarking::WhiteToBlack<MarkBit::ATOMIC>(heap_object);
     }
     return false;
   }
@@ -357,7 +363,11 @@ void IncrementalMarking::DeactivateIncrementalWriteBarrier() {
   DeactivateIncrementalWriteBarrierForSpace(heap_->new_space());
 
   for (LargePage* lop : *heap_->lo_space()) {
-    SetOldSpacePageFlags(lop, false, false);
+    if (lop->InNewSpace()) {
+      SetNewSpacePageFlags(lop, false);
+    } else {
+      SetOldSpacePageFlags(lop, false, false);
+    }
   }
 }
 
@@ -383,7 +393,11 @@ void IncrementalMarking::ActivateIncrementalWriteBarrier() {
   ActivateIncrementalWriteBarrier(heap_->new_space());
 
   for (LargePage* lop : *heap_->lo_space()) {
-    SetOldSpacePageFlags(lop, true, is_compacting_);
+    if (lop->InNewSpace()) {
+      SetNewSpacePageFlags(lop, true);
+    } else {
+      SetOldSpacePageFlags(lop, true, is_compacting_);
+    }
   }
 }
 
@@ -547,6 +561,15 @@ void IncrementalMarking::StartMarking() {
   IncrementalMarkingRootMarkingVisitor visitor(this);
   heap_->IterateStrongRoots(&visitor, VISIT_ONLY_STRONG);
 
+  heap_->concurrent_marking()->ScheduleTasks();
+
+  // Code and map space objects rarely die in the cycle that allocated them
+  // but are expensive to visit, so they are allocated black right away.
+  if (FLAG_black_allocation && FLAG_early_code_and_map_black_allocation &&
+      !heap()->ShouldReduceMemory()) {
+    StartCodeAndMapBlackAllocation();
+  }
+
   // Ready to start incremental marking.
   if (FLAG_trace_incremental_marking) {
     heap()->isolate()->PrintWithTimestamp("[IncrementalMarking] Running\n");
@@ -558,15 +581,32 @@ void IncrementalMarking::StartBlackAllocation() {
   DCHECK(IsMarking());
   black_allocation_ = true;
   heap()->old_space()->MarkAllocationInfoBlack();
+  if (!code_and_map_black_allocation_) {
+    heap()->map_space()->MarkAllocationInfoBlack();
+    heap()->code_space()->MarkAllocationInfoBlack();
+  }
+  if (FLAG_trace_incremental_marking) {
+    heap()->isolate()->PrintWithTimestamp(
+        "[IncrementalMarking] Black allocation started\n");
+  }
+}
+
+void IncrementalMarking::StartCodeAndMapBlackAllocation() {
+  DCHECK(FLAG_black_allocation);
+  DCHECK(IsMarking());
+  DCHECK(!black_allocation_);
+  code_and_map_black_allocation_ = true;
   heap()->map_space()->MarkAllocationInfoBlack();
   heap()->code_space()->MarkAllocationInfoBlack();
   if (FLAG_trace_incremental_marking) {
     heap()->isolate()->PrintWithTimestamp(
-        "[IncrementalMarking] Black allocation started\n");
+        "[IncrementalMarking] Black allocation started for code and map "
+        "space\n");
   }
 }
 
 void IncrementalMarking::FinishBlackAllocation() {
+  code_and_map_black_allocation_ = false;
   if (black_allocation_) {
     black_allocation_ = false;
     if (FLAG_trace_incremental_marking) {
@@ -715,6 +755,10 @@ void IncrementalMarking::FinalizeIncrementally() {
 
   double start = heap_->MonotonicallyIncreasingTimeInMs();
 
+  // Weak references are processed below based on the current marking state,
+  // which must not change concurrently.
+  heap_->concurrent_marking()->EnsureCompleted();
+
   int old_marking_deque_top =
       heap_->mark_compact_collector()->marking_deque()->top();
 
@@ -829,7 +873,7 @@ void IncrementalMarking::VisitObject(Map* map, HeapObject* obj, int size) {
 #if ENABLE_SLOW_DCHECKS
   MarkBit mark_bit = ObjectMarking::MarkBitFrom(obj);
   MemoryChunk* chunk = MemoryChunk::FromAddress(obj->address());
-  SLOW_DCHECK(Marking::IsGrey(mark_bit) ||
+  SLOW_DCHECK(Marking::IsGrey(mark_bit) || FLAG_concurrent_marking ||
               (obj->IsFiller() && Marking::IsWhite(mark_bit)) ||
               (chunk->IsFlagSet(MemoryChunk::HAS_PROGRESS_BAR) &&
                Marking::IsBlack(mark_bit)));
@@ -845,7 +889,7 @@ void IncrementalMarking::MarkGrey(Heap* heap, HeapObject* object) {
 
 void IncrementalMarking::MarkBlack(HeapObject* obj, int size) {
   if (ObjectMarking::IsBlack(obj)) return;
-  ObjectMarking::GreyToBlack(obj);
+  ObjectMarking::GreyToBlack<MarkBit::ATOMIC>(obj);
 }
 
 intptr_t IncrementalMarking::ProcessMarkingDeque(
@@ -880,6 +924,7 @@ intptr_t IncrementalMarking::ProcessMarkingDeque(
 
 
 void IncrementalMarking::Hurry() {
+  heap_->concurrent_marking()->EnsureCompleted();
   // A scavenge may have pushed new objects on the marking deque (due to black
   // allocation) even in COMPLETE state. This may happen if scavenges are
   // forced e.g. in tests. It should not happen when COMPLETE was set when
@@ -915,9 +960,8 @@ void IncrementalMarking::Hurry() {
     HeapObject* cache = HeapObject::cast(
         Context::cast(context)->get(Context::NORMALIZED_MAP_CACHE_INDEX));
     if (!cache->IsUndefined(heap_->isolate())) {
-      if (ObjectMarking::IsGrey(cache)) {
-        ObjectMarking::GreyToBlack(cache);
-      }
+      // Fails if the cache is not grey.
+      ObjectMarking::GreyToBlack<MarkBit::ATOMIC>(cache);
     }
     context = Context::cast(context)->next_context_link();
   }
@@ -926,6 +970,7 @@ void IncrementalMarking::Hurry() {
 
 void IncrementalMarking::Stop() {
   if (IsStopped()) return;
+  heap_->concurrent_marking()->EnsureCompleted();
   if (FLAG_trace_incremental_marking) {
     int old_generation_size_mb =
         static_cast<int>(heap()->PromotedSpaceSizeOfObjects() / MB);
@@ -1141,12 +1186,16 @@ size_t IncrementalMarking::Step(size_t bytes_to_process,
 
   size_t bytes_processed = 0;
   if (state_ == MARKING) {
+    ConcurrentMarking* concurrent_marking = heap_->concurrent_marking();
+    concurrent_marking->FlushBailoutToMarkingDeque();
     bytes_processed = ProcessMarkingDeque(bytes_to_process);
     if (step_origin == StepOrigin::kTask) {
       bytes_marked_ahead_of_schedule_ += bytes_processed;
     }
+    concurrent_marking->ScheduleTasks();
 
-    if (heap_->mark_compact_collector()->marking_deque()->IsEmpty()) {
+    if (heap_->mark_compact_collector()->marking_deque()->IsEmpty() &&
+        !concurrent_marking->IsRunning()) {
       if (heap_->local_embedder_heap_tracer()
               ->ShouldFinalizeIncrementalMarking()) {
         if (completion == FORCE_COMPLETION ||
@@ -163,7 +163,7 @@ class V8_EXPORT_PRIVATE IncrementalMarking {
     SetOldSpacePageFlags(chunk, IsMarking(), IsCompacting());
   }
 
-  inline void SetNewSpacePageFlags(Page* chunk) {
+  inline void SetNewSpacePageFlags(MemoryChunk* chunk) {
     SetNewSpacePageFlags(chunk, IsMarking());
   }
 
@@ -217,6 +217,14 @@ class V8_EXPORT_PRIVATE IncrementalMarking {
 
   bool black_allocation() { return black_allocation_; }
 
+  // Returns true if objects allocated in the given space are marked black.
+  // Code and map space may allocate black before the other spaces.
+  bool black_allocation_in(AllocationSpace space) {
+    return black_allocation_ ||
+           (code_and_map_black_allocation_ &&
+            (space == CODE_SPACE || space == MAP_SPACE));
+  }
+
   void StartBlackAllocationForTesting() { StartBlackAllocation(); }
 
   void AbortBlackAllocation();
@@ -241,6 +249,7 @@ class V8_EXPORT_PRIVATE IncrementalMarking {
   void StartMarking();
 
   void StartBlackAllocation();
+  void StartCodeAndMapBlackAllocation();
   void FinishBlackAllocation();
 
   void MarkRoots();
@@ -296,6 +305,7 @@ class V8_EXPORT_PRIVATE IncrementalMarking {
   bool should_hurry_;
   bool was_activated_;
   bool black_allocation_;
+  bool code_and_map_black_allocation_;
   bool finalize_marking_completed_;
   bool trace_wrappers_toggle_;
 
@@ -0,0 +1,141 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_LOCAL_ALLOCATOR_H_
+#define V8_HEAP_LOCAL_ALLOCATOR_H_
+
+#include "src/globals.h"
+#include "src/heap/heap.h"
+#include "src/heap/spaces.h"
+
+namespace v8 {
+namespace internal {
+
+// Allocator encapsulating thread-local allocation during a garbage
+// collection. New space allocations are served from a linear allocation
+// buffer that is refilled from the shared new space under its mutex, old
+// space allocations go to a private compaction space. A LocalAllocator must
+// only be used by a single task at a time.
+class LocalAllocator {
+ public:
+  static const int kLabSize = 32 * KB;
+  static const int kMaxLabObjectSize = 8 * KB;
+
+  explicit LocalAllocator(Heap* heap)
+      : heap_(heap),
+        new_space_(heap->new_space()),
+        compaction_spaces_(heap),
+        new_space_lab_(LocalAllocationBuffer::InvalidBuffer()),
+        lab_allocation_will_fail_(false) {}
+
+  // Needs to be called from the main thread to finalize this LocalAllocator.
+  void Finalize() {
+    heap_->old_space()->MergeCompactionSpace(compaction_spaces_.Get(OLD_SPACE));
+    // Closing the LAB fills its unused part with a filler object.
+    new_space_lab_ = LocalAllocationBuffer::InvalidBuffer();
+  }
+
+  inline AllocationResult Allocate(AllocationSpace space, int object_size,
+                                   AllocationAlignment alignment) {
+    switch (space) {
+      case NEW_SPACE:
+        return AllocateInNewSpace(object_size, alignment);
+      case OLD_SPACE:
+        return compaction_spaces_.Get(OLD_SPACE)->AllocateRaw(object_size,
+                                                              alignment);
+      default:
+        // Only new and old space supported.
+        UNREACHABLE();
+        break;
+    }
+    return AllocationResult::Retry(space);
+  }
+
+  // Gives back an object that was allocated last through this allocator,
+  // e.g., because another task won the race for copying the same object.
+  inline void FreeLast(AllocationSpace space, HeapObject* object,
+                       int object_size) {
+    switch (space) {
+      case NEW_SPACE:
+        FreeLastInNewSpace(object, object_size);
+        return;
+      case OLD_SPACE:
+        FreeLastInOldSpace(object, object_size);
+        return;
+      default:
+        // Only new and old space supported.
+        UNREACHABLE();
+        break;
+    }
+  }
+
+ private:
+  inline AllocationResult AllocateInNewSpace(int object_size,
+                                             AllocationAlignment alignment) {
+    if (object_size > kMaxLabObjectSize) {
+      return new_space_->AllocateRawSynchronized(object_size, alignment);
+    }
+    return AllocateInLAB(object_size, alignment);
+  }
+
+  inline bool NewLocalAllocationBuffer() {
+    if (lab_allocation_will_fail_) return false;
+    LocalAllocationBuffer saved_lab = new_space_lab_;
+    AllocationResult result =
+        new_space_->AllocateRawSynchronized(kLabSize, kWordAligned);
+    new_space_lab_ = LocalAllocationBuffer::FromResult(heap_, result, kLabSize);
+    if (new_space_lab_.IsValid()) {
+      new_space_lab_.TryMerge(&saved_lab);
+      return true;
+    }
+    lab_allocation_will_fail_ = true;
+    return false;
+  }
+
+  inline AllocationResult AllocateInLAB(int object_size,
+                                        AllocationAlignment alignment) {
+    AllocationResult allocation;
+    if (!new_space_lab_.IsValid() && !NewLocalAllocationBuffer()) {
+      return AllocationResult::Retry(OLD_SPACE);
+    }
+    allocation = new_space_lab_.AllocateRawAligned(object_size, alignment);
+    if (allocation.IsRetry()) {
+      if (!NewLocalAllocationBuffer()) {
+        return AllocationResult::Retry(OLD_SPACE);
+      } else {
+        allocation = new_space_lab_.AllocateRawAligned(object_size, alignment);
+        CHECK(!allocation.IsRetry());
+      }
+    }
+    return allocation;
+  }
+
+  inline void FreeLastInNewSpace(HeapObject* object, int object_size) {
+    if (!new_space_lab_.TryFreeLast(object, object_size)) {
+      // We couldn't free the last object so we have to write a proper filler.
+      heap_->CreateFillerObjectAt(object->address(), object_size,
+                                  ClearRecordedSlots::kNo);
+    }
+  }
+
+  inline void FreeLastInOldSpace(HeapObject* object, int object_size) {
+    // The compaction space does not support giving back memory, so the object
+    // is turned into a filler. No slots have been recorded for it yet.
+    heap_->CreateFillerObjectAt(object->address(), object_size,
+                                ClearRecordedSlots::kNo);
+  }
+
+  Heap* const heap_;
+  NewSpace* const new_space_;
+  CompactionSpaceCollection compaction_spaces_;
+  LocalAllocationBuffer new_space_lab_;
+  bool lab_allocation_will_fail_;
+
+  DISALLOW_COPY_AND_ASSIGN(LocalAllocator);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_LOCAL_ALLOCATOR_H_
@@ -12,24 +12,25 @@
 namespace v8 {
 namespace internal {
 
+// Mark bit transitions on the main thread are atomic since concurrent
+// marking tasks may change the colors of other objects in the same cell.
 void MarkCompactCollector::PushBlack(HeapObject* obj) {
-  DCHECK(ObjectMarking::IsBlack(obj));
+  DCHECK(ObjectMarking::IsBlack<MarkBit::ATOMIC>(obj));
   if (!marking_deque()->Push(obj)) {
-    ObjectMarking::BlackToGrey(obj);
+    ObjectMarking::BlackToGrey<MarkBit::ATOMIC>(obj);
   }
 }
 
 
 void MarkCompactCollector::UnshiftBlack(HeapObject* obj) {
-  DCHECK(ObjectMarking::IsBlack(obj));
+  DCHECK(ObjectMarking::IsBlack<MarkBit::ATOMIC>(obj));
   if (!marking_deque()->Unshift(obj)) {
-    ObjectMarking::BlackToGrey(obj);
+    ObjectMarking::BlackToGrey<MarkBit::ATOMIC>(obj);
   }
 }
 
 void MarkCompactCollector::MarkObject(HeapObject* obj) {
-  if (ObjectMarking::IsWhite(obj)) {
-    ObjectMarking::WhiteToBlack(obj);
+  if (ObjectMarking::WhiteToBlack<MarkBit::ATOMIC>(obj)) {
     PushBlack(obj);
   }
 }
@@ -55,6 +56,11 @@ void CodeFlusher::AddCandidate(SharedFunctionInfo* shared_info) {
 }
 
 
+void CodeFlusher::AddBytecodeCandidate(SharedFunctionInfo* shared_info) {
+  bytecode_candidates_.push_back(shared_info);
+}
+
+
 void CodeFlusher::AddCandidate(JSFunction* function) {
   DCHECK(function->code() == function->shared()->code());
   if (function->next_function_link()->IsUndefined(isolate_)) {
@@ -61,7 +61,8 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       have_code_to_deoptimize_(false),
       marking_deque_(heap),
       code_flusher_(nullptr),
-      sweeper_(heap) {
+      sweeper_(heap),
+      string_deduplication_ms_count_(0) {
 }
 
 #ifdef VERIFY_HEAP
@@ -306,6 +307,8 @@ void MarkCompactCollector::CollectGarbage() {
 
   RecordObjectStats();
 
+  CollectStringDeduplicationCandidates();
+
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap) {
     VerifyMarking(heap_);
@@ -319,6 +322,38 @@ void MarkCompactCollector::CollectGarbage() {
   Finish();
 }
 
+void MarkCompactCollector::CollectGarbageInYoungGeneration() {
+  DCHECK(FLAG_minor_mc);
+  DCHECK(heap()->incremental_marking()->IsStopped());
+  DCHECK(!is_compacting());
+
+  // Promoted pages are handed to the sweeper, which requires that no
+  // sweeper tasks are running.
+  EnsureSweepingCompleted();
+  heap()->memory_allocator()->unmapper()->WaitUntilCompleted();
+
+#ifdef VERIFY_HEAP
+  if (FLAG_verify_heap) {
+    VerifyMarkbitsAreClean();
+  }
+#endif
+
+  MarkLiveObjectsInYoungGeneration();
+
+  ClearNonLiveReferencesInYoungGeneration();
+
+  // Only pages that are promoted during evacuation are swept.
+  sweeper().StartSweeping();
+
+  EvacuateNewSpaceAndCandidates();
+
+  if (!heap()->delay_sweeper_tasks_for_testing_) {
+    sweeper().StartSweeperTasks();
+  }
+
+  heap_->isolate()->inner_pointer_to_code_cache()->Flush();
+}
+
 #ifdef VERIFY_HEAP
 void MarkCompactCollector::VerifyMarkbitsAreClean(PagedSpace* space) {
   for (Page* p : *space) {
@@ -894,6 +929,7 @@ void CodeFlusher::ProcessJSFunctionCandidates() {
   Code* interpreter_entry_trampoline =
       isolate_->builtins()->builtin(Builtins::kInterpreterEntryTrampoline);
   Object* undefined = isolate_->heap()->undefined_value();
+  Counters* counters = isolate_->counters();
 
   JSFunction* candidate = jsfunction_candidates_head_;
   JSFunction* next_candidate;
@@ -910,6 +946,8 @@ void CodeFlusher::ProcessJSFunctionCandidates() {
         shared->ShortPrint();
         PrintF(" - age: %d]\n", code->GetAge());
       }
+      counters->code_flushing_flushed_functions()->Increment();
+      counters->code_flushing_flushed_code_bytes()->Increment(code->Size());
       // Always flush the optimized code map if there is one.
       if (!shared->OptimizedCodeMapIsCleared()) {
         shared->ClearOptimizedCodeMap();
@@ -926,6 +964,20 @@ void CodeFlusher::ProcessJSFunctionCandidates() {
       candidate->set_code(code);
     }
 
+    // The feedback of a function whose code was flushed is dropped as well
+    // and is recreated once the function is compiled again. The cell is
+    // shared with all closures of the same function literal, which are
+    // flushed together since they share the code.
+    if (FLAG_flush_bytecode && candidate->code() == lazy_compile) {
+      Cell* cell = candidate->feedback_vector_cell();
+      if (cell != isolate_->heap()->undefined_cell() &&
+          cell->value()->IsFeedbackVector()) {
+        counters->code_flushing_flushed_feedback_vector_bytes()->Increment(
+            HeapObject::cast(cell->value())->Size());
+        cell->set_value(undefined, SKIP_WRITE_BARRIER);
+      }
+    }
+
     // We are in the middle of a GC cycle so the write barrier in the code
     // setter did not record the slot update and we have to do that manually.
     Address slot = candidate->address() + JSFunction::kCodeEntryOffset;
@@ -949,6 +1001,7 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
   Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kCompileLazy);
   Code* interpreter_entry_trampoline =
       isolate_->builtins()->builtin(Builtins::kInterpreterEntryTrampoline);
+  Counters* counters = isolate_->counters();
   SharedFunctionInfo* candidate = shared_function_info_candidates_head_;
   SharedFunctionInfo* next_candidate;
   while (candidate != NULL) {
@@ -962,6 +1015,8 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
         candidate->ShortPrint();
         PrintF(" - age: %d]\n", code->GetAge());
       }
+      counters->code_flushing_flushed_functions()->Increment();
+      counters->code_flushing_flushed_code_bytes()->Increment(code->Size());
       // Always flush the optimized code map if there is one.
       if (!candidate->OptimizedCodeMapIsCleared()) {
         candidate->ClearOptimizedCodeMap();
@@ -985,6 +1040,105 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
 }
 
 
+bool CodeFlusher::CanFlushBytecode(Isolate* isolate,
+                                   SharedFunctionInfo* shared_info) {
+  if (!shared_info->HasBytecodeArray()) return false;
+
+  // Functions that were tiered up to baseline or optimized code may still
+  // deoptimize to the bytecode.
+  if (shared_info->code() != isolate->builtins()->builtin(
+                                 Builtins::kInterpreterEntryTrampoline) ||
+      !shared_info->OptimizedCodeMapIsCleared()) {
+    return false;
+  }
+
+  // The source code must be available to recompile the function.
+  Object* undefined = isolate->heap()->undefined_value();
+  if (shared_info->script() == undefined ||
+      Script::cast(shared_info->script())->source() == undefined) {
+    return false;
+  }
+
+  // The remaining conditions match the ones for flushing unoptimized code,
+  // see StaticMarkingVisitor::IsFlushable.
+  return shared_info->allows_lazy_compilation() &&
+         !IsResumableFunction(shared_info->kind()) &&
+         !shared_info->is_toplevel() && shared_info->IsUserJavaScript() &&
+         !shared_info->HasDebugInfo() && !shared_info->dont_flush();
+}
+
+
+void CodeFlusher::RetainIneligibleBytecodeCandidates() {
+  MarkCompactCollector* collector = isolate_->heap()->mark_compact_collector();
+  for (SharedFunctionInfo* candidate : bytecode_candidates_) {
+    if (!ObjectMarking::IsBlack(candidate) || !candidate->HasBytecodeArray()) {
+      continue;
+    }
+    // The interpreter entry trampoline resets the age of bytecode that ran
+    // since the candidate was recorded.
+    BytecodeArray* bytecode = candidate->bytecode_array();
+    if (bytecode->bytecode_age() < FLAG_bytecode_flush_age ||
+        !CanFlushBytecode(isolate_, candidate)) {
+      collector->MarkObject(bytecode);
+    }
+  }
+}
+
+
+void CodeFlusher::ProcessBytecodeCandidates() {
+  Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kCompileLazy);
+  Counters* counters = isolate_->counters();
+  MarkCompactCollector* collector = isolate_->heap()->mark_compact_collector();
+  for (SharedFunctionInfo* candidate : bytecode_candidates_) {
+    // Duplicate entries have been processed already. Candidates that are
+    // not marked were recorded before incremental marking got aborted.
+    if (!ObjectMarking::IsBlack(candidate) || !candidate->HasBytecodeArray()) {
+      continue;
+    }
+    BytecodeArray* bytecode = candidate->bytecode_array();
+    if (ObjectMarking::IsWhite(bytecode)) {
+      DCHECK(CanFlushBytecode(isolate_, candidate));
+      if (FLAG_trace_code_flushing) {
+        PrintF("[code-flushing clears bytecode: ");
+        candidate->ShortPrint();
+        PrintF(" - age: %d]\n", bytecode->bytecode_age());
+      }
+      counters->code_flushing_flushed_functions()->Increment();
+      counters->code_flushing_flushed_bytecode_bytes()->Increment(
+          bytecode->Size());
+      candidate->ClearBytecodeArray();
+      candidate->set_code(lazy_compile);
+      Object** code_slot =
+          HeapObject::RawField(candidate, SharedFunctionInfo::kCodeOffset);
+      collector->RecordSlot(candidate, code_slot, *code_slot);
+    } else {
+      // The function data field was skipped during marking.
+      Object** data_slot = HeapObject::RawField(
+          candidate, SharedFunctionInfo::kFunctionDataOffset);
+      collector->RecordSlot(candidate, data_slot, *data_slot);
+    }
+  }
+  bytecode_candidates_.clear();
+}
+
+
+
+void MarkCompactCollector::RecordBlackAllocatedClosure(JSFunction* function) {
+  if (!heap()->incremental_marking()->black_allocation()) return;
+  if (!is_code_flushing_enabled() || !FLAG_flush_bytecode) return;
+  if (!ObjectMarking::IsBlack(function)) return;
+  Code* code = function->code();
+  if (code != isolate()->builtins()->builtin(
+                  Builtins::kInterpreterEntryTrampoline) ||
+      code != function->shared()->code()) {
+    return;
+  }
+  // Flushing the bytecode resets the code of function candidates, which are
+  // processed after the bytecode candidates.
+  code_flusher()->AddCandidate(function);
+}
+
+
 void CodeFlusher::EvictCandidate(SharedFunctionInfo* shared_info) {
   // Make sure previous flushing decisions are revisited.
   isolate_->heap()->incremental_marking()->IterateBlackObject(shared_info);
@@ -1070,33 +1224,6 @@ void CodeFlusher::IteratePointersToFromSpace(ObjectVisitor* v) {
   }
 }
 
-class StaticYoungGenerationMarkingVisitor
-    : public StaticNewSpaceVisitor<StaticYoungGenerationMarkingVisitor> {
- public:
-  static void Initialize(Heap* heap) {
-    StaticNewSpaceVisitor<StaticYoungGenerationMarkingVisitor>::Initialize();
-  }
-
-  inline static void VisitPointer(Heap* heap, HeapObject* object, Object** p) {
-    Object* target = *p;
-    if (heap->InNewSpace(target)) {
-      if (MarkRecursively(heap, HeapObject::cast(target))) return;
-      heap->mark_compact_collector()->MarkObject(HeapObject::cast(target));
-    }
-  }
-
- protected:
-  inline static bool MarkRecursively(Heap* heap, HeapObject* object) {
-    StackLimitCheck check(heap->isolate());
-    if (check.HasOverflowed()) return false;
-
-    if (ObjectMarking::IsBlackOrGrey(object)) return true;
-    ObjectMarking::WhiteToBlack(object);
-    IterateBody(object->map(), object);
-    return true;
-  }
-};
-
 class MarkCompactMarkingVisitor
     : public StaticMarkingVisitor<MarkCompactMarkingVisitor> {
  public:
@@ -1293,6 +1420,9 @@ class SharedFunctionInfoMarkingVisitor : public ObjectVisitor {
     if (obj->IsSharedFunctionInfo()) {
       SharedFunctionInfo* shared = reinterpret_cast<SharedFunctionInfo*>(obj);
       collector_->MarkObject(shared->code());
+      if (shared->HasBytecodeArray()) {
+        collector_->MarkObject(shared->bytecode_array());
+      }
       collector_->MarkObject(shared);
     }
   }
@@ -1315,7 +1445,43 @@ void MarkCompactCollector::PrepareThreadForCodeFlushing(Isolate* isolate,
     if (frame->is_optimized()) {
       Code* optimized_code = frame->LookupCode();
       MarkObject(optimized_code);
+      if (FLAG_flush_bytecode &&
+          optimized_code->kind() == Code::OPTIMIZED_FUNCTION) {
+        MarkInlinedBytecode(optimized_code);
+      }
+    }
+  }
+}
+
+
+void MarkCompactCollector::MarkInlinedBytecode(Code* code) {
+  DCHECK_EQ(Code::OPTIMIZED_FUNCTION, code->kind());
+  FixedArray* raw_data = code->deoptimization_data();
+  if (raw_data->length() == 0) return;
+  DeoptimizationInputData* data = DeoptimizationInputData::cast(raw_data);
+  int count = data->InlinedFunctionCount()->value();
+  for (int i = DeoptimizationInputData::kNotInlinedIndex; i < count; i++) {
+    SharedFunctionInfo* shared = data->GetInlinedFunction(i);
+    if (shared->HasBytecodeArray()) {
+      MarkObject(shared->bytecode_array());
+    }
+  }
+}
+
+
+void MarkCompactCollector::MarkBytecodeOfLiveOptimizedCode() {
+  Object* context = heap()->native_contexts_list();
+  while (!context->IsUndefined(isolate())) {
+    Context* native_context = Context::cast(context);
+    Object* element = native_context->get(Context::OPTIMIZED_CODE_LIST);
+    while (!element->IsUndefined(isolate())) {
+      Code* code = Code::cast(element);
+      if (ObjectMarking::IsBlack(code)) {
+        MarkInlinedBytecode(code);
+      }
+      element = code->next_code_link();
     }
+    context = native_context->next_context_link();
   }
 }
 
@@ -1339,12 +1505,16 @@ void MarkCompactCollector::PrepareForCodeFlushing() {
   heap()->isolate()->compilation_cache()->IterateFunctions(&visitor);
   heap()->isolate()->handle_scope_implementer()->Iterate(&visitor);
 
-  ProcessMarkingDeque<MarkCompactMode::FULL>();
+  if (FLAG_flush_bytecode) {
+    code_flusher_->RetainIneligibleBytecodeCandidates();
+    MarkBytecodeOfLiveOptimizedCode();
+  }
+
+  ProcessMarkingDeque();
 }
 
 
 // Visitor class for marking heap roots.
-template <MarkCompactMode mode>
 class RootMarkingVisitor : public ObjectVisitor {
  public:
   explicit RootMarkingVisitor(Heap* heap)
@@ -1366,30 +1536,19 @@ class RootMarkingVisitor : public ObjectVisitor {
 
     HeapObject* object = HeapObject::cast(*p);
 
-    if (mode == MarkCompactMode::YOUNG_GENERATION &&
-        !collector_->heap()->InNewSpace(object))
-      return;
-
     if (ObjectMarking::IsBlackOrGrey(object)) return;
 
     Map* map = object->map();
     // Mark the object.
     ObjectMarking::WhiteToBlack(object);
 
-    switch (mode) {
-      case MarkCompactMode::FULL: {
-        // Mark the map pointer and body, and push them on the marking stack.
-        collector_->MarkObject(map);
-        MarkCompactMarkingVisitor::IterateBody(map, object);
-      } break;
-      case MarkCompactMode::YOUNG_GENERATION:
-        StaticYoungGenerationMarkingVisitor::IterateBody(map, object);
-        break;
-    }
+    // Mark the map pointer and body, and push them on the marking stack.
+    collector_->MarkObject(map);
+    MarkCompactMarkingVisitor::IterateBody(map, object);
 
     // Mark all the objects reachable from the map and body.  May leave
     // overflowed objects in the heap.
-    collector_->EmptyMarkingDeque<mode>();
+    collector_->EmptyMarkingDeque();
   }
 
   MarkCompactCollector* collector_;
@@ -1446,6 +1605,21 @@ class StringTableCleaner : public ObjectVisitor {
 
 typedef StringTableCleaner<false, true> InternalizedStringTableCleaner;
 typedef StringTableCleaner<true, false> ExternalStringTableCleaner;
+// Implementation of WeakObjectRetainer for young generation mark compact GCs.
+// Objects outside of the young generation are retained unconditionally.
+class MinorMarkCompactWeakObjectRetainer : public WeakObjectRetainer {
+ public:
+  explicit MinorMarkCompactWeakObjectRetainer(Heap* heap) : heap_(heap) {}
+
+  virtual Object* RetainAs(Object* object) {
+    if (!heap_->InNewSpace(object)) return object;
+    if (ObjectMarking::IsBlack(HeapObject::cast(object))) return object;
+    return NULL;
+  }
+
+ private:
+  Heap* heap_;
+};
 
 // Implementation of WeakObjectRetainer for mark compact GCs. All marked objects
 // are retained.
@@ -1722,7 +1896,7 @@ class MarkCompactCollector::EvacuateNewSpaceVisitor final
         local_pretenuring_feedback_(local_pretenuring_feedback) {}
 
   inline bool Visit(HeapObject* object) override {
-    heap_->UpdateAllocationSite<Heap::kCached>(object,
+    heap_->UpdateAllocationSite<Heap::kCached>(object->map(), object,
                                                local_pretenuring_feedback_);
     int size = object->Size();
     HeapObject* target_object = nullptr;
@@ -1873,7 +2047,7 @@ class MarkCompactCollector::EvacuateNewSpacePageVisitor final
   }
 
   inline bool Visit(HeapObject* object) {
-    heap_->UpdateAllocationSite<Heap::kCached>(object,
+    heap_->UpdateAllocationSite<Heap::kCached>(object->map(), object,
                                                local_pretenuring_feedback_);
     if (mode == NEW_TO_OLD) {
       RecordMigratedSlotVisitor visitor(heap_->mark_compact_collector());
@@ -1957,7 +2131,7 @@ bool MarkCompactCollector::IsUnmarkedHeapObjectWithHeap(Heap* heap,
 }
 
 void MarkCompactCollector::MarkStringTable(
-    RootMarkingVisitor<MarkCompactMode::FULL>* visitor) {
+    RootMarkingVisitor* visitor) {
   StringTable* string_table = heap()->string_table();
   // Mark the string table itself.
   if (ObjectMarking::IsWhite(string_table)) {
@@ -1966,11 +2140,11 @@ void MarkCompactCollector::MarkStringTable(
   }
   // Explicitly mark the prefix.
   string_table->IteratePrefix(visitor);
-  ProcessMarkingDeque<MarkCompactMode::FULL>();
+  ProcessMarkingDeque();
 }
 
 void MarkCompactCollector::MarkRoots(
-    RootMarkingVisitor<MarkCompactMode::FULL>* visitor) {
+    RootMarkingVisitor* visitor) {
   // Mark the heap roots including global variables, stack variables,
   // etc., and all objects reachable from them.
   heap()->IterateStrongRoots(visitor, VISIT_ONLY_STRONG);
@@ -1980,8 +2154,8 @@ void MarkCompactCollector::MarkRoots(
 
   // There may be overflowed objects in the heap.  Visit them now.
   while (marking_deque()->overflowed()) {
-    RefillMarkingDeque<MarkCompactMode::FULL>();
-    EmptyMarkingDeque<MarkCompactMode::FULL>();
+    RefillMarkingDeque();
+    EmptyMarkingDeque();
   }
 }
 
@@ -2021,7 +2195,6 @@ void MarkCompactCollector::MarkImplicitRefGroups(
 // Before: the marking stack contains zero or more heap object pointers.
 // After: the marking stack is empty, and all objects reachable from the
 // marking stack have been marked, or are overflowed in the heap.
-template <MarkCompactMode mode>
 void MarkCompactCollector::EmptyMarkingDeque() {
   while (!marking_deque()->IsEmpty()) {
     HeapObject* object = marking_deque()->Pop();
@@ -2032,16 +2205,8 @@ void MarkCompactCollector::EmptyMarkingDeque() {
     DCHECK(!ObjectMarking::IsWhite(object));
 
     Map* map = object->map();
-    switch (mode) {
-      case MarkCompactMode::FULL: {
-        MarkObject(map);
-        MarkCompactMarkingVisitor::IterateBody(map, object);
-      } break;
-      case MarkCompactMode::YOUNG_GENERATION: {
-        DCHECK(ObjectMarking::IsBlack(object));
-        StaticYoungGenerationMarkingVisitor::IterateBody(map, object);
-      } break;
-    }
+    MarkObject(map);
+    MarkCompactMarkingVisitor::IterateBody(map, object);
   }
 }
 
@@ -2051,7 +2216,6 @@ void MarkCompactCollector::EmptyMarkingDeque() {
 // before sweeping completes.  If sweeping completes, there are no remaining
 // overflowed objects in the heap so the overflow flag on the markings stack
 // is cleared.
-template <MarkCompactMode mode>
 void MarkCompactCollector::RefillMarkingDeque() {
   isolate()->CountUsage(v8::Isolate::UseCounterFeature::kMarkDequeOverflow);
   DCHECK(marking_deque()->overflowed());
@@ -2059,17 +2223,15 @@ void MarkCompactCollector::RefillMarkingDeque() {
   DiscoverGreyObjectsInNewSpace();
   if (marking_deque()->IsFull()) return;
 
-  if (mode == MarkCompactMode::FULL) {
-    DiscoverGreyObjectsInSpace(heap()->old_space());
-    if (marking_deque()->IsFull()) return;
-    DiscoverGreyObjectsInSpace(heap()->code_space());
-    if (marking_deque()->IsFull()) return;
-    DiscoverGreyObjectsInSpace(heap()->map_space());
-    if (marking_deque()->IsFull()) return;
-    LargeObjectIterator lo_it(heap()->lo_space());
-    DiscoverGreyObjectsWithIterator(&lo_it);
-    if (marking_deque()->IsFull()) return;
-  }
+  DiscoverGreyObjectsInSpace(heap()->old_space());
+  if (marking_deque()->IsFull()) return;
+  DiscoverGreyObjectsInSpace(heap()->code_space());
+  if (marking_deque()->IsFull()) return;
+  DiscoverGreyObjectsInSpace(heap()->map_space());
+  if (marking_deque()->IsFull()) return;
+  LargeObjectIterator lo_it(heap()->lo_space());
+  DiscoverGreyObjectsWithIterator(&lo_it);
+  if (marking_deque()->IsFull()) return;
 
   marking_deque()->ClearOverflowed();
 }
@@ -2079,12 +2241,11 @@ void MarkCompactCollector::RefillMarkingDeque() {
 // stack.  Before: the marking stack contains zero or more heap object
 // pointers.  After: the marking stack is empty and there are no overflowed
 // objects in the heap.
-template <MarkCompactMode mode>
 void MarkCompactCollector::ProcessMarkingDeque() {
-  EmptyMarkingDeque<mode>();
+  EmptyMarkingDeque();
   while (marking_deque()->overflowed()) {
-    RefillMarkingDeque<mode>();
-    EmptyMarkingDeque<mode>();
+    RefillMarkingDeque();
+    EmptyMarkingDeque();
   }
   DCHECK(marking_deque()->IsEmpty());
 }
@@ -2119,7 +2280,7 @@ void MarkCompactCollector::ProcessEphemeralMarking(
     }
     ProcessWeakCollections();
     work_to_do = !marking_deque()->IsEmpty();
-    ProcessMarkingDeque<MarkCompactMode::FULL>();
+    ProcessMarkingDeque();
   }
   CHECK(marking_deque()->IsEmpty());
   CHECK_EQ(0, heap()->local_embedder_heap_tracer()->NumberOfWrappersToTrace());
@@ -2136,7 +2297,7 @@ void MarkCompactCollector::ProcessTopOptimizedFrame(ObjectVisitor* visitor) {
       if (!code->CanDeoptAt(it.frame()->pc())) {
         Code::BodyDescriptor::IterateBody(code, visitor);
       }
-      ProcessMarkingDeque<MarkCompactMode::FULL>();
+      ProcessMarkingDeque();
       return;
     }
   }
@@ -2290,39 +2451,195 @@ void MarkCompactCollector::RecordObjectStats() {
   }
 }
 
-SlotCallbackResult MarkCompactCollector::CheckAndMarkObject(
-    Heap* heap, Address slot_address) {
-  Object* object = *reinterpret_cast<Object**>(slot_address);
-  if (heap->InNewSpace(object)) {
-    // Marking happens before flipping the young generation, so the object
-    // has to be in ToSpace.
-    DCHECK(heap->InToSpace(object));
-    HeapObject* heap_object = reinterpret_cast<HeapObject*>(object);
-    if (ObjectMarking::IsBlackOrGrey(heap_object)) {
+void MarkCompactCollector::CollectStringDeduplicationCandidates() {
+  string_deduplication_candidates_.Clear();
+  if (!FLAG_string_deduplication) return;
+  string_deduplication_ms_count_ = heap()->ms_count();
+  auto visit = [this](HeapObject* object) {
+    if (!object->IsSeqString() || object->IsInternalizedString()) return;
+    String* string = String::cast(object);
+    if (string->length() < FLAG_string_deduplication_min_length) return;
+    string_deduplication_candidates_.Add(string);
+  };
+  for (Page* p : *heap()->old_space()) {
+    // Strings on evacuation candidates are moved.
+    if (p->IsEvacuationCandidate()) continue;
+    LiveObjectIterator<kBlackObjects> it(p);
+    HeapObject* object = nullptr;
+    while ((object = it.Next()) != nullptr) visit(object);
+  }
+  LargeObjectIterator it(heap()->lo_space());
+  for (HeapObject* object = it.Next(); object != nullptr; object = it.Next()) {
+    if (ObjectMarking::IsBlack(object)) visit(object);
+  }
+}
+
+// Marks the young generation on a single task. New space objects are marked
+// black when they are discovered and pushed onto a work-stealing worklist
+// that is shared by all young generation marking tasks. Mark bits are set
+// atomically since tasks may race for the same object. Live bytes are
+// accounted per task and merged into the pages on the main thread.
+class YoungGenerationMarker {
+ public:
+  YoungGenerationMarker(Heap* heap,
+                        MarkCompactCollector::YoungGenerationWorklist* worklist,
+                        int task_id)
+      : heap_(heap), worklist_(worklist), task_id_(task_id) {
+    DCHECK_LT(task_id,
+              MarkCompactCollector::YoungGenerationWorklist::kMaxNumTasks);
+  }
+
+  inline Heap* heap() { return heap_; }
+
+  void MarkObject(Object* object) {
+    if (!heap_->InNewSpace(object)) return;
+    HeapObject* heap_object = HeapObject::cast(object);
+    if (Marking::WhiteToBlack<MarkBit::ATOMIC>(
+            ObjectMarking::MarkBitFrom(heap_object))) {
+      live_bytes_[MemoryChunk::FromAddress(heap_object->address())] +=
+          heap_object->Size();
+      worklist_->Push(task_id_, heap_object);
+    }
+  }
+
+  // Marks the objects referenced from the old-to-new slots of the page.
+  void MarkPage(MemoryChunk* chunk) {
+    // No slots are inserted while marking, so empty buckets can be freed
+    // right away.
+    RememberedSet<OLD_TO_NEW>::Iterate(
+        chunk, [this](Address slot) { return CheckAndMarkObject(slot); },
+        SlotSet::FREE_EMPTY_BUCKETS);
+    RememberedSet<OLD_TO_NEW>::IterateTyped(
+        chunk, [this](SlotType type, Address host_addr, Address slot) {
+          return UpdateTypedSlotHelper::UpdateTypedSlot(
+              heap_->isolate(), type, slot, [this](Object** slot) {
+                return CheckAndMarkObject(reinterpret_cast<Address>(slot));
+              });
+        });
+  }
+
+  // Visits marked objects until the worklist is empty.
+  inline void Process();
+
+  // Needs to be called from the main thread after all tasks finished.
+  void Finalize() {
+    for (auto& pair : live_bytes_) {
+      pair.first->IncrementLiveBytes(static_cast<int>(pair.second));
+    }
+    live_bytes_.clear();
+  }
+
+ private:
+  SlotCallbackResult CheckAndMarkObject(Address slot_address) {
+    Object* object = *reinterpret_cast<Object**>(slot_address);
+    if (heap_->InNewSpace(object)) {
+      // Marking happens before flipping the young generation, so the object
+      // has to be in ToSpace.
+      DCHECK(heap_->InToSpace(object));
+      MarkObject(object);
       return KEEP_SLOT;
     }
-    ObjectMarking::WhiteToBlack(heap_object);
-    StaticYoungGenerationMarkingVisitor::IterateBody(heap_object->map(),
-                                                     heap_object);
-    return KEEP_SLOT;
+    return REMOVE_SLOT;
+  }
+
+  Heap* heap_;
+  MarkCompactCollector::YoungGenerationWorklist* worklist_;
+  int task_id_;
+  std::unordered_map<MemoryChunk*, intptr_t> live_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(YoungGenerationMarker);
+};
+
+class YoungGenerationMarkingVisitor final : public ObjectVisitor {
+ public:
+  explicit YoungGenerationMarkingVisitor(YoungGenerationMarker* marker)
+      : marker_(marker) {}
+
+  void VisitPointer(Object** p) override { marker_->MarkObject(*p); }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) marker_->MarkObject(*p);
+  }
+
+ private:
+  YoungGenerationMarker* const marker_;
+};
+
+void YoungGenerationMarker::Process() {
+  YoungGenerationMarkingVisitor visitor(this);
+  HeapObject* object = nullptr;
+  while (worklist_->Pop(task_id_, &object)) {
+    Map* map = object->map();
+    int size = object->SizeFromMap(map);
+    if (map->instance_type() == JS_FUNCTION_TYPE) {
+      // JSFunctions reachable through kNextFunctionLinkOffset are weak. Dead
+      // functions are unlinked when the young weak lists are processed.
+      JSFunction::BodyDescriptorWeakCode::IterateBody(object, size, &visitor);
+    } else {
+      object->IterateBody(map->instance_type(), size, &visitor);
+    }
   }
-  return REMOVE_SLOT;
 }
 
-static bool IsUnmarkedObject(Heap* heap, Object** p) {
+class YoungGenerationMarkingJobTraits {
+ public:
+  typedef int PerPageData;  // Per page data is not used in this job.
+  typedef YoungGenerationMarker* PerTaskData;
+
+  static const bool NeedSequentialFinalization = false;
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData marker,
+                                    MemoryChunk* chunk, PerPageData) {
+    marker->MarkPage(chunk);
+    marker->Process();
+    return true;
+  }
+
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool,
+                                       PerPageData) {}
+};
+
+static bool IsUnmarkedObjectInYoungGeneration(Heap* heap, Object** p) {
   DCHECK_IMPLIES(heap->InNewSpace(*p), heap->InToSpace(*p));
   return heap->InNewSpace(*p) && !ObjectMarking::IsBlack(HeapObject::cast(*p));
 }
 
+int MarkCompactCollector::NumberOfYoungGenerationMarkingTasks(int pages) {
+  if (!FLAG_minor_mc_parallel_marking) return 1;
+  // The number of tasks is limited by:
+  // - #pages with old-to-new slots, using one task per kPagesPerTask pages
+  // - the number of tasks supported by the worklist
+  // - #cores
+  const int kPagesPerTask = 2;
+  const int available_cores = Max(
+      1, static_cast<int>(
+             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
+  const int tasks = Max(1, (pages + kPagesPerTask - 1) / kPagesPerTask);
+  return Min(Min(tasks, YoungGenerationWorklist::kMaxNumTasks),
+             available_cores);
+}
+
 void MarkCompactCollector::MarkLiveObjectsInYoungGeneration() {
   TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK);
 
   PostponeInterruptsScope postpone(isolate());
 
-  StaticYoungGenerationMarkingVisitor::Initialize(heap());
-  RootMarkingVisitor<MarkCompactMode::YOUNG_GENERATION> root_visitor(heap());
-
-  marking_deque()->StartUsing();
+  YoungGenerationWorklist worklist;
+  PageParallelJob<YoungGenerationMarkingJobTraits> job(
+      heap(), isolate()->cancelable_task_manager(),
+      &page_parallel_job_semaphore_);
+  RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+      heap(), [&job](MemoryChunk* chunk) { job.AddPage(chunk, 0); });
+  const int num_tasks =
+      NumberOfYoungGenerationMarkingTasks(job.NumberOfPages());
+  YoungGenerationMarker* markers[YoungGenerationWorklist::kMaxNumTasks];
+  for (int i = 0; i < num_tasks; i++) {
+    markers[i] = new YoungGenerationMarker(heap(), &worklist, i);
+  }
+  // Everything but old-to-new slots is visited on the main thread using the
+  // marker of task 0.
+  YoungGenerationMarker* main_marker = markers[0];
+  YoungGenerationMarkingVisitor root_visitor(main_marker);
 
   isolate()->global_handles()->IdentifyWeakUnmodifiedObjects(
       &Heap::IsUnmodifiedHeapObject);
@@ -2330,51 +2647,70 @@ void MarkCompactCollector::MarkLiveObjectsInYoungGeneration() {
   {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK_ROOTS);
     heap()->IterateRoots(&root_visitor, VISIT_ALL_IN_SCAVENGE);
-    ProcessMarkingDeque<MarkCompactMode::YOUNG_GENERATION>();
+    // Make the objects marked from roots available to all tasks.
+    worklist.FlushToGlobal(0);
   }
 
   {
+    // Each task marks from a set of pages and afterwards helps with the
+    // transitive closure.
     TRACE_GC(heap()->tracer(),
              GCTracer::Scope::MINOR_MC_MARK_OLD_TO_NEW_POINTERS);
-    RememberedSet<OLD_TO_NEW>::Iterate(heap(), [this](Address addr) {
-      return CheckAndMarkObject(heap(), addr);
-    });
-    RememberedSet<OLD_TO_NEW>::IterateTyped(
-        heap(), [this](SlotType type, Address host_addr, Address addr) {
-          return UpdateTypedSlotHelper::UpdateTypedSlot(
-              isolate(), type, addr, [this](Object** addr) {
-                return CheckAndMarkObject(heap(),
-                                          reinterpret_cast<Address>(addr));
-              });
-        });
-    ProcessMarkingDeque<MarkCompactMode::YOUNG_GENERATION>();
+    if (job.NumberOfPages() > 0) {
+      job.Run(num_tasks, [&markers](int i) { return markers[i]; });
+    }
+    main_marker->Process();
   }
 
   {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK_WEAK);
     heap()->VisitEncounteredWeakCollections(&root_visitor);
-    ProcessMarkingDeque<MarkCompactMode::YOUNG_GENERATION>();
+    main_marker->Process();
   }
 
   if (is_code_flushing_enabled()) {
     TRACE_GC(heap()->tracer(),
              GCTracer::Scope::MINOR_MC_MARK_CODE_FLUSH_CANDIDATES);
     code_flusher()->IteratePointersToFromSpace(&root_visitor);
-    ProcessMarkingDeque<MarkCompactMode::YOUNG_GENERATION>();
+    main_marker->Process();
   }
 
   {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK_GLOBAL_HANDLES);
     isolate()->global_handles()->MarkNewSpaceWeakUnmodifiedObjectsPending(
-        &IsUnmarkedObject);
+        &IsUnmarkedObjectInYoungGeneration);
     isolate()
         ->global_handles()
-        ->IterateNewSpaceWeakUnmodifiedRoots<GlobalHandles::VISIT_OTHERS>(
-            &root_visitor);
-    ProcessMarkingDeque<MarkCompactMode::YOUNG_GENERATION>();
+        ->IterateNewSpaceWeakUnmodifiedRoots<
+            GlobalHandles::HANDLE_PHANTOM_NODES_VISIT_OTHERS>(&root_visitor);
+    main_marker->Process();
+  }
+
+  DCHECK(worklist.IsGlobalEmpty());
+  for (int i = 0; i < num_tasks; i++) {
+    markers[i]->Finalize();
+    delete markers[i];
+  }
+}
+
+void MarkCompactCollector::ClearNonLiveReferencesInYoungGeneration() {
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_CLEAR);
+
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_CLEAR_STRING_TABLE);
+    // Internalized strings are always stored in old space, so there is no
+    // need to clean them up here.
+    ExternalStringTableCleaner external_visitor(heap(), nullptr);
+    heap()->external_string_table_.IterateNewSpaceStrings(&external_visitor);
+    heap()->external_string_table_.CleanUpNewSpaceStrings();
   }
 
-  marking_deque()->StopUsing();
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_CLEAR_WEAK_LISTS);
+    // Process the weak references.
+    MinorMarkCompactWeakObjectRetainer retainer(heap());
+    heap()->ProcessYoungWeakReferences(&retainer);
+  }
 }
 
 void MarkCompactCollector::MarkLiveObjects() {
@@ -2408,7 +2744,7 @@ void MarkCompactCollector::MarkLiveObjects() {
     PrepareForCodeFlushing();
   }
 
-  RootMarkingVisitor<MarkCompactMode::FULL> root_visitor(heap());
+  RootMarkingVisitor root_visitor(heap());
 
   {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_ROOTS);
@@ -2440,7 +2776,7 @@ void MarkCompactCollector::MarkLiveObjects() {
                GCTracer::Scope::MC_MARK_WEAK_CLOSURE_WEAK_HANDLES);
       heap()->isolate()->global_handles()->IdentifyWeakHandles(
           &IsUnmarkedHeapObject);
-      ProcessMarkingDeque<MarkCompactMode::FULL>();
+      ProcessMarkingDeque();
     }
     // Then we mark the objects.
 
@@ -2448,7 +2784,7 @@ void MarkCompactCollector::MarkLiveObjects() {
       TRACE_GC(heap()->tracer(),
                GCTracer::Scope::MC_MARK_WEAK_CLOSURE_WEAK_ROOTS);
       heap()->isolate()->global_handles()->IterateWeakRoots(&root_visitor);
-      ProcessMarkingDeque<MarkCompactMode::FULL>();
+      ProcessMarkingDeque();
     }
 
     // Repeat Harmony weak maps marking to mark unmarked objects reachable from
@@ -3525,7 +3861,7 @@ bool MarkCompactCollector::VisitLiveObjects(MemoryChunk* page, Visitor* visitor,
     DCHECK(ObjectMarking::IsBlack(object));
     if (!visitor->Visit(object)) {
       if (mode == kClearMarkbits) {
-        page->markbits()->ClearRange(
+        page->markbits()->ClearRange<MarkBit::ATOMIC>(
             page->AddressToMarkbitIndex(page->area_start()),
             page->AddressToMarkbitIndex(object->address()));
         if (page->old_to_new_slots() != nullptr) {
@@ -3655,13 +3991,19 @@ class PointerUpdateJobTraits {
  private:
   static void UpdateUntypedPointers(Heap* heap, MemoryChunk* chunk) {
     if (direction == OLD_TO_NEW) {
-      RememberedSet<OLD_TO_NEW>::Iterate(chunk, [heap](Address slot) {
-        return CheckAndUpdateOldToNewSlot(heap, slot);
-      });
+      RememberedSet<OLD_TO_NEW>::Iterate(
+          chunk,
+          [heap](Address slot) {
+            return CheckAndUpdateOldToNewSlot(heap, slot);
+          },
+          SlotSet::PREFREE_EMPTY_BUCKETS);
     } else {
-      RememberedSet<OLD_TO_OLD>::Iterate(chunk, [](Address slot) {
-        return UpdateSlot(reinterpret_cast<Object**>(slot));
-      });
+      RememberedSet<OLD_TO_OLD>::Iterate(
+          chunk,
+          [](Address slot) {
+            return UpdateSlot(reinterpret_cast<Object**>(slot));
+          },
+          SlotSet::PREFREE_EMPTY_BUCKETS);
     }
   }
 
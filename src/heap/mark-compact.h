@@ -6,6 +6,7 @@
 #define V8_HEAP_MARK_COMPACT_H_
 
 #include <deque>
+#include <vector>
 
 #include "src/base/bits.h"
 #include "src/base/platform/condition-variable.h"
@@ -13,12 +14,11 @@
 #include "src/heap/marking.h"
 #include "src/heap/spaces.h"
 #include "src/heap/store-buffer.h"
+#include "src/heap/worklist.h"
 
 namespace v8 {
 namespace internal {
 
-enum class MarkCompactMode { FULL, YOUNG_GENERATION };
-
 // Callback function, returns whether an object is alive. The heap size
 // of the object is returned in size. It optionally updates the offset
 // to the first live object in the page (only used for old and map objects).
@@ -31,7 +31,6 @@ typedef void (*MarkObjectFunction)(Heap* heap, HeapObject* object);
 class CodeFlusher;
 class MarkCompactCollector;
 class MarkingVisitor;
-template <MarkCompactMode mode>
 class RootMarkingVisitor;
 
 class ObjectMarking : public AllStatic {
@@ -46,74 +45,92 @@ class ObjectMarking : public AllStatic {
     return Marking::Color(ObjectMarking::MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static bool IsImpossible(HeapObject* obj) {
-    return Marking::IsImpossible(MarkBitFrom(obj));
+    return Marking::IsImpossible<mode>(MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static bool IsBlack(HeapObject* obj) {
-    return Marking::IsBlack(MarkBitFrom(obj));
+    return Marking::IsBlack<mode>(MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static bool IsWhite(HeapObject* obj) {
-    return Marking::IsWhite(MarkBitFrom(obj));
+    return Marking::IsWhite<mode>(MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static bool IsGrey(HeapObject* obj) {
-    return Marking::IsGrey(MarkBitFrom(obj));
+    return Marking::IsGrey<mode>(MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static bool IsBlackOrGrey(HeapObject* obj) {
-    return Marking::IsBlackOrGrey(MarkBitFrom(obj));
+    return Marking::IsBlackOrGrey<mode>(MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static void ClearMarkBit(HeapObject* obj) {
-    Marking::MarkWhite(MarkBitFrom(obj));
+    Marking::MarkWhite<mode>(MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static void BlackToWhite(HeapObject* obj) {
-    DCHECK(IsBlack(obj));
+    DCHECK(IsBlack<mode>(obj));
     MarkBit markbit = MarkBitFrom(obj);
-    Marking::BlackToWhite(markbit);
+    Marking::BlackToWhite<mode>(markbit);
     MemoryChunk::IncrementLiveBytes(obj, -obj->Size());
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static void GreyToWhite(HeapObject* obj) {
-    DCHECK(IsGrey(obj));
-    Marking::GreyToWhite(MarkBitFrom(obj));
+    DCHECK(IsGrey<mode>(obj));
+    Marking::GreyToWhite<mode>(MarkBitFrom(obj));
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static void BlackToGrey(HeapObject* obj) {
-    DCHECK(IsBlack(obj));
+    DCHECK(IsBlack<mode>(obj));
     MarkBit markbit = MarkBitFrom(obj);
-    Marking::BlackToGrey(markbit);
+    Marking::BlackToGrey<mode>(markbit);
     MemoryChunk::IncrementLiveBytes(obj, -obj->Size());
   }
 
-  V8_INLINE static void WhiteToGrey(HeapObject* obj) {
-    DCHECK(IsWhite(obj));
-    Marking::WhiteToGrey(MarkBitFrom(obj));
+  // The transitions below return false if the object was concurrently marked
+  // by another thread. Live bytes are only accounted for successful
+  // transitions.
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  V8_INLINE static bool WhiteToGrey(HeapObject* obj) {
+    DCHECK(mode == MarkBit::ATOMIC || IsWhite(obj));
+    return Marking::WhiteToGrey<mode>(MarkBitFrom(obj));
   }
 
-  V8_INLINE static void WhiteToBlack(HeapObject* obj) {
-    DCHECK(IsWhite(obj));
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  V8_INLINE static bool WhiteToBlack(HeapObject* obj) {
+    DCHECK(mode == MarkBit::ATOMIC || IsWhite(obj));
     MarkBit markbit = MarkBitFrom(obj);
-    Marking::WhiteToBlack(markbit);
+    if (!Marking::WhiteToBlack<mode>(markbit)) return false;
     MemoryChunk::IncrementLiveBytes(obj, obj->Size());
+    return true;
   }
 
-  V8_INLINE static void GreyToBlack(HeapObject* obj) {
-    DCHECK(IsGrey(obj));
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  V8_INLINE static bool GreyToBlack(HeapObject* obj) {
+    DCHECK(mode == MarkBit::ATOMIC || IsGrey(obj));
     MarkBit markbit = MarkBitFrom(obj);
-    Marking::GreyToBlack(markbit);
+    if (!Marking::GreyToBlack<mode>(markbit)) return false;
     MemoryChunk::IncrementLiveBytes(obj, obj->Size());
+    return true;
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   V8_INLINE static void AnyToGrey(HeapObject* obj) {
     MarkBit markbit = MarkBitFrom(obj);
-    if (Marking::IsBlack(markbit)) {
+    if (Marking::IsBlack<mode>(markbit)) {
       MemoryChunk::IncrementLiveBytes(obj, -obj->Size());
     }
-    Marking::AnyToGrey(markbit);
+    Marking::AnyToGrey<mode>(markbit);
   }
 
  private:
@@ -272,11 +289,27 @@ class CodeFlusher {
   inline void AddCandidate(SharedFunctionInfo* shared_info);
   inline void AddCandidate(JSFunction* function);
 
+  // Bytecode candidates cannot be linked through their code object, which
+  // is the shared interpreter entry trampoline, and are kept in a side list.
+  inline void AddBytecodeCandidate(SharedFunctionInfo* shared_info);
+
   void EvictCandidate(SharedFunctionInfo* shared_info);
   void EvictCandidate(JSFunction* function);
 
+  // Returns true if the bytecode of the function can be dropped and
+  // regenerated by lazy compilation on the next call. The age of the
+  // bytecode is not taken into account.
+  static bool CanFlushBytecode(Isolate* isolate,
+                               SharedFunctionInfo* shared_info);
+
+  // Marks the bytecode of candidates that became ineligible for flushing
+  // while incremental marking was running, e.g., because the function got
+  // optimized. Must be called in the atomic pause before marking the roots.
+  void RetainIneligibleBytecodeCandidates();
+
   void ProcessCandidates() {
     ProcessSharedFunctionInfoCandidates();
+    ProcessBytecodeCandidates();
     ProcessJSFunctionCandidates();
   }
 
@@ -285,6 +318,7 @@ class CodeFlusher {
  private:
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
+  void ProcessBytecodeCandidates();
 
   static inline JSFunction** GetNextCandidateSlot(JSFunction* candidate);
   static inline JSFunction* GetNextCandidate(JSFunction* candidate);
@@ -302,6 +336,9 @@ class CodeFlusher {
   Isolate* isolate_;
   JSFunction* jsfunction_candidates_head_;
   SharedFunctionInfo* shared_function_info_candidates_head_;
+  // Shared function infos are allocated in old space and do not move before
+  // the candidates are processed. The list may contain duplicates.
+  std::vector<SharedFunctionInfo*> bytecode_candidates_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeFlusher);
 };
@@ -407,6 +444,8 @@ class MarkCompactCollector {
  public:
   class Evacuator;
 
+  typedef Worklist<HeapObject*, 64> YoungGenerationWorklist;
+
   class Sweeper {
    public:
     class SweeperTask;
@@ -486,9 +525,6 @@ class MarkCompactCollector {
 
   static void Initialize();
 
-  static SlotCallbackResult CheckAndMarkObject(Heap* heap,
-                                               Address slot_address);
-
   void SetUp();
 
   void TearDown();
@@ -504,6 +540,10 @@ class MarkCompactCollector {
   // Performs a global garbage collection.
   void CollectGarbage();
 
+  // Performs a garbage collection of the young generation (--minor_mc).
+  // Marking and evacuation are done in parallel.
+  void CollectGarbageInYoungGeneration();
+
   bool StartCompaction();
 
   void AbortCompaction();
@@ -537,6 +577,11 @@ class MarkCompactCollector {
   void RecordRelocSlot(Code* host, RelocInfo* rinfo, Object* target);
   void RecordCodeEntrySlot(HeapObject* host, Address slot, Code* target);
   void RecordCodeTargetPatch(Address pc, Code* target);
+
+  // Closures allocated black during incremental marking are never visited.
+  // Records those that run in the interpreter as code flushing candidates,
+  // so that they are reset if their bytecode gets flushed.
+  void RecordBlackAllocatedClosure(JSFunction* function);
   INLINE(void RecordSlot(HeapObject* object, Object** slot, Object* target));
   INLINE(void ForceRecordSlot(HeapObject* object, Object** slot,
                               Object* target));
@@ -614,6 +659,11 @@ class MarkCompactCollector {
 
   void RecordObjectStats();
 
+  // Collects live, non-internalized sequential strings in old space that are
+  // not moved by this GC (--string_deduplication). They are deduplicated by
+  // Heap::DeduplicateStrings on a foreground task after the GC finished.
+  void CollectStringDeduplicationCandidates();
+
   // Finishes GC, performs heap verification if enabled.
   void Finish();
 
@@ -626,15 +676,14 @@ class MarkCompactCollector {
   //
   //   After: Live objects are marked and non-live objects are unmarked.
 
+  friend class CodeFlusher;
   friend class CodeMarkingVisitor;
   friend class IncrementalMarkingMarkingVisitor;
   friend class MarkCompactMarkingVisitor;
   friend class MarkingVisitor;
   friend class RecordMigratedSlotVisitor;
-  template <MarkCompactMode mode>
   friend class RootMarkingVisitor;
   friend class SharedFunctionInfoMarkingVisitor;
-  friend class StaticYoungGenerationMarkingVisitor;
 
   // Mark code objects that are active on the stack to prevent them
   // from being flushed.
@@ -642,10 +691,23 @@ class MarkCompactCollector {
 
   void PrepareForCodeFlushing();
 
+  // Optimized code may deoptimize to the bytecode of the outer function and
+  // of all inlined functions, which therefore must not be flushed.
+  void MarkInlinedBytecode(Code* code);
+
+  // Optimized code that was allocated black during incremental marking was
+  // never visited. Marks the bytecode it depends on.
+  void MarkBytecodeOfLiveOptimizedCode();
+
   // Marking operations for objects reachable from roots.
   void MarkLiveObjects();
   // Mark the young generation.
   void MarkLiveObjectsInYoungGeneration();
+  int NumberOfYoungGenerationMarkingTasks(int pages);
+
+  // Clears references from the young generation to dead young generation
+  // objects, i.e., the external string table and weak lists.
+  void ClearNonLiveReferencesInYoungGeneration();
 
   // Pushes a black object onto the marking stack and accounts for live bytes.
   // Note that this assumes live bytes have not yet been counted.
@@ -660,15 +722,14 @@ class MarkCompactCollector {
   INLINE(void MarkObject(HeapObject* obj));
 
   // Mark the heap roots and all objects reachable from them.
-  void MarkRoots(RootMarkingVisitor<MarkCompactMode::FULL>* visitor);
+  void MarkRoots(RootMarkingVisitor* visitor);
 
   // Mark the string table specially.  References to internalized strings from
   // the string table are weak.
-  void MarkStringTable(RootMarkingVisitor<MarkCompactMode::FULL>* visitor);
+  void MarkStringTable(RootMarkingVisitor* visitor);
 
   // Mark objects reachable (transitively) from objects in the marking stack
   // or overflowed in the heap.
-  template <MarkCompactMode mode>
   void ProcessMarkingDeque();
 
   // Mark objects reachable (transitively) from objects in the marking stack
@@ -692,13 +753,11 @@ class MarkCompactCollector {
   // stack.  This function empties the marking stack, but may leave
   // overflowed objects in the heap, in which case the marking stack's
   // overflow flag will be set.
-  template <MarkCompactMode mode>
   void EmptyMarkingDeque();
 
   // Refill the marking stack with overflowed objects from the heap.  This
   // function either leaves the marking stack full or clears the overflow
   // flag on the marking stack.
-  template <MarkCompactMode mode>
   void RefillMarkingDeque();
 
   // Helper methods for refilling the marking stack by discovering grey objects
@@ -827,6 +886,11 @@ class MarkCompactCollector {
 
   Sweeper sweeper_;
 
+  // Candidates for string deduplication and the GC count at which they were
+  // collected.
+  List<String*> string_deduplication_candidates_;
+  unsigned int string_deduplication_ms_count_;
+
   friend class Heap;
   friend class StoreBuffer;
 };
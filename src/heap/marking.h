@@ -5,6 +5,7 @@
 #ifndef V8_MARKING_H
 #define V8_MARKING_H
 
+#include "src/base/atomicops.h"
 #include "src/utils.h"
 
 namespace v8 {
@@ -14,6 +15,11 @@ class MarkBit {
  public:
   typedef uint32_t CellType;
 
+  // Mark bits that may be accessed concurrently, i.e., during concurrent
+  // marking, have to be accessed atomically. Atomic accesses report whether
+  // they changed the bit, allowing threads to race for marking an object.
+  enum AccessMode { NON_ATOMIC, ATOMIC };
+
   inline MarkBit(CellType* cell, CellType mask) : cell_(cell), mask_(mask) {}
 
 #ifdef DEBUG
@@ -35,9 +41,16 @@ class MarkBit {
     }
   }
 
-  inline void Set() { *cell_ |= mask_; }
-  inline bool Get() { return (*cell_ & mask_) != 0; }
-  inline void Clear() { *cell_ &= ~mask_; }
+  // Returns false if the bit was already set.
+  template <AccessMode mode = NON_ATOMIC>
+  inline bool Set();
+
+  template <AccessMode mode = NON_ATOMIC>
+  inline bool Get();
+
+  // Returns false if the bit was already cleared.
+  template <AccessMode mode = NON_ATOMIC>
+  inline bool Clear();
 
   CellType* cell_;
   CellType mask_;
@@ -46,6 +59,55 @@ class MarkBit {
   friend class Marking;
 };
 
+template <>
+inline bool MarkBit::Set<MarkBit::NON_ATOMIC>() {
+  *cell_ |= mask_;
+  return true;
+}
+
+template <>
+inline bool MarkBit::Set<MarkBit::ATOMIC>() {
+  base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+  base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+  base::Atomic32 old_value;
+  do {
+    old_value = base::NoBarrier_Load(cell);
+    if (old_value & mask) return false;
+  } while (base::Release_CompareAndSwap(cell, old_value, old_value | mask) !=
+           old_value);
+  return true;
+}
+
+template <>
+inline bool MarkBit::Get<MarkBit::NON_ATOMIC>() {
+  return (*cell_ & mask_) != 0;
+}
+
+template <>
+inline bool MarkBit::Get<MarkBit::ATOMIC>() {
+  return (base::Acquire_Load(reinterpret_cast<base::Atomic32*>(cell_)) &
+          static_cast<base::Atomic32>(mask_)) != 0;
+}
+
+template <>
+inline bool MarkBit::Clear<MarkBit::NON_ATOMIC>() {
+  *cell_ &= ~mask_;
+  return true;
+}
+
+template <>
+inline bool MarkBit::Clear<MarkBit::ATOMIC>() {
+  base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+  base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+  base::Atomic32 old_value;
+  do {
+    old_value = base::NoBarrier_Load(cell);
+    if (!(old_value & mask)) return false;
+  } while (base::Release_CompareAndSwap(cell, old_value, old_value & ~mask) !=
+           old_value);
+  return true;
+}
+
 // Bitmap is a sequence of cells each containing fixed number of bits.
 class Bitmap {
  public:
@@ -106,7 +168,18 @@ class Bitmap {
     for (int i = 0; i < CellsCount(); i++) cells()[i] = 0;
   }
 
+  // Sets bits of the given cell that are set in |mask|. Only the first and
+  // the last cell of a range may contain mark bits of other objects and need
+  // to be updated atomically in ATOMIC mode.
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  inline void SetBitsInCell(uint32_t cell_index, MarkBit::CellType mask);
+
+  // Clears bits of the given cell that are set in |mask|.
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  inline void ClearBitsInCell(uint32_t cell_index, MarkBit::CellType mask);
+
   // Sets all bits in the range [start_index, end_index).
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   void SetRange(uint32_t start_index, uint32_t end_index) {
     unsigned int start_cell_index = start_index >> Bitmap::kBitsPerCellLog2;
     MarkBit::CellType start_index_mask = 1u << Bitmap::IndexInCell(start_index);
@@ -117,19 +190,20 @@ class Bitmap {
     if (start_cell_index != end_cell_index) {
       // Firstly, fill all bits from the start address to the end of the first
       // cell with 1s.
-      cells()[start_cell_index] |= ~(start_index_mask - 1);
+      SetBitsInCell<mode>(start_cell_index, ~(start_index_mask - 1));
       // Then fill all in between cells with 1s.
       for (unsigned int i = start_cell_index + 1; i < end_cell_index; i++) {
         cells()[i] = ~0u;
       }
       // Finally, fill all bits until the end address in the last cell with 1s.
-      cells()[end_cell_index] |= (end_index_mask - 1);
+      SetBitsInCell<mode>(end_cell_index, end_index_mask - 1);
     } else {
-      cells()[start_cell_index] |= end_index_mask - start_index_mask;
+      SetBitsInCell<mode>(start_cell_index, end_index_mask - start_index_mask);
     }
   }
 
   // Clears all bits in the range [start_index, end_index).
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   void ClearRange(uint32_t start_index, uint32_t end_index) {
     unsigned int start_cell_index = start_index >> Bitmap::kBitsPerCellLog2;
     MarkBit::CellType start_index_mask = 1u << Bitmap::IndexInCell(start_index);
@@ -140,15 +214,16 @@ class Bitmap {
     if (start_cell_index != end_cell_index) {
       // Firstly, fill all bits from the start address to the end of the first
       // cell with 0s.
-      cells()[start_cell_index] &= (start_index_mask - 1);
+      ClearBitsInCell<mode>(start_cell_index, ~(start_index_mask - 1));
       // Then fill all in between cells with 0s.
       for (unsigned int i = start_cell_index + 1; i < end_cell_index; i++) {
         cells()[i] = 0;
       }
       // Finally, set all bits until the end address in the last cell with 0s.
-      cells()[end_cell_index] &= ~(end_index_mask - 1);
+      ClearBitsInCell<mode>(end_cell_index, end_index_mask - 1);
     } else {
-      cells()[start_cell_index] &= ~(end_index_mask - start_index_mask);
+      ClearBitsInCell<mode>(start_cell_index,
+                            end_index_mask - start_index_mask);
     }
   }
 
@@ -267,83 +342,141 @@ class Bitmap {
   }
 };
 
+template <>
+inline void Bitmap::SetBitsInCell<MarkBit::NON_ATOMIC>(uint32_t cell_index,
+                                                       MarkBit::CellType mask) {
+  cells()[cell_index] |= mask;
+}
+
+template <>
+inline void Bitmap::SetBitsInCell<MarkBit::ATOMIC>(uint32_t cell_index,
+                                                   MarkBit::CellType mask) {
+  base::Atomic32* cell =
+      reinterpret_cast<base::Atomic32*>(cells() + cell_index);
+  base::Atomic32 old_value;
+  do {
+    old_value = base::NoBarrier_Load(cell);
+  } while (base::Release_CompareAndSwap(
+               cell, old_value,
+               old_value | static_cast<base::Atomic32>(mask)) != old_value);
+}
+
+template <>
+inline void Bitmap::ClearBitsInCell<MarkBit::NON_ATOMIC>(
+    uint32_t cell_index, MarkBit::CellType mask) {
+  cells()[cell_index] &= ~mask;
+}
+
+template <>
+inline void Bitmap::ClearBitsInCell<MarkBit::ATOMIC>(uint32_t cell_index,
+                                                     MarkBit::CellType mask) {
+  base::Atomic32* cell =
+      reinterpret_cast<base::Atomic32*>(cells() + cell_index);
+  base::Atomic32 old_value;
+  do {
+    old_value = base::NoBarrier_Load(cell);
+  } while (base::Release_CompareAndSwap(
+               cell, old_value,
+               old_value & ~static_cast<base::Atomic32>(mask)) != old_value);
+}
+
 class Marking : public AllStatic {
  public:
   // Impossible markbits: 01
   static const char* kImpossibleBitPattern;
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static bool IsImpossible(MarkBit mark_bit)) {
-    return !mark_bit.Get() && mark_bit.Next().Get();
+    return !mark_bit.Get<mode>() && mark_bit.Next().Get<mode>();
   }
 
   // Black markbits: 11
   static const char* kBlackBitPattern;
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static bool IsBlack(MarkBit mark_bit)) {
-    return mark_bit.Get() && mark_bit.Next().Get();
+    return mark_bit.Get<mode>() && mark_bit.Next().Get<mode>();
   }
 
   // White markbits: 00 - this is required by the mark bit clearer.
   static const char* kWhiteBitPattern;
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static bool IsWhite(MarkBit mark_bit)) {
-    DCHECK(!IsImpossible(mark_bit));
-    return !mark_bit.Get();
+    DCHECK(!IsImpossible<mode>(mark_bit));
+    return !mark_bit.Get<mode>();
   }
 
   // Grey markbits: 10
   static const char* kGreyBitPattern;
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static bool IsGrey(MarkBit mark_bit)) {
-    return mark_bit.Get() && !mark_bit.Next().Get();
+    return mark_bit.Get<mode>() && !mark_bit.Next().Get<mode>();
   }
 
   // IsBlackOrGrey assumes that the first bit is set for black or grey
   // objects.
-  INLINE(static bool IsBlackOrGrey(MarkBit mark_bit)) { return mark_bit.Get(); }
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  INLINE(static bool IsBlackOrGrey(MarkBit mark_bit)) {
+    return mark_bit.Get<mode>();
+  }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static void MarkBlack(MarkBit mark_bit)) {
-    mark_bit.Set();
-    mark_bit.Next().Set();
+    mark_bit.Set<mode>();
+    mark_bit.Next().Set<mode>();
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static void MarkWhite(MarkBit mark_bit)) {
-    mark_bit.Clear();
-    mark_bit.Next().Clear();
+    mark_bit.Clear<mode>();
+    mark_bit.Next().Clear<mode>();
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static void BlackToWhite(MarkBit markbit)) {
-    DCHECK(IsBlack(markbit));
-    markbit.Clear();
-    markbit.Next().Clear();
+    DCHECK(IsBlack<mode>(markbit));
+    markbit.Clear<mode>();
+    markbit.Next().Clear<mode>();
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static void GreyToWhite(MarkBit markbit)) {
-    DCHECK(IsGrey(markbit));
-    markbit.Clear();
-    markbit.Next().Clear();
+    DCHECK(IsGrey<mode>(markbit));
+    markbit.Clear<mode>();
+    markbit.Next().Clear<mode>();
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static void BlackToGrey(MarkBit markbit)) {
-    DCHECK(IsBlack(markbit));
-    markbit.Next().Clear();
+    DCHECK(IsBlack<mode>(markbit));
+    markbit.Next().Clear<mode>();
   }
 
-  INLINE(static void WhiteToGrey(MarkBit markbit)) {
-    DCHECK(IsWhite(markbit));
-    markbit.Set();
+  // The transitions below return false if another thread won the race for
+  // changing the color in ATOMIC mode. In NON_ATOMIC mode they always
+  // succeed.
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  INLINE(static bool WhiteToGrey(MarkBit markbit)) {
+    DCHECK(mode == MarkBit::ATOMIC || IsWhite(markbit));
+    return markbit.Set<mode>();
   }
 
-  INLINE(static void WhiteToBlack(MarkBit markbit)) {
-    DCHECK(IsWhite(markbit));
-    markbit.Set();
-    markbit.Next().Set();
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  INLINE(static bool WhiteToBlack(MarkBit markbit)) {
+    DCHECK(mode == MarkBit::ATOMIC || IsWhite(markbit));
+    if (!markbit.Set<mode>()) return false;
+    markbit.Next().Set<mode>();
+    return true;
   }
 
-  INLINE(static void GreyToBlack(MarkBit markbit)) {
-    DCHECK(IsGrey(markbit));
-    markbit.Next().Set();
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
+  INLINE(static bool GreyToBlack(MarkBit markbit)) {
+    DCHECK(mode == MarkBit::ATOMIC || IsGrey(markbit));
+    return markbit.Get<mode>() && markbit.Next().Set<mode>();
   }
 
+  template <MarkBit::AccessMode mode = MarkBit::NON_ATOMIC>
   INLINE(static void AnyToGrey(MarkBit markbit)) {
-    markbit.Set();
-    markbit.Next().Clear();
+    markbit.Set<mode>();
+    markbit.Next().Clear<mode>();
   }
 
   enum ObjectColor {
@@ -27,6 +27,7 @@ MemoryReducer::TimerTask::TimerTask(MemoryReducer* memory_reducer)
 
 void MemoryReducer::TimerTask::RunInternal() {
   Heap* heap = memory_reducer_->heap();
+  heap->SampleSystemMemoryPressure();
   Event event;
   double time_ms = heap->MonotonicallyIncreasingTimeInMs();
   heap->tracer()->SampleAllocation(time_ms, heap->NewSpaceAllocationCounter(),
@@ -65,6 +66,9 @@ void MemoryReducer::NotifyTimer(const Event& event) {
       heap()->isolate()->PrintWithTimestamp("Memory reducer: started GC #%d\n",
                                             state_.started_gcs);
     }
+    // The mutator is idle or in background. Pooled pages are returned to the
+    // OS by the unmapper tasks.
+    heap()->memory_allocator()->unmapper()->ReleaseCommittedPool();
     heap()->StartIdleIncrementalMarking(
         GarbageCollectionReason::kMemoryReducer);
   } else if (state_.action == kWait) {
@@ -101,6 +105,7 @@ void MemoryReducer::NotifyMarkCompact(const Event& event) {
     // If we are transitioning to the WAIT state, start the timer.
     ScheduleTimer(event.time_ms, state_.next_gc_start_ms - event.time_ms);
   }
+  UpdatePagePoolLimit();
   if (old_action == kRun) {
     if (FLAG_trace_gc_verbose) {
       heap()->isolate()->PrintWithTimestamp(
@@ -118,6 +123,22 @@ void MemoryReducer::NotifyPossibleGarbage(const Event& event) {
     // If we are transitioning to the WAIT state, start the timer.
     ScheduleTimer(event.time_ms, state_.next_gc_start_ms - event.time_ms);
   }
+  UpdatePagePoolLimit();
+}
+
+void MemoryReducer::UpdatePagePoolLimit() {
+  size_t limit = 0;
+  if (state_.action == kDone && !heap()->ShouldOptimizeForMemoryUsage()) {
+    limit = static_cast<size_t>(FLAG_page_pool_size) * MB / Page::kPageSize;
+  }
+  heap()->memory_allocator()->unmapper()->SetCommittedPoolLimit(limit);
+  if (FLAG_trace_gc_verbose) {
+    heap()->isolate()->PrintWithTimestamp(
+        "Memory reducer: page pool limit %" PRIuS " pages, pooled %" PRIuS
+        " KB\n",
+        limit,
+        heap()->memory_allocator()->unmapper()->CommittedPoolSize() / KB);
+  }
 }
 
 
@@ -142,6 +142,11 @@ class V8_EXPORT_PRIVATE MemoryReducer {
     return state_.action == kDone && state_.started_gcs > 0;
   }
 
+  // Sets the number of freed pages that the memory allocator keeps committed
+  // for reuse. Pages are only pooled while the memory reducer is not trying
+  // to shrink the heap.
+  void UpdatePagePoolLimit();
+
  private:
   class TimerTask : public v8::internal::CancelableTask {
    public:
@@ -416,6 +416,10 @@ void StaticMarkingVisitor<StaticVisitor>::VisitCode(Map* map,
   if (FLAG_age_code && !heap->isolate()->serializer_enabled()) {
     code->MakeOlder();
   }
+  if (FLAG_flush_bytecode && code->kind() == Code::OPTIMIZED_FUNCTION &&
+      heap->mark_compact_collector()->is_code_flushing_enabled()) {
+    MarkInlinedBytecode(heap, code);
+  }
   CodeBodyVisitor::Visit(map, object);
 }
 
@@ -442,6 +446,12 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfo(
       VisitSharedFunctionInfoWeakCode(map, object);
       return;
     }
+    if (IsBytecodeFlushable(heap, shared)) {
+      collector->code_flusher()->AddBytecodeCandidate(shared);
+      // Treat the reference to the bytecode array weakly.
+      VisitSharedFunctionInfoWeakBytecode(map, object);
+      return;
+    }
   }
   VisitSharedFunctionInfoStrongCode(map, object);
 }
@@ -454,7 +464,7 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSFunction(Map* map,
   JSFunction* function = JSFunction::cast(object);
   MarkCompactCollector* collector = heap->mark_compact_collector();
   if (collector->is_code_flushing_enabled()) {
-    if (IsFlushable(heap, function)) {
+    if (IsFlushable(heap, function) || IsBytecodeFlushable(heap, function)) {
       // This function's code looks flushable. But we have to postpone
       // the decision until we see all functions that point to the same
       // SharedFunctionInfo because some of them might be optimized.
@@ -467,7 +477,11 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSFunction(Map* map,
       return;
     } else {
       // Visit all unoptimized code objects to prevent flushing them.
-      StaticVisitor::MarkObject(heap, function->shared()->code());
+      SharedFunctionInfo* shared = function->shared();
+      StaticVisitor::MarkObject(heap, shared->code());
+      if (shared->HasBytecodeArray()) {
+        StaticVisitor::MarkObject(heap, shared->bytecode_array());
+      }
     }
   }
   VisitJSFunctionStrongCode(map, object);
@@ -606,6 +620,58 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
   return true;
 }
 
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsBytecodeFlushable(
+    Heap* heap, JSFunction* function) {
+  // Optimized functions may deoptimize to the bytecode.
+  if (function->code() != function->shared()->code()) {
+    return false;
+  }
+
+  return IsBytecodeFlushable(heap, function->shared());
+}
+
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsBytecodeFlushable(
+    Heap* heap, SharedFunctionInfo* shared_info) {
+  if (!FLAG_flush_bytecode || heap->isolate()->serializer_enabled()) {
+    return false;
+  }
+
+  if (!shared_info->HasBytecodeArray()) {
+    return false;
+  }
+
+  // Bytecode is either on stack or referenced by optimized code.
+  BytecodeArray* bytecode = shared_info->bytecode_array();
+  if (ObjectMarking::IsBlackOrGrey(bytecode)) {
+    return false;
+  }
+
+  // The bytecode age is reset whenever the function is entered and grows
+  // with every mark-compact in which the bytecode was visited.
+  if (bytecode->bytecode_age() < FLAG_bytecode_flush_age) {
+    return false;
+  }
+
+  return CodeFlusher::CanFlushBytecode(heap->isolate(), shared_info);
+}
+
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::MarkInlinedBytecode(Heap* heap,
+                                                              Code* code) {
+  FixedArray* raw_data = code->deoptimization_data();
+  if (raw_data->length() == 0) return;
+  DeoptimizationInputData* data = DeoptimizationInputData::cast(raw_data);
+  int count = data->InlinedFunctionCount()->value();
+  for (int i = DeoptimizationInputData::kNotInlinedIndex; i < count; i++) {
+    SharedFunctionInfo* shared = data->GetInlinedFunction(i);
+    if (shared->HasBytecodeArray()) {
+      StaticVisitor::MarkObject(heap, shared->bytecode_array());
+    }
+  }
+}
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoStrongCode(
     Map* map, HeapObject* object) {
@@ -623,6 +689,26 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakCode(
                    void>::Visit(map, object);
 }
 
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakBytecode(
+    Map* map, HeapObject* object) {
+  // Skip visiting kFunctionDataOffset as it is treated weakly here. The slot
+  // is recorded when the candidate is processed.
+  STATIC_ASSERT(SharedFunctionInfo::kScriptOffset ==
+                SharedFunctionInfo::kFunctionDataOffset + kPointerSize);
+  Heap* heap = map->GetHeap();
+  StaticVisitor::VisitPointers(
+      heap, object,
+      HeapObject::RawField(object, SharedFunctionInfo::kCodeOffset),
+      HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset));
+  StaticVisitor::VisitPointers(
+      heap, object,
+      HeapObject::RawField(object, SharedFunctionInfo::kScriptOffset),
+      HeapObject::RawField(object,
+                           SharedFunctionInfo::kLastPointerFieldOffset +
+                               kPointerSize));
+}
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitJSFunctionStrongCode(
     Map* map, HeapObject* object) {
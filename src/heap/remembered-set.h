@@ -101,8 +101,9 @@ class RememberedSet : public AllStatic {
   // The callback should take (Address slot) and return SlotCallbackResult.
   template <typename Callback>
   static void Iterate(Heap* heap, Callback callback) {
-    IterateMemoryChunks(
-        heap, [callback](MemoryChunk* chunk) { Iterate(chunk, callback); });
+    IterateMemoryChunks(heap, [callback](MemoryChunk* chunk) {
+      Iterate(chunk, callback, SlotSet::PREFREE_EMPTY_BUCKETS);
+    });
   }
 
   // Iterates over all memory chunks that contains non-empty slot sets.
@@ -122,16 +123,17 @@ class RememberedSet : public AllStatic {
 
   // Iterates and filters the remembered set in the given memory chunk with
   // the given callback. The callback should take (Address slot) and return
-  // SlotCallbackResult.
+  // SlotCallbackResult. Iterations that may run concurrently with insertions
+  // into the same chunk have to use SlotSet::KEEP_EMPTY_BUCKETS.
   template <typename Callback>
-  static void Iterate(MemoryChunk* chunk, Callback callback) {
+  static void Iterate(MemoryChunk* chunk, Callback callback,
+                      SlotSet::EmptyBucketMode mode) {
     SlotSet* slots = GetSlotSet(chunk);
     if (slots != nullptr) {
       size_t pages = (chunk->size() + Page::kPageSize - 1) / Page::kPageSize;
       int new_count = 0;
       for (size_t page = 0; page < pages; page++) {
-        new_count +=
-            slots[page].Iterate(callback, SlotSet::PREFREE_EMPTY_BUCKETS);
+        new_count += slots[page].Iterate(callback, mode);
       }
       // Only old-to-old slot sets are released eagerly. Old-new-slot sets are
       // released by the sweeper threads.
@@ -13,6 +13,17 @@ namespace internal {
 void Scavenger::ScavengeObject(HeapObject** p, HeapObject* object) {
   DCHECK(object->GetIsolate()->heap()->InFromSpace(object));
 
+  if (FLAG_young_large_objects) {
+    Heap* heap = object->GetHeap();
+    if (heap->lo_space()->Contains(object)) {
+      // Large objects are promoted in place, so the slot stays valid.
+      if (heap->lo_space()->PromoteYoungObject(object)) {
+        heap->promotion_queue()->insert(object, object->Size(), true);
+      }
+      return;
+    }
+  }
+
   // We use the first word (where the map pointer usually is) of a heap
   // object to record the forwarding pointer.  A forwarding pointer can
   // point to an old space, the code space, or the to space of the new
@@ -29,7 +40,7 @@ void Scavenger::ScavengeObject(HeapObject** p, HeapObject* object) {
   }
 
   object->GetHeap()->UpdateAllocationSite<Heap::kGlobal>(
-      object, object->GetHeap()->global_pretenuring_feedback_);
+      object->map(), object, object->GetHeap()->global_pretenuring_feedback_);
 
   // AllocationMementos are unrooted and shouldn't survive a scavenge
   DCHECK(object->map() != object->GetHeap()->allocation_memento_map());
@@ -61,6 +72,171 @@ SlotCallbackResult Scavenger::CheckAndScavengeObject(Heap* heap,
   return REMOVE_SLOT;
 }
 
+// static
+bool ParallelScavenger::ContainsOnlyData(int visitor_id) {
+  switch (visitor_id) {
+    case StaticVisitorBase::kVisitSeqOneByteString:
+    case StaticVisitorBase::kVisitSeqTwoByteString:
+    case StaticVisitorBase::kVisitByteArray:
+    case StaticVisitorBase::kVisitFixedDoubleArray:
+      return true;
+    default:
+      break;
+  }
+  return visitor_id >= StaticVisitorBase::kVisitDataObject &&
+         visitor_id <= StaticVisitorBase::kVisitDataObjectGeneric;
+}
+
+bool ParallelScavenger::MigrateObject(Map* map, HeapObject* source,
+                                      HeapObject* target, int size) {
+  // Copy the content of source to target. The map word is written last so
+  // that the copy is only published once it is complete.
+  heap()->CopyBlock(target->address() + kPointerSize,
+                    source->address() + kPointerSize, size - kPointerSize);
+  target->set_map_word(MapWord::FromMap(map));
+
+  // Try to set the forwarding address. Another task may have copied the
+  // object in the meantime.
+  return source->synchronized_compare_and_swap_map_word(
+      MapWord::FromMap(map), MapWord::FromForwardingAddress(target));
+}
+
+bool ParallelScavenger::SemiSpaceCopyObject(Map* map, HeapObject** slot,
+                                            HeapObject* object,
+                                            int object_size,
+                                            AllocationAlignment alignment) {
+  AllocationResult allocation =
+      allocator_.Allocate(NEW_SPACE, object_size, alignment);
+
+  HeapObject* target = NULL;  // Initialization to please compiler.
+  if (allocation.To(&target)) {
+    if (!MigrateObject(map, object, target, object_size)) {
+      allocator_.FreeLast(NEW_SPACE, target, object_size);
+      *slot = object->synchronized_map_word().ToForwardingAddress();
+      return true;
+    }
+    heap()->UpdateAllocationSite<Heap::kCached>(map, object,
+                                                &local_pretenuring_feedback_);
+    *slot = target;
+    if (!ContainsOnlyData(map->visitor_id())) {
+      copied_list_->Push(task_id_, ObjectAndSize(target, object_size));
+    }
+    copied_size_ += object_size;
+    return true;
+  }
+  return false;
+}
+
+bool ParallelScavenger::PromoteObject(Map* map, HeapObject** slot,
+                                      HeapObject* object, int object_size,
+                                      AllocationAlignment alignment) {
+  AllocationResult allocation =
+      allocator_.Allocate(OLD_SPACE, object_size, alignment);
+
+  HeapObject* target = NULL;  // Initialization to please compiler.
+  if (allocation.To(&target)) {
+    if (!MigrateObject(map, object, target, object_size)) {
+      allocator_.FreeLast(OLD_SPACE, target, object_size);
+      *slot = object->synchronized_map_word().ToForwardingAddress();
+      return true;
+    }
+    heap()->UpdateAllocationSite<Heap::kCached>(map, object,
+                                                &local_pretenuring_feedback_);
+
+    // Update slot to new target using CAS. A concurrent sweeper thread my
+    // filter the slot concurrently.
+    HeapObject* old = *slot;
+    base::Release_CompareAndSwap(reinterpret_cast<base::AtomicWord*>(slot),
+                                 reinterpret_cast<base::AtomicWord>(old),
+                                 reinterpret_cast<base::AtomicWord>(target));
+
+    if (!ContainsOnlyData(map->visitor_id())) {
+      copied_list_->Push(task_id_, ObjectAndSize(target, object_size));
+    }
+    promoted_size_ += object_size;
+    return true;
+  }
+  return false;
+}
+
+void ParallelScavenger::EvacuateObject(HeapObject** slot, Map* map,
+                                       HeapObject* source) {
+  SLOW_DCHECK(heap()->InFromSpace(source));
+  // AllocationMementos are unrooted and shouldn't survive a scavenge
+  DCHECK(map != heap()->allocation_memento_map());
+  int size = source->SizeFromMap(map);
+  AllocationAlignment alignment = kWordAligned;
+  if (map->visitor_id() == StaticVisitorBase::kVisitFixedDoubleArray ||
+      map->visitor_id() == StaticVisitorBase::kVisitFixedFloat64Array) {
+    alignment = kDoubleAligned;
+  }
+
+  if (!heap()->ShouldBePromoted(source->address(), size)) {
+    // A semi-space copy may fail due to fragmentation. In that case, we
+    // try to promote the object.
+    if (SemiSpaceCopyObject(map, slot, source, size, alignment)) return;
+  }
+
+  if (PromoteObject(map, slot, source, size, alignment)) return;
+
+  // If promotion failed, we try to copy the object to the other semi-space
+  if (SemiSpaceCopyObject(map, slot, source, size, alignment)) return;
+
+  FatalProcessOutOfMemory("Scavenger: semi-space copy\n");
+}
+
+void ParallelScavenger::ScavengeObject(HeapObject** p, HeapObject* object) {
+  DCHECK(heap()->InFromSpace(object));
+
+  if (FLAG_young_large_objects && heap()->lo_space()->Contains(object)) {
+    // Large objects are promoted in place, so the slot stays valid. Only the
+    // task that promotes the object visits it.
+    if (heap()->lo_space()->PromoteYoungObject(object) &&
+        !ContainsOnlyData(object->map()->visitor_id())) {
+      copied_list_->Push(task_id_, ObjectAndSize(object, object->Size()));
+    }
+    return;
+  }
+
+  // Other tasks may be installing a forwarding address concurrently, so the
+  // map word is read exactly once.
+  MapWord first_word = object->synchronized_map_word();
+
+  // If the first word is a forwarding address, the object has already been
+  // copied.
+  if (first_word.IsForwardingAddress()) {
+    HeapObject* dest = first_word.ToForwardingAddress();
+    DCHECK(heap()->InFromSpace(*p));
+    *p = dest;
+    return;
+  }
+
+  EvacuateObject(p, first_word.ToMap(), object);
+}
+
+SlotCallbackResult ParallelScavenger::CheckAndScavengeObject(
+    Address slot_address) {
+  Object** slot = reinterpret_cast<Object**>(slot_address);
+  Object* object = *slot;
+  if (heap()->InFromSpace(object)) {
+    HeapObject* heap_object = reinterpret_cast<HeapObject*>(object);
+    DCHECK(heap_object->IsHeapObject());
+    ScavengeObject(reinterpret_cast<HeapObject**>(slot), heap_object);
+    object = *slot;
+  }
+  // Unlike the sequential scavenger, slots that already point to to space
+  // are kept: they may have been recorded concurrently by another task that
+  // promoted the object containing the slot.
+  return heap()->InToSpace(object) ? KEEP_SLOT : REMOVE_SLOT;
+}
+
+void ParallelScavengeVisitor::ScavengePointer(Object** p) {
+  Object* object = *p;
+  if (!scavenger_->heap()->InNewSpace(object)) return;
+  scavenger_->ScavengeObject(reinterpret_cast<HeapObject**>(p),
+                             reinterpret_cast<HeapObject*>(object));
+}
+
 // static
 void StaticScavengeVisitor::VisitPointer(Heap* heap, HeapObject* obj,
                                          Object** p) {
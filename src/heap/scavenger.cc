@@ -5,9 +5,13 @@
 #include "src/heap/scavenger.h"
 
 #include "src/contexts.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
+#include "src/heap/mark-compact-inl.h"
 #include "src/heap/objects-visiting-inl.h"
+#include "src/heap/page-parallel-job.h"
+#include "src/heap/remembered-set.h"
 #include "src/heap/scavenger-inl.h"
 #include "src/isolate.h"
 #include "src/log.h"
@@ -409,12 +413,16 @@ void Scavenger::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
 }
 
 
+bool Scavenger::IsLoggingOrProfiling() {
+  return FLAG_verify_predictable || isolate()->logger()->is_logging() ||
+         isolate()->is_profiling() ||
+         (isolate()->heap_profiler() != NULL &&
+          isolate()->heap_profiler()->is_tracking_object_moves());
+}
+
+
 void Scavenger::SelectScavengingVisitorsTable() {
-  bool logging_and_profiling =
-      FLAG_verify_predictable || isolate()->logger()->is_logging() ||
-      isolate()->is_profiling() ||
-      (isolate()->heap_profiler() != NULL &&
-       isolate()->heap_profiler()->is_tracking_object_moves());
+  bool logging_and_profiling = IsLoggingOrProfiling();
 
   if (!heap()->incremental_marking()->IsMarking()) {
     if (!logging_and_profiling) {
@@ -458,6 +466,210 @@ void Scavenger::SelectScavengingVisitorsTable() {
 Isolate* Scavenger::isolate() { return heap()->isolate(); }
 
 
+int Scavenger::NumberOfScavengeTasks() {
+  // The number of tasks is limited by:
+  // - the capacity of new space, using one task per MB
+  // - kMaxScavengerTasks
+  // - #cores
+  const int num_scavenge_tasks =
+      static_cast<int>(heap()->new_space()->TotalCapacity()) / MB;
+  return Max(
+      1, Min(Min(num_scavenge_tasks, kMaxScavengerTasks),
+             static_cast<int>(V8::GetCurrentPlatform()
+                                  ->NumberOfAvailableBackgroundThreads())));
+}
+
+
+bool Scavenger::CanScavengeInParallel() {
+  // The parallel scavenger neither transfers incremental marking colors nor
+  // reports object moves.
+  return FLAG_parallel_scavenge &&
+         !heap()->incremental_marking()->IsMarking() &&
+         !IsLoggingOrProfiling() && NumberOfScavengeTasks() > 1;
+}
+
+
+class ScavengingJobTraits {
+ public:
+  typedef int PerPageData;  // Per page data is not used in this job.
+  typedef ParallelScavenger* PerTaskData;
+
+  static const bool NeedSequentialFinalization = false;
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData scavenger,
+                                    MemoryChunk* chunk, PerPageData) {
+    scavenger->ScavengePage(chunk);
+    scavenger->Process();
+    return true;
+  }
+
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool,
+                                       PerPageData) {}
+};
+
+
+void Scavenger::ScavengeInParallel() {
+  const int num_tasks = NumberOfScavengeTasks();
+  ParallelScavenger::CopiedList copied_list;
+  ParallelScavenger* scavengers[kMaxScavengerTasks];
+  for (int i = 0; i < num_tasks; i++) {
+    scavengers[i] = new ParallelScavenger(heap(), &copied_list, i);
+  }
+  // Roots are visited on the main thread using the scavenger of task 0.
+  ParallelScavengeVisitor root_visitor(scavengers[0]);
+
+  {
+    // Copy roots.
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+    heap()->IterateRoots(&root_visitor, VISIT_ALL_IN_SCAVENGE);
+  }
+
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::SCAVENGER_WEAK);
+    // Copy objects reachable from the encountered weak collections list.
+    root_visitor.VisitPointer(&heap()->encountered_weak_collections_);
+  }
+
+  {
+    // Copy objects reachable from the code flushing candidates list.
+    TRACE_GC(heap()->tracer(),
+             GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
+    MarkCompactCollector* collector = heap()->mark_compact_collector();
+    if (collector->is_code_flushing_enabled()) {
+      collector->code_flusher()->IteratePointersToFromSpace(&root_visitor);
+    }
+  }
+
+  // Make the objects copied from roots available to all tasks.
+  copied_list.FlushToGlobal(0);
+
+  {
+    // Copy objects reachable from the old generation. Each task processes
+    // a set of pages and afterwards helps with the transitive closure.
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
+    PageParallelJob<ScavengingJobTraits> job(
+        heap(), isolate()->cancelable_task_manager(),
+        &page_parallel_job_semaphore_);
+    RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+        heap(), [&job](MemoryChunk* chunk) { job.AddPage(chunk, 0); });
+    job.Run(num_tasks, [&scavengers](int i) { return scavengers[i]; });
+  }
+
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
+    scavengers[0]->Process();
+  }
+
+  isolate()->global_handles()->MarkNewSpaceWeakUnmodifiedObjectsPending(
+      &Heap::IsUnscavengedHeapObject);
+  isolate()
+      ->global_handles()
+      ->IterateNewSpaceWeakUnmodifiedRoots<
+          GlobalHandles::HANDLE_PHANTOM_NODES_VISIT_OTHERS>(&root_visitor);
+  scavengers[0]->Process();
+  DCHECK(copied_list.IsGlobalEmpty());
+
+  for (int i = 0; i < num_tasks; i++) {
+    scavengers[i]->Finalize();
+    delete scavengers[i];
+  }
+}
+
+
+ParallelScavenger::ParallelScavenger(Heap* heap, CopiedList* copied_list,
+                                     int task_id)
+    : heap_(heap),
+      copied_list_(copied_list),
+      task_id_(task_id),
+      allocator_(heap),
+      local_pretenuring_feedback_(kInitialLocalPretenuringFeedbackCapacity),
+      copied_size_(0),
+      promoted_size_(0) {
+  DCHECK_LT(task_id, CopiedList::kMaxNumTasks);
+}
+
+
+void ParallelScavenger::ScavengePage(MemoryChunk* page) {
+  // Other tasks may insert slots into the same page while it is processed
+  // here, so empty buckets must not be freed.
+  RememberedSet<OLD_TO_NEW>::Iterate(
+      page,
+      [this](Address addr) { return CheckAndScavengeObject(addr); },
+      SlotSet::KEEP_EMPTY_BUCKETS);
+  RememberedSet<OLD_TO_NEW>::IterateTyped(
+      page, [this](SlotType type, Address host_addr, Address addr) {
+        return UpdateTypedSlotHelper::UpdateTypedSlot(
+            heap()->isolate(), type, addr, [this](Object** addr) {
+              return CheckAndScavengeObject(reinterpret_cast<Address>(addr));
+            });
+      });
+}
+
+
+void ParallelScavenger::Process() {
+  ObjectAndSize object_and_size;
+  while (copied_list_->Pop(task_id_, &object_and_size)) {
+    IterateAndScavengeObject(object_and_size.first, object_and_size.second);
+  }
+}
+
+
+void ParallelScavenger::Finalize() {
+  heap()->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
+  heap()->IncrementSemiSpaceCopiedObjectSize(copied_size_);
+  heap()->IncrementPromotedObjectsSize(promoted_size_);
+  allocator_.Finalize();
+}
+
+
+class IterateAndScavengeCopiedObjectsVisitor final : public ObjectVisitor {
+ public:
+  IterateAndScavengeCopiedObjectsVisitor(ParallelScavenger* scavenger,
+                                         HeapObject* target, bool record_slots)
+      : scavenger_(scavenger),
+        chunk_(MemoryChunk::FromAddress(target->address())),
+        record_slots_(record_slots) {}
+
+  inline void VisitPointers(Object** start, Object** end) override {
+    Heap* heap = scavenger_->heap();
+    for (Object** slot = start; slot < end; slot++) {
+      Object* target = *slot;
+      if (!heap->InFromSpace(target)) continue;
+      scavenger_->ScavengeObject(reinterpret_cast<HeapObject**>(slot),
+                                 HeapObject::cast(target));
+      target = *slot;
+      if (record_slots_ && heap->InNewSpace(target)) {
+        SLOW_DCHECK(heap->InToSpace(target));
+        // Slots of large objects may lie beyond the first page of their
+        // chunk, so the chunk of the target is used.
+        RememberedSet<OLD_TO_NEW>::Insert(chunk_,
+                                          reinterpret_cast<Address>(slot));
+      }
+    }
+  }
+
+ private:
+  ParallelScavenger* const scavenger_;
+  MemoryChunk* const chunk_;
+  // Slots are only recorded for objects that have been promoted.
+  const bool record_slots_;
+};
+
+
+void ParallelScavenger::IterateAndScavengeObject(HeapObject* target,
+                                                 int size) {
+  IterateAndScavengeCopiedObjectsVisitor visitor(this, target,
+                                                 !heap()->InNewSpace(target));
+  if (target->IsJSFunction()) {
+    // JSFunctions reachable through kNextFunctionLinkOffset are weak. Slots
+    // for these links are recorded during processing of weak lists.
+    JSFunction::BodyDescriptorWeakCode::IterateBody(target, size, &visitor);
+  } else {
+    target->IterateBody(target->map()->instance_type(), size, &visitor);
+  }
+}
+
+
 void ScavengeVisitor::VisitPointer(Object** p) { ScavengePointer(p); }
 
 
@@ -467,6 +679,14 @@ void ScavengeVisitor::VisitPointers(Object** start, Object** end) {
 }
 
 
+void ParallelScavengeVisitor::VisitPointer(Object** p) { ScavengePointer(p); }
+
+
+void ParallelScavengeVisitor::VisitPointers(Object** start, Object** end) {
+  for (Object** p = start; p < end; p++) ScavengePointer(p);
+}
+
+
 void ScavengeVisitor::ScavengePointer(Object** p) {
   Object* object = *p;
   if (!heap_->InNewSpace(object)) return;
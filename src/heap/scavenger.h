@@ -5,8 +5,13 @@
 #ifndef V8_HEAP_SCAVENGER_H_
 #define V8_HEAP_SCAVENGER_H_
 
+#include <utility>
+
+#include "src/base/platform/semaphore.h"
+#include "src/heap/local-allocator.h"
 #include "src/heap/objects-visiting.h"
 #include "src/heap/slot-set.h"
+#include "src/heap/worklist.h"
 
 namespace v8 {
 namespace internal {
@@ -16,7 +21,10 @@ typedef void (*ScavengingCallback)(Map* map, HeapObject** slot,
 
 class Scavenger {
  public:
-  explicit Scavenger(Heap* heap) : heap_(heap) {}
+  static const int kMaxScavengerTasks = 8;
+
+  explicit Scavenger(Heap* heap)
+      : heap_(heap), page_parallel_job_semaphore_(0) {}
 
   // Initializes static visitor dispatch tables.
   static void Initialize();
@@ -36,12 +44,97 @@ class Scavenger {
   // of the heap (i.e. incremental marking, logging and profiling).
   void SelectScavengingVisitorsTable();
 
+  // Returns true if the upcoming scavenge can be performed by parallel tasks.
+  // Incremental marking and logging or profiling of object moves require the
+  // sequential scavenging visitors.
+  bool CanScavengeInParallel();
+
+  // Performs the transitive closure of a scavenge, i.e., everything between
+  // flipping the semispaces and processing weak references, using up to
+  // NumberOfScavengeTasks() tasks including the main thread.
+  void ScavengeInParallel();
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
  private:
+  bool IsLoggingOrProfiling();
+  int NumberOfScavengeTasks();
+
   Heap* heap_;
   VisitorDispatchTable<ScavengingCallback> scavenging_visitors_table_;
+  // PageParallelJob requires a semaphore that lives as long as the isolate.
+  base::Semaphore page_parallel_job_semaphore_;
+};
+
+// Task-local scavenger used by parallel scavenges (--parallel_scavenge).
+// Objects are copied through a LocalAllocator, i.e., into a task-local LAB in
+// to-space or into a task-local compaction space when promoted. Tasks may race
+// for the same object. The forwarding address is installed with a
+// compare-and-swap on the map word and the losing task gives back its copy.
+// Copied objects that contain pointers are pushed onto a worklist shared by
+// all tasks.
+class ParallelScavenger {
+ public:
+  typedef std::pair<HeapObject*, int> ObjectAndSize;
+  typedef Worklist<ObjectAndSize, 64> CopiedList;
+
+  ParallelScavenger(Heap* heap, CopiedList* copied_list, int task_id);
+
+  // Scavenges an object |object| referenced from slot |p|. |object| is
+  // required to be in from space.
+  inline void ScavengeObject(HeapObject** p, HeapObject* object);
+
+  // Potentially scavenges an object referenced from |slot_address| if it is
+  // indeed a HeapObject and resides in from space.
+  inline SlotCallbackResult CheckAndScavengeObject(Address slot_address);
+
+  // Scavenges all objects referenced from the old-to-new remembered set of
+  // the given page.
+  void ScavengePage(MemoryChunk* page);
+
+  // Visits copied objects until both the local part of the worklist and the
+  // global pool are empty.
+  void Process();
+
+  // Merges locally cached data back into the heap. Needs to be called from
+  // the main thread after all tasks finished.
+  void Finalize();
+
+  // Visits the body of a copied object and scavenges the objects it refers
+  // to. Slots of promoted objects pointing to new space are recorded.
+  void IterateAndScavengeObject(HeapObject* target, int size);
+
+  Heap* heap() { return heap_; }
+
+ private:
+  static const int kInitialLocalPretenuringFeedbackCapacity = 256;
+
+  static inline bool ContainsOnlyData(int visitor_id);
+
+  inline void EvacuateObject(HeapObject** slot, Map* map, HeapObject* source);
+
+  inline bool SemiSpaceCopyObject(Map* map, HeapObject** slot,
+                                  HeapObject* object, int object_size,
+                                  AllocationAlignment alignment);
+
+  inline bool PromoteObject(Map* map, HeapObject** slot, HeapObject* object,
+                            int object_size, AllocationAlignment alignment);
+
+  // Copies |source| to |target| and tries to install the forwarding address.
+  // Returns false if another task has already copied |source|.
+  inline bool MigrateObject(Map* map, HeapObject* source, HeapObject* target,
+                            int size);
+
+  Heap* const heap_;
+  CopiedList* const copied_list_;
+  const int task_id_;
+  LocalAllocator allocator_;
+  base::HashMap local_pretenuring_feedback_;
+  size_t copied_size_;
+  size_t promoted_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavenger);
 };
 
 
@@ -61,6 +154,23 @@ class ScavengeVisitor : public ObjectVisitor {
 };
 
 
+// Helper class for turning a parallel scavenger into an object visitor for
+// roots, filtering out non-HeapObjects and objects not in new space.
+class ParallelScavengeVisitor : public ObjectVisitor {
+ public:
+  explicit ParallelScavengeVisitor(ParallelScavenger* scavenger)
+      : scavenger_(scavenger) {}
+
+  void VisitPointer(Object** p) override;
+  void VisitPointers(Object** start, Object** end) override;
+
+ private:
+  inline void ScavengePointer(Object** p);
+
+  ParallelScavenger* scavenger_;
+};
+
+
 // Helper class for turning the scavenger into an object visitor that is also
 // filtering out non-HeapObjects and objects which do not reside in new space.
 class StaticScavengeVisitor
@@ -50,15 +50,20 @@ class SlotSet : public Malloced {
   void SetPageStart(Address page_start) { page_start_ = page_start; }
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
-  // This method should only be called on the main thread because concurrent
-  // allocation of the bucket is not thread-safe.
+  // Buckets are installed with a compare-and-swap, so concurrent insertions
+  // (e.g. from parallel scavenging tasks) are safe. Concurrent insertion and
+  // iteration is only safe if the iteration keeps empty buckets.
   void Insert(int slot_offset) {
     int bucket_index, cell_index, bit_index;
     SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
     base::AtomicValue<uint32_t>* current_bucket = bucket[bucket_index].Value();
     if (current_bucket == nullptr) {
       current_bucket = AllocateBucket();
-      bucket[bucket_index].SetValue(current_bucket);
+      if (!bucket[bucket_index].TrySetValue(nullptr, current_bucket)) {
+        // Another thread installed a bucket in the meantime.
+        DeleteArray<base::AtomicValue<uint32_t>>(current_bucket);
+        current_bucket = bucket[bucket_index].Value();
+      }
     }
     if (!(current_bucket[cell_index].Value() & (1u << bit_index))) {
       current_bucket[cell_index].SetBit(bit_index);
@@ -301,7 +301,7 @@ void Page::MarkNeverAllocateForTesting() {
 
 void Page::MarkEvacuationCandidate() {
   DCHECK(!IsFlagSet(NEVER_EVACUATE));
-  DCHECK_NULL(old_to_old_slots_);
+  DCHECK_NULL(old_to_old_slots_.Value());
   DCHECK_NULL(typed_old_to_old_slots_);
   SetFlag(EVACUATION_CANDIDATE);
   reinterpret_cast<PagedSpace*>(owner())->free_list()->EvictFreeListItems(this);
@@ -309,7 +309,7 @@ void Page::MarkEvacuationCandidate() {
 
 void Page::ClearEvacuationCandidate() {
   if (!IsFlagSet(COMPACTION_WAS_ABORTED)) {
-    DCHECK_NULL(old_to_old_slots_);
+    DCHECK_NULL(old_to_old_slots_.Value());
     DCHECK_NULL(typed_old_to_old_slots_);
   }
   ClearFlag(EVACUATION_CANDIDATE);
@@ -431,7 +431,8 @@ AllocationResult PagedSpace::AllocateRawUnaligned(
     if (object == NULL) {
       object = SlowAllocateRaw(size_in_bytes);
     }
-    if (object != NULL && heap()->incremental_marking()->black_allocation()) {
+    if (object != NULL &&
+        heap()->incremental_marking()->black_allocation_in(identity())) {
       Address start = object->address();
       Address end = object->address() + size_in_bytes;
       Page::FromAllocationAreaAddress(start)->CreateBlackArea(start, end);
@@ -474,7 +475,7 @@ AllocationResult PagedSpace::AllocateRawAligned(int size_in_bytes,
       object = SlowAllocateRaw(allocation_size);
     }
     if (object != NULL) {
-      if (heap()->incremental_marking()->black_allocation()) {
+      if (heap()->incremental_marking()->black_allocation_in(identity())) {
         Address start = object->address();
         Address end = object->address() + allocation_size;
         Page::FromAllocationAreaAddress(start)->CreateBlackArea(start, end);
@@ -643,6 +644,17 @@ bool LocalAllocationBuffer::TryMerge(LocalAllocationBuffer* other) {
   return false;
 }
 
+bool LocalAllocationBuffer::TryFreeLast(HeapObject* object, int object_size) {
+  if (IsValid()) {
+    const Address object_address = object->address();
+    if ((allocation_info_.top() - object_size) == object_address) {
+      allocation_info_.set_top(object_address);
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace internal
 }  // namespace v8
 
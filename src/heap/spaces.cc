@@ -117,9 +117,12 @@ bool CodeRange::SetUp(size_t requested) {
 
   DCHECK(!kRequiresCodeRange || requested <= kMaximalCodeRangeSize);
 
-  code_range_ = new base::VirtualMemory(
-      requested, Max(kCodeRangeAreaAlignment,
-                     static_cast<size_t>(base::OS::AllocateAlignment())));
+  size_t alignment = Max(kCodeRangeAreaAlignment,
+                         static_cast<size_t>(base::OS::AllocateAlignment()));
+  if (FLAG_huge_pages) {
+    alignment = Max(alignment, base::OS::HugePageSize());
+  }
+  code_range_ = new base::VirtualMemory(requested, alignment);
   CHECK(code_range_ != NULL);
   if (!code_range_->IsReserved()) {
     delete code_range_;
@@ -328,6 +331,11 @@ void MemoryAllocator::TearDown() {
     last_chunk_.Release();
   }
 
+  for (Address chunk : huge_page_region_chunks_) {
+    base::VirtualMemory::ReleaseRegion(chunk, MemoryChunk::kPageSize);
+  }
+  huge_page_region_chunks_.clear();
+
   delete code_range_;
   code_range_ = nullptr;
 }
@@ -358,6 +366,15 @@ void MemoryAllocator::Unmapper::FreeQueuedChunks() {
   }
 }
 
+void MemoryAllocator::Unmapper::ReleaseCommittedPool() {
+  SetCommittedPoolLimit(0);
+  MemoryChunk* chunk = nullptr;
+  while ((chunk = GetMemoryChunkSafe<kPooledCommitted>()) != nullptr) {
+    AddMemoryChunkSafe<kRegular>(chunk);
+  }
+  FreeQueuedChunks();
+}
+
 bool MemoryAllocator::Unmapper::WaitUntilCompleted() {
   bool waited = false;
   while (concurrent_unmapping_tasks_active_ > 0) {
@@ -373,6 +390,10 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks() {
   MemoryChunk* chunk = nullptr;
   // Regular chunks.
   while ((chunk = GetMemoryChunkSafe<kRegular>()) != nullptr) {
+    if (mode == MemoryAllocator::Unmapper::FreeMode::kUncommitPooled &&
+        TryAddToCommittedPoolSafe(chunk)) {
+      continue;
+    }
     bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
     allocator_->PerformFreeMemory(chunk);
     if (pooled) AddMemoryChunkSafe<kPooled>(chunk);
@@ -384,6 +405,9 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks() {
     while ((chunk = GetMemoryChunkSafe<kPooled>()) != nullptr) {
       allocator_->Free<MemoryAllocator::kAlreadyPooled>(chunk);
     }
+    while ((chunk = GetMemoryChunkSafe<kPooledCommitted>()) != nullptr) {
+      allocator_->Free<MemoryAllocator::kAlreadyPooled>(chunk);
+    }
   }
   // Non-regular chunks.
   while ((chunk = GetMemoryChunkSafe<kNonRegular>()) != nullptr) {
@@ -426,10 +450,25 @@ bool MemoryAllocator::CommitMemory(Address base, size_t size,
                                          executable == EXECUTABLE)) {
     return false;
   }
+  AdviseHugePages(base, size);
   UpdateAllocatedSpaceLimits(base, base + size);
   return true;
 }
 
+void MemoryAllocator::AdviseHugePages(Address base, size_t size) {
+  if (!FLAG_huge_pages) return;
+  // Committing remaps the region, which drops earlier advice. Uncommitting,
+  // e.g., pooled pages in the Unmapper, splits huge pages and returns the
+  // memory to the OS as before.
+  base::OS::AdviseHugePages(base, size);
+}
+
+size_t MemoryAllocator::HugePageBackedMemory() {
+  if (!FLAG_huge_pages) return 0;
+  return base::OS::HugePageBackedBytes(lowest_ever_allocated_.Value(),
+                                       highest_ever_allocated_.Value());
+}
+
 
 void MemoryAllocator::FreeMemory(base::VirtualMemory* reservation,
                                  Executability executable) {
@@ -471,12 +510,46 @@ Address MemoryAllocator::ReserveAlignedMemory(size_t size, size_t alignment,
   return base;
 }
 
+Address MemoryAllocator::ReserveHugePageRegionChunk(
+    base::VirtualMemory* controller) {
+  const size_t region_size = base::OS::HugePageSize();
+  DCHECK_EQ(0u, region_size % MemoryChunk::kPageSize);
+  base::LockGuard<base::Mutex> guard(&huge_page_region_mutex_);
+  if (huge_page_region_chunks_.empty()) {
+    base::VirtualMemory region(region_size, region_size);
+    if (!region.IsReserved()) return NULL;
+    Address region_start = static_cast<Address>(region.address());
+    // Chunks are released individually, so the region itself is not
+    // controlled by any VirtualMemory object.
+    region.Reset();
+    for (size_t offset = region_size; offset > 0;
+         offset -= MemoryChunk::kPageSize) {
+      huge_page_region_chunks_.push_back(region_start + offset -
+                                         MemoryChunk::kPageSize);
+    }
+  }
+  Address chunk = huge_page_region_chunks_.back();
+  huge_page_region_chunks_.pop_back();
+  size_.Increment(MemoryChunk::kPageSize);
+  base::VirtualMemory reservation(chunk, MemoryChunk::kPageSize);
+  controller->TakeControl(&reservation);
+  return chunk;
+}
+
 Address MemoryAllocator::AllocateAlignedMemory(
     size_t reserve_size, size_t commit_size, size_t alignment,
     Executability executable, base::VirtualMemory* controller) {
   DCHECK(commit_size <= reserve_size);
   base::VirtualMemory reservation;
-  Address base = ReserveAlignedMemory(reserve_size, alignment, &reservation);
+  Address base = NULL;
+  if (FLAG_huge_pages && executable == NOT_EXECUTABLE &&
+      reserve_size == MemoryChunk::kPageSize &&
+      base::OS::HugePageSize() >= MemoryChunk::kPageSize) {
+    base = ReserveHugePageRegionChunk(&reservation);
+  }
+  if (base == NULL) {
+    base = ReserveAlignedMemory(reserve_size, alignment, &reservation);
+  }
   if (base == NULL) return NULL;
 
   if (executable == EXECUTABLE) {
@@ -486,6 +559,7 @@ Address MemoryAllocator::AllocateAlignedMemory(
     }
   } else {
     if (reservation.Commit(base, commit_size, false)) {
+      AdviseHugePages(base, commit_size);
       UpdateAllocatedSpaceLimits(base, base + commit_size);
     } else {
       base = NULL;
@@ -528,7 +602,7 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap, Address base, size_t size,
   chunk->set_owner(owner);
   chunk->InitializeReservedMemory();
   chunk->old_to_new_slots_.SetValue(nullptr);
-  chunk->old_to_old_slots_ = nullptr;
+  chunk->old_to_old_slots_.SetValue(nullptr);
   chunk->typed_old_to_new_slots_.SetValue(nullptr);
   chunk->typed_old_to_old_slots_ = nullptr;
   chunk->skip_list_ = nullptr;
@@ -850,12 +924,13 @@ size_t Page::ShrinkToHighWaterMark() {
 }
 
 void Page::CreateBlackArea(Address start, Address end) {
-  DCHECK(heap()->incremental_marking()->black_allocation());
+  DCHECK(heap()->incremental_marking()->black_allocation_in(
+      owner()->identity()));
   DCHECK_EQ(Page::FromAddress(start), this);
   DCHECK_NE(start, end);
   DCHECK_EQ(Page::FromAddress(end - 1), this);
-  markbits()->SetRange(AddressToMarkbitIndex(start),
-                       AddressToMarkbitIndex(end));
+  markbits()->SetRange<MarkBit::ATOMIC>(AddressToMarkbitIndex(start),
+                                        AddressToMarkbitIndex(end));
   IncrementLiveBytes(static_cast<int>(end - start));
 }
 
@@ -977,6 +1052,9 @@ template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 template Page*
+MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+    size_t size, PagedSpace* owner, Executability executable);
+template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 
@@ -990,13 +1068,31 @@ LargePage* MemoryAllocator::AllocateLargePage(size_t size,
 
 template <typename SpaceType>
 MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
-  MemoryChunk* chunk = unmapper()->TryGetPooledMemoryChunkSafe();
+  bool committed = false;
+  MemoryChunk* chunk = unmapper()->TryGetPooledMemoryChunkSafe(&committed);
   if (chunk == nullptr) return nullptr;
   const int size = MemoryChunk::kPageSize;
   const Address start = reinterpret_cast<Address>(chunk);
   const Address area_start = start + MemoryChunk::kObjectStartOffset;
   const Address area_end = start + size;
-  if (!CommitBlock(reinterpret_cast<Address>(chunk), size, NOT_EXECUTABLE)) {
+  if (committed) {
+    // The memory is reused as is, only the accounting is redone. Unlike
+    // after CommitBlock, the memory is not zeroed. This is fine because
+    // MemoryChunk::Initialize resets the whole header, including the marking
+    // bitmap, the side tables were released when the chunk was pooled, and
+    // the owning space never reads the object area before writing it.
+    DCHECK_NULL(chunk->old_to_new_slots());
+    DCHECK_NULL(chunk->old_to_old_slots());
+    DCHECK_NULL(chunk->typed_old_to_new_slots());
+    DCHECK_NULL(chunk->typed_old_to_old_slots());
+    DCHECK_NULL(chunk->skip_list());
+    DCHECK_NULL(chunk->local_tracker());
+    if (Heap::ShouldZapGarbage()) {
+      ZapBlock(start, size);
+    }
+    isolate_->counters()->memory_allocated()->Increment(size);
+  } else if (!CommitBlock(reinterpret_cast<Address>(chunk), size,
+                          NOT_EXECUTABLE)) {
     return nullptr;
   }
   base::VirtualMemory reservation(start, size);
@@ -1115,7 +1211,7 @@ void MemoryChunk::ReleaseAllocatedMemory() {
     mutex_ = nullptr;
   }
   if (old_to_new_slots_.Value() != nullptr) ReleaseOldToNewSlots();
-  if (old_to_old_slots_ != nullptr) ReleaseOldToOldSlots();
+  if (old_to_old_slots_.Value() != nullptr) ReleaseOldToOldSlots();
   if (typed_old_to_new_slots_.Value() != nullptr) ReleaseTypedOldToNewSlots();
   if (typed_old_to_old_slots_ != nullptr) ReleaseTypedOldToOldSlots();
   if (local_tracker_ != nullptr) ReleaseLocalTracker();
@@ -1132,8 +1228,11 @@ static SlotSet* AllocateSlotSet(size_t size, Address page_start) {
 }
 
 void MemoryChunk::AllocateOldToNewSlots() {
-  DCHECK(nullptr == old_to_new_slots_.Value());
-  old_to_new_slots_.SetValue(AllocateSlotSet(size_, address()));
+  SlotSet* slot_set = AllocateSlotSet(size_, address());
+  if (!old_to_new_slots_.TrySetValue(nullptr, slot_set)) {
+    // Parallel scavenging tasks may race for allocating the slot set.
+    delete[] slot_set;
+  }
 }
 
 void MemoryChunk::ReleaseOldToNewSlots() {
@@ -1143,13 +1242,18 @@ void MemoryChunk::ReleaseOldToNewSlots() {
 }
 
 void MemoryChunk::AllocateOldToOldSlots() {
-  DCHECK(nullptr == old_to_old_slots_);
-  old_to_old_slots_ = AllocateSlotSet(size_, address());
+  SlotSet* slot_set = AllocateSlotSet(size_, address());
+  if (!old_to_old_slots_.TrySetValue(nullptr, slot_set)) {
+    // Concurrent marking tasks may race with the main thread for allocating
+    // the slot set.
+    delete[] slot_set;
+  }
 }
 
 void MemoryChunk::ReleaseOldToOldSlots() {
-  delete[] old_to_old_slots_;
-  old_to_old_slots_ = nullptr;
+  SlotSet* old_to_old_slots = old_to_old_slots_.Value();
+  delete[] old_to_old_slots;
+  old_to_old_slots_.SetValue(nullptr);
 }
 
 void MemoryChunk::AllocateTypedOldToNewSlots() {
@@ -1300,6 +1404,37 @@ void PagedSpace::MergeCompactionSpace(CompactionSpace* other) {
   }
 }
 
+intptr_t PagedSpace::AddPage(Page* page) {
+  DCHECK(page->SweepingDone());
+  DCHECK_EQ(identity(), page->owner()->identity());
+  size_t free = page->available_in_free_list();
+  page->set_owner(this);
+  page->InsertAfter(anchor_.prev_page());
+  AccountCommitted(page->size());
+  accounting_stats_.ExpandSpace(page->area_size() - free);
+  accounting_stats_.IncreaseCapacity(free);
+  return RelinkFreeListCategories(page);
+}
+
+void PagedSpace::RemovePage(Page* page) {
+  DCHECK(page->SweepingDone());
+  DCHECK_EQ(this, page->owner());
+  DCHECK_NE(page, Page::FromAllocationAreaAddress(top()));
+  size_t free = page->available_in_free_list();
+  UnlinkFreeListCategories(page);
+  page->Unlink();
+  AccountUncommitted(page->size());
+  accounting_stats_.ShrinkSpace(page->area_size() - free);
+  accounting_stats_.DecreaseCapacity(free);
+}
+
+Page* PagedSpace::RemovePageSafe(int size_in_bytes) {
+  base::LockGuard<base::Mutex> guard(mutex());
+  Page* page = free_list()->GetPageForSize(static_cast<size_t>(size_in_bytes));
+  if (page == nullptr) return nullptr;
+  RemovePage(page);
+  return page;
+}
 
 size_t PagedSpace::CommittedPhysicalMemory() {
   if (!base::VirtualMemory::HasLazyCommits()) return CommittedMemory();
@@ -1338,7 +1473,15 @@ bool PagedSpace::Expand() {
 
   if (!heap()->CanExpandOldGeneration(size)) return false;
 
-  Page* p = heap()->memory_allocator()->AllocatePage(size, this, executable());
+  Page* p = nullptr;
+  if (executable() == NOT_EXECUTABLE &&
+      size == static_cast<int>(Page::kAllocatableMemory)) {
+    // Regular pages can be served from the pool of the Unmapper.
+    p = heap()->memory_allocator()->AllocatePage<MemoryAllocator::kPooled>(
+        size, this, executable());
+  } else {
+    p = heap()->memory_allocator()->AllocatePage(size, this, executable());
+  }
   if (p == nullptr) return false;
 
   AccountCommitted(p->size());
@@ -1373,13 +1516,13 @@ void PagedSpace::ResetFreeListStatistics() {
 void PagedSpace::SetAllocationInfo(Address top, Address limit) {
   SetTopAndLimit(top, limit);
   if (top != nullptr && top != limit &&
-      heap()->incremental_marking()->black_allocation()) {
+      heap()->incremental_marking()->black_allocation_in(identity())) {
     Page::FromAllocationAreaAddress(top)->CreateBlackArea(top, limit);
   }
 }
 
 void PagedSpace::MarkAllocationInfoBlack() {
-  DCHECK(heap()->incremental_marking()->black_allocation());
+  DCHECK(heap()->incremental_marking()->black_allocation_in(identity()));
   Address current_top = top();
   Address current_limit = limit();
   if (current_top != nullptr && current_top != current_limit) {
@@ -1399,13 +1542,14 @@ void PagedSpace::EmptyAllocationInfo() {
     return;
   }
 
-  if (heap()->incremental_marking()->black_allocation()) {
+  if (heap()->incremental_marking()->black_allocation_in(identity())) {
     Page* page = Page::FromAllocationAreaAddress(current_top);
 
     // Clear the bits in the unused black area.
     if (current_top != current_limit) {
-      page->markbits()->ClearRange(page->AddressToMarkbitIndex(current_top),
-                                   page->AddressToMarkbitIndex(current_limit));
+      page->markbits()->ClearRange<MarkBit::ATOMIC>(
+          page->AddressToMarkbitIndex(current_top),
+          page->AddressToMarkbitIndex(current_limit));
       page->IncrementLiveBytes(-static_cast<int>(current_limit - current_top));
     }
   }
@@ -2578,6 +2722,22 @@ FreeSpace* FreeList::FindNodeFor(size_t size_in_bytes, size_t* node_size) {
   return node;
 }
 
+Page* FreeList::GetPageForSize(size_t size_in_bytes) {
+  Page* linear_allocation_page =
+      owner_->top() != nullptr ? Page::FromAllocationAreaAddress(owner_->top())
+                               : nullptr;
+  const int minimum_category =
+      static_cast<int>(SelectFreeListCategoryType(size_in_bytes));
+  for (int cat = kHuge; cat >= minimum_category; cat--) {
+    FreeListCategoryIterator it(this, static_cast<FreeListCategoryType>(cat));
+    while (it.HasNext()) {
+      Page* page = it.Next()->page();
+      if (page != linear_allocation_page) return page;
+    }
+  }
+  return nullptr;
+}
+
 // Allocation on the old space free list.  If it succeeds then a new linear
 // allocation space has been set up with the top and limit of the space.  If
 // the allocation fails then NULL is returned, and the caller can perform a GC
@@ -2867,6 +3027,21 @@ HeapObject* PagedSpace::SlowAllocateRaw(int size_in_bytes) {
     }
   }
 
+  if (is_local()) {
+    // Without sweeping in progress, e.g., during a young generation
+    // collection, free memory is only available on pages of the main space.
+    // Taking over a whole page keeps later allocations on this task free of
+    // synchronization.
+    PagedSpace* main_space = heap()->paged_space(identity());
+    Page* page = main_space->RemovePageSafe(size_in_bytes);
+    if (page != nullptr) {
+      AddPage(page);
+      HeapObject* object =
+          free_list_.Allocate(static_cast<size_t>(size_in_bytes));
+      if (object != nullptr) return object;
+    }
+  }
+
   if (heap()->ShouldExpandOldGenerationOnSlowAllocation() && Expand()) {
     DCHECK((CountTotalPages() > 1) ||
            (static_cast<size_t>(size_in_bytes) <= free_list_.Available()));
@@ -2951,6 +3126,8 @@ LargeObjectSpace::LargeObjectSpace(Heap* heap, AllocationSpace id)
       size_(0),
       page_count_(0),
       objects_size_(0),
+      young_page_count_(0),
+      young_objects_size_(0),
       chunk_map_(1024) {}
 
 LargeObjectSpace::~LargeObjectSpace() {}
@@ -2961,6 +3138,8 @@ bool LargeObjectSpace::SetUp() {
   size_ = 0;
   page_count_ = 0;
   objects_size_ = 0;
+  young_page_count_ = 0;
+  young_objects_size_ = 0;
   chunk_map_.Clear();
   return true;
 }
@@ -2986,9 +3165,49 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
     return AllocationResult::Retry(identity());
   }
 
+  LargePage* page = AllocateLargePage(object_size, executable);
+  if (page == NULL) return AllocationResult::Retry(identity());
+  HeapObject* object = page->GetObject();
+
+  heap()->StartIncrementalMarkingIfAllocationLimitIsReached(Heap::kNoGCFlags,
+                                                            kNoGCCallbackFlags);
+  AllocationStep(object->address(), object_size);
+
+  if (heap()->incremental_marking()->black_allocation()) {
+    // We cannot use ObjectMarking here as the object still lacks a size.
+    Marking::WhiteToBlack(ObjectMarking::MarkBitFrom(object));
+    MemoryChunk::IncrementLiveBytes(object, object_size);
+  }
+  return object;
+}
+
+AllocationResult LargeObjectSpace::AllocateRawYoung(int object_size) {
+  // Young large objects are limited by the capacity of the new space. Failing
+  // the allocation triggers a scavenge, which empties the young part of this
+  // space again.
+  if (young_objects_size_ > 0 &&
+      young_objects_size_ + object_size > heap()->new_space()->Capacity() &&
+      !heap()->always_allocate()) {
+    return AllocationResult::Retry(NEW_SPACE);
+  }
+
+  LargePage* page = AllocateLargePage(object_size, NOT_EXECUTABLE);
+  if (page == NULL) return AllocationResult::Retry(NEW_SPACE);
+  page->SetFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetNewSpacePageFlags(page);
+  young_page_count_++;
+  young_objects_size_ += object_size;
+
+  HeapObject* object = page->GetObject();
+  AllocationStep(object->address(), object_size);
+  return object;
+}
+
+LargePage* LargeObjectSpace::AllocateLargePage(int object_size,
+                                               Executability executable) {
   LargePage* page = heap()->memory_allocator()->AllocateLargePage(
       object_size, this, executable);
-  if (page == NULL) return AllocationResult::Retry(identity());
+  if (page == NULL) return NULL;
   DCHECK_GE(page->area_size(), static_cast<size_t>(object_size));
 
   size_ += static_cast<int>(page->size());
@@ -3000,26 +3219,80 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
 
   InsertChunkMapEntries(page);
 
-  HeapObject* object = page->GetObject();
-
   if (Heap::ShouldZapGarbage()) {
     // Make the object consistent so the heap can be verified in OldSpaceStep.
     // We only need to do this in debug builds or if verify_heap is on.
+    HeapObject* object = page->GetObject();
     reinterpret_cast<Object**>(object->address())[0] =
         heap()->fixed_array_map();
     reinterpret_cast<Object**>(object->address())[1] = Smi::kZero;
   }
+  return page;
+}
 
-  heap()->StartIncrementalMarkingIfAllocationLimitIsReached(Heap::kNoGCFlags,
-                                                            kNoGCCallbackFlags);
-  AllocationStep(object->address(), object_size);
+void LargeObjectSpace::FlipYoungPages() {
+  if (young_page_count_ == 0) return;
+  for (LargePage* page = first_page_; page != NULL;
+       page = page->next_page()) {
+    if (page->InToSpace()) {
+      page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+      page->SetFlag(MemoryChunk::IN_FROM_SPACE);
+    }
+  }
+}
 
-  if (heap()->incremental_marking()->black_allocation()) {
-    // We cannot use ObjectMarking here as the object still lacks a size.
-    Marking::WhiteToBlack(ObjectMarking::MarkBitFrom(object));
-    MemoryChunk::IncrementLiveBytes(object, object_size);
+bool LargeObjectSpace::PromoteYoungObject(HeapObject* object) {
+  MemoryChunk* page = MemoryChunk::FromAddress(object->address());
+  base::LockGuard<base::Mutex> guard(&young_pages_mutex_);
+  if (!page->InNewSpace()) return false;
+  page->ClearFlag(MemoryChunk::IN_FROM_SPACE);
+  page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetOldSpacePageFlags(page);
+  DCHECK_GT(young_page_count_, 0);
+  if (--young_page_count_ == 0) {
+    young_objects_size_ = 0;
+  } else {
+    young_objects_size_ -=
+        Min(young_objects_size_, static_cast<size_t>(object->Size()));
   }
-  return object;
+  return true;
+}
+
+void LargeObjectSpace::FreeDeadYoungObjects() {
+  if (young_page_count_ == 0) return;
+  LargePage* previous = NULL;
+  LargePage* current = first_page_;
+  while (current != NULL) {
+    LargePage* page = current;
+    current = current->next_page();
+    if (page->InFromSpace()) {
+      young_page_count_--;
+      FreePage(page, previous);
+    } else {
+      previous = page;
+    }
+  }
+  // Pages allocated after the last flip would still be in to-space.
+  DCHECK_EQ(0, young_page_count_);
+  young_objects_size_ = 0;
+}
+
+void LargeObjectSpace::FreePage(LargePage* page, LargePage* previous) {
+  // Cut the chunk out from the chunk list.
+  if (previous == NULL) {
+    first_page_ = page->next_page();
+  } else {
+    previous->set_next_page(page->next_page());
+  }
+
+  // Free the chunk.
+  size_ -= static_cast<int>(page->size());
+  AccountUncommitted(page->size());
+  objects_size_ -= page->GetObject()->Size();
+  page_count_--;
+
+  RemoveChunkMapEntries(page);
+  heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
 }
 
 
@@ -3124,22 +3397,8 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
       current = current->next_page();
     } else {
       LargePage* page = current;
-      // Cut the chunk out from the chunk list.
       current = current->next_page();
-      if (previous == NULL) {
-        first_page_ = current;
-      } else {
-        previous->set_next_page(current);
-      }
-
-      // Free the chunk.
-      size_ -= static_cast<int>(page->size());
-      AccountUncommitted(page->size());
-      objects_size_ -= object->Size();
-      page_count_--;
-
-      RemoveChunkMapEntries(page);
-      heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+      FreePage(page, previous);
     }
   }
 }
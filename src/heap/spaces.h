@@ -8,6 +8,7 @@
 #include <list>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "src/allocation.h"
 #include "src/base/atomic-utils.h"
@@ -442,7 +443,7 @@ class MemoryChunk {
   inline void set_skip_list(SkipList* skip_list) { skip_list_ = skip_list; }
 
   inline SlotSet* old_to_new_slots() { return old_to_new_slots_.Value(); }
-  inline SlotSet* old_to_old_slots() { return old_to_old_slots_; }
+  inline SlotSet* old_to_old_slots() { return old_to_old_slots_.Value(); }
   inline TypedSlotSet* typed_old_to_new_slots() {
     return typed_old_to_new_slots_.Value();
   }
@@ -616,7 +617,7 @@ class MemoryChunk {
   // set for large pages. In the latter case the number of entries in the array
   // is ceil(size() / kPageSize).
   base::AtomicValue<SlotSet*> old_to_new_slots_;
-  SlotSet* old_to_old_slots_;
+  base::AtomicValue<SlotSet*> old_to_old_slots_;
   base::AtomicValue<TypedSlotSet*> typed_old_to_new_slots_;
   TypedSlotSet* typed_old_to_old_slots_;
 
@@ -1108,9 +1109,11 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
     explicit Unmapper(MemoryAllocator* allocator)
         : allocator_(allocator),
           pending_unmapping_tasks_semaphore_(0),
-          concurrent_unmapping_tasks_active_(0) {
+          concurrent_unmapping_tasks_active_(0),
+          committed_pool_limit_(0) {
       chunks_[kRegular].reserve(kReservedQueueingSlots);
       chunks_[kPooled].reserve(kReservedQueueingSlots);
+      chunks_[kPooledCommitted].reserve(kReservedQueueingSlots);
     }
 
     void AddMemoryChunkSafe(MemoryChunk* chunk) {
@@ -1122,23 +1125,47 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
       }
     }
 
-    MemoryChunk* TryGetPooledMemoryChunkSafe() {
+    // Returns a pooled chunk or nullptr. |committed| is set to whether the
+    // memory of the chunk is still committed.
+    MemoryChunk* TryGetPooledMemoryChunkSafe(bool* committed) {
       // Procedure:
-      // (1) Try to get a chunk that was declared as pooled and already has
+      // (1) Try to get a chunk that was kept committed for reuse.
+      // (2) Try to get a chunk that was declared as pooled and already has
       // been uncommitted.
-      // (2) Try to steal any memory chunk of kPageSize that would've been
+      // (3) Try to steal any memory chunk of kPageSize that would've been
       // unmapped.
-      MemoryChunk* chunk = GetMemoryChunkSafe<kPooled>();
+      *committed = true;
+      MemoryChunk* chunk = GetMemoryChunkSafe<kPooledCommitted>();
+      if (chunk != nullptr) return chunk;
+      *committed = false;
+      chunk = GetMemoryChunkSafe<kPooled>();
       if (chunk == nullptr) {
         chunk = GetMemoryChunkSafe<kRegular>();
         if (chunk != nullptr) {
           // For stolen chunks we need to manually free any allocated memory.
+          // They are recommitted like uncommitted ones, which also gives them
+          // fresh zeroed pages.
           chunk->ReleaseAllocatedMemory();
         }
       }
       return chunk;
     }
 
+    // Sets the maximum number of freed pages of kPageSize that are kept
+    // committed for reuse instead of being uncommitted or unmapped.
+    void SetCommittedPoolLimit(size_t pages) {
+      committed_pool_limit_.SetValue(pages);
+    }
+
+    // Returns the memory of pages that are kept committed for reuse to the
+    // OS on a background thread.
+    void ReleaseCommittedPool();
+
+    size_t CommittedPoolSize() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      return chunks_[kPooledCommitted].size() * MemoryChunk::kPageSize;
+    }
+
     void FreeQueuedChunks();
     bool WaitUntilCompleted();
     void TearDown();
@@ -1151,6 +1178,8 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
                     // can thus be used for stealing.
       kNonRegular,  // Large chunks and executable chunks.
       kPooled,      // Pooled chunks, already uncommited and ready for reuse.
+      kPooledCommitted,  // Chunks of kPageSize that are still committed and
+                         // ready for reuse.
       kNumberOfChunkQueues,
     };
 
@@ -1179,6 +1208,21 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
       return chunk;
     }
 
+    // Keeps a regular chunk committed if the pool limit permits.
+    bool TryAddToCommittedPoolSafe(MemoryChunk* chunk) {
+      if (chunk->size() != MemoryChunk::kPageSize ||
+          chunk->executable() == EXECUTABLE) {
+        return false;
+      }
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (chunks_[kPooledCommitted].size() >= committed_pool_limit_.Value()) {
+        return false;
+      }
+      chunk->ReleaseAllocatedMemory();
+      chunks_[kPooledCommitted].push_back(chunk);
+      return true;
+    }
+
     void ReconsiderDelayedChunks();
     template <FreeMode mode>
     void PerformFreeMemoryOnQueuedChunks();
@@ -1192,6 +1236,7 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
     std::list<MemoryChunk*> delayed_regular_chunks_;
     base::Semaphore pending_unmapping_tasks_semaphore_;
     intptr_t concurrent_unmapping_tasks_active_;
+    base::AtomicNumber<size_t> committed_pool_limit_;
 
     friend class MemoryAllocator;
   };
@@ -1276,6 +1321,10 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
     return (Available() / Page::kPageSize) * Page::kAllocatableMemory;
   }
 
+  // Returns the number of bytes of the heap that are currently backed by
+  // transparent huge pages (--huge_pages). Expensive to compute.
+  size_t HugePageBackedMemory();
+
   // Returns an indication of whether a pointer is in a space that has
   // been allocated by this MemoryAllocator.
   V8_INLINE bool IsOutsideAllocatedSpace(const void* address) {
@@ -1339,6 +1388,15 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
   // FreeMemory can be called concurrently when PreFree was executed before.
   void PerformFreeMemory(MemoryChunk* chunk);
 
+  // Reserves a page sized chunk within a huge page aligned region of the size
+  // of a huge page (--huge_pages). The remaining chunks of the region are
+  // handed out by subsequent calls, so that adjacent committed pages can be
+  // backed by a single huge page.
+  Address ReserveHugePageRegionChunk(base::VirtualMemory* controller);
+
+  // Advises freshly committed memory for huge pages if --huge_pages is set.
+  void AdviseHugePages(Address base, size_t size);
+
   // See AllocatePage for public interface. Note that currently we only support
   // pools for NOT_EXECUTABLE pages of size MemoryChunk::kPageSize.
   template <typename SpaceType>
@@ -1388,6 +1446,10 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
   base::VirtualMemory last_chunk_;
   Unmapper unmapper_;
 
+  // Reserved but not yet used page sized chunks of huge page regions.
+  base::Mutex huge_page_region_mutex_;
+  std::vector<Address> huge_page_region_chunks_;
+
   friend class TestCodeRangeScope;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryAllocator);
@@ -1400,6 +1462,9 @@ extern template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 extern template Page*
+MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+    size_t size, PagedSpace* owner, Executability executable);
+extern template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 
@@ -1737,6 +1802,12 @@ class V8_EXPORT_PRIVATE FreeList {
   size_t EvictFreeListItems(Page* page);
   bool ContainsPageFreeListItems(Page* page);
 
+  // Returns a page with free list entries in a category that fits
+  // |size_in_bytes|, preferring pages with large entries. The page holding
+  // the linear allocation area of the owner is never returned. Returns
+  // nullptr if no such page exists.
+  Page* GetPageForSize(size_t size_in_bytes);
+
   PagedSpace* owner() { return owner_; }
   size_t wasted_bytes() { return wasted_bytes_.Value(); }
 
@@ -1897,6 +1968,10 @@ class LocalAllocationBuffer {
   // Returns true if the merge was successful, false otherwise.
   inline bool TryMerge(LocalAllocationBuffer* other);
 
+  // Gives back the memory of the most recently allocated object if it sits
+  // right below the current top. Returns true on success.
+  inline bool TryFreeLast(HeapObject* object, int object_size);
+
  private:
   LocalAllocationBuffer(Heap* heap, AllocationInfo allocation_info);
 
@@ -2107,6 +2182,18 @@ class V8_EXPORT_PRIVATE PagedSpace : NON_EXPORTED_BASE(public Space) {
   inline void UnlinkFreeListCategories(Page* page);
   inline intptr_t RelinkFreeListCategories(Page* page);
 
+  // Adds a swept page that was removed from another space with the same
+  // identity. Returns the number of bytes added to the free list.
+  intptr_t AddPage(Page* page);
+
+  // Removes a swept page together with its free list entries from the space.
+  void RemovePage(Page* page);
+
+  // Removes a page with free memory for an allocation of |size_in_bytes|.
+  // Returns nullptr if there is no such page. Can be called concurrently
+  // from tasks that refill a local space.
+  Page* RemovePageSafe(int size_in_bytes);
+
   iterator begin() { return iterator(anchor_.next_page()); }
   iterator end() { return iterator(&anchor_); }
 
@@ -2807,6 +2894,25 @@ class LargeObjectSpace : public Space {
   MUST_USE_RESULT AllocationResult
       AllocateRaw(int object_size, Executability executable);
 
+  // Allocates a large object in the young generation (--young_large_objects).
+  // Its page is flagged as a to-space page, so write barriers and scavenges
+  // treat the object like any other new space object. The object is never
+  // copied though: a scavenge promotes it by clearing the flags of its page,
+  // or frees the page if the object is dead.
+  MUST_USE_RESULT AllocationResult AllocateRawYoung(int object_size);
+
+  // Turns the pages of young objects into from-space pages. Called at the
+  // beginning of a scavenge.
+  void FlipYoungPages();
+
+  // Moves a young object to the old generation without copying it. Returns
+  // false if it has already been promoted. May be called concurrently by
+  // parallel scavenger tasks.
+  bool PromoteYoungObject(HeapObject* object);
+
+  // Frees the pages of young objects that were not promoted by a scavenge.
+  void FreeDeadYoungObjects();
+
   // Available bytes for objects in this space.
   inline size_t Available() override;
 
@@ -2814,6 +2920,10 @@ class LargeObjectSpace : public Space {
 
   size_t SizeOfObjects() override { return objects_size_; }
 
+  // Part of SizeOfObjects() that belongs to the young generation.
+  size_t SizeOfYoungObjects() { return young_objects_size_; }
+  bool HasYoungObjects() { return young_page_count_ > 0; }
+
   // Approximate amount of physical memory committed for this space.
   size_t CommittedPhysicalMemory() override;
 
@@ -2849,7 +2959,12 @@ class LargeObjectSpace : public Space {
   // Checks whether the space is empty.
   bool IsEmpty() { return first_page_ == NULL; }
 
-  void AdjustLiveBytes(int by) { objects_size_ += by; }
+  void AdjustLiveBytes(HeapObject* object, int by) {
+    objects_size_ += by;
+    if (MemoryChunk::FromAddress(object->address())->InNewSpace()) {
+      young_objects_size_ += by;
+    }
+  }
 
   LargePage* first_page() { return first_page_; }
 
@@ -2871,11 +2986,18 @@ class LargeObjectSpace : public Space {
 #endif
 
  private:
+  LargePage* AllocateLargePage(int object_size, Executability executable);
+  void FreePage(LargePage* page, LargePage* previous);
+
   // The head of the linked list of large object chunks.
   LargePage* first_page_;
   size_t size_;            // allocated bytes
   int page_count_;         // number of chunks
   size_t objects_size_;    // size of objects
+  int young_page_count_;   // number of chunks in the young generation
+  size_t young_objects_size_;  // size of objects in the young generation
+  // Guards promotion of young objects by parallel scavenger tasks.
+  base::Mutex young_pages_mutex_;
   // The chunk_map_mutex_ has to be used when the chunk map is accessed
   // concurrently.
   base::Mutex chunk_map_mutex_;
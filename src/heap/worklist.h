@@ -0,0 +1,223 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_WORKLIST_H_
+#define V8_HEAP_WORKLIST_H_
+
+#include <cstddef>
+
+#include "src/base/atomic-utils.h"
+#include "src/base/logging.h"
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+// A concurrent worklist based on segments. Each task gets private
+// push and pop segments. Empty pop segments are swapped with their
+// corresponding push segments. Full push segments are published to a global
+// pool of segments and replaced with empty segments.
+//
+// Work stealing is best effort, i.e., there is no way to inform other tasks
+// of the need of items.
+template <typename EntryType, int SEGMENT_SIZE>
+class Worklist {
+ public:
+  static const int kMaxNumTasks = 8;
+  static const int kSegmentCapacity = SEGMENT_SIZE;
+
+  Worklist() : global_pool_(nullptr) {
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      private_push_segment(i) = new Segment();
+      private_pop_segment(i) = new Segment();
+    }
+  }
+
+  ~Worklist() {
+    CHECK(IsGlobalEmpty());
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      DCHECK_NOT_NULL(private_push_segment(i));
+      DCHECK_NOT_NULL(private_pop_segment(i));
+      delete private_push_segment(i);
+      delete private_pop_segment(i);
+    }
+  }
+
+  bool Push(int task_id, EntryType entry) {
+    DCHECK_LT(task_id, kMaxNumTasks);
+    DCHECK_NOT_NULL(private_push_segment(task_id));
+    if (!private_push_segment(task_id)->Push(entry)) {
+      PublishPushSegmentToGlobal(task_id);
+      bool success = private_push_segment(task_id)->Push(entry);
+      USE(success);
+      DCHECK(success);
+    }
+    return true;
+  }
+
+  bool Pop(int task_id, EntryType* entry) {
+    DCHECK_LT(task_id, kMaxNumTasks);
+    DCHECK_NOT_NULL(private_pop_segment(task_id));
+    if (!private_pop_segment(task_id)->Pop(entry)) {
+      if (!private_push_segment(task_id)->IsEmpty()) {
+        Segment* tmp = private_pop_segment(task_id);
+        private_pop_segment(task_id) = private_push_segment(task_id);
+        private_push_segment(task_id) = tmp;
+      } else if (!StealPopSegmentFromGlobal(task_id)) {
+        return false;
+      }
+      bool success = private_pop_segment(task_id)->Pop(entry);
+      USE(success);
+      DCHECK(success);
+    }
+    return true;
+  }
+
+  bool IsLocalEmpty(int task_id) {
+    return private_pop_segment(task_id)->IsEmpty() &&
+           private_push_segment(task_id)->IsEmpty();
+  }
+
+  bool IsGlobalPoolEmpty() { return global_pool_size_.Value() == 0; }
+
+  bool IsGlobalEmpty() {
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      if (!IsLocalEmpty(i)) return false;
+    }
+    return IsGlobalPoolEmpty();
+  }
+
+  size_t LocalSize(int task_id) {
+    return private_pop_segment(task_id)->Size() +
+           private_push_segment(task_id)->Size();
+  }
+
+  // Clears all segments. Frees the global segment pool.
+  // This function is not thread-safe.
+  void Clear() {
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      private_pop_segment(i)->Clear();
+      private_push_segment(i)->Clear();
+    }
+    base::LockGuard<base::Mutex> guard(&lock_);
+    while (global_pool_ != nullptr) {
+      Segment* segment = global_pool_;
+      global_pool_ = segment->next();
+      delete segment;
+    }
+    global_pool_size_.SetValue(0);
+  }
+
+  // Publishes both private segments of the given task so that other tasks
+  // can steal its work.
+  void FlushToGlobal(int task_id) {
+    PublishPushSegmentToGlobal(task_id);
+    PublishPopSegmentToGlobal(task_id);
+  }
+
+ private:
+  class Segment : public Malloced {
+   public:
+    static const int kCapacity = kSegmentCapacity;
+
+    Segment() : index_(0), next_(nullptr) {}
+
+    bool Push(EntryType entry) {
+      if (IsFull()) return false;
+      entries_[index_++] = entry;
+      return true;
+    }
+
+    bool Pop(EntryType* entry) {
+      if (IsEmpty()) return false;
+      *entry = entries_[--index_];
+      return true;
+    }
+
+    size_t Size() const { return index_; }
+    bool IsEmpty() const { return index_ == 0; }
+    bool IsFull() const { return index_ == kCapacity; }
+    void Clear() { index_ = 0; }
+
+    Segment* next() const { return next_; }
+    void set_next(Segment* segment) { next_ = segment; }
+
+   private:
+    size_t index_;
+    Segment* next_;
+    EntryType entries_[kCapacity];
+  };
+
+  // Private segments are accessed by a single task only. Padding them to a
+  // cache line avoids false sharing between tasks.
+  struct PrivateSegmentHolder {
+    Segment* private_push_segment;
+    Segment* private_pop_segment;
+    char cache_line_padding[64];
+  };
+
+  V8_INLINE Segment*& private_push_segment(int task_id) {
+    return private_segments_[task_id].private_push_segment;
+  }
+
+  V8_INLINE Segment*& private_pop_segment(int task_id) {
+    return private_segments_[task_id].private_pop_segment;
+  }
+
+  V8_INLINE void PublishPushSegmentToGlobal(int task_id) {
+    if (!private_push_segment(task_id)->IsEmpty()) {
+      PushToGlobalPool(private_push_segment(task_id));
+      private_push_segment(task_id) = new Segment();
+    }
+  }
+
+  V8_INLINE void PublishPopSegmentToGlobal(int task_id) {
+    if (!private_pop_segment(task_id)->IsEmpty()) {
+      PushToGlobalPool(private_pop_segment(task_id));
+      private_pop_segment(task_id) = new Segment();
+    }
+  }
+
+  V8_INLINE bool StealPopSegmentFromGlobal(int task_id) {
+    if (IsGlobalPoolEmpty()) return false;
+    Segment* new_segment = nullptr;
+    if (PopFromGlobalPool(&new_segment)) {
+      delete private_pop_segment(task_id);
+      private_pop_segment(task_id) = new_segment;
+      return true;
+    }
+    return false;
+  }
+
+  // Global pool operations.
+  void PushToGlobalPool(Segment* segment) {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    segment->set_next(global_pool_);
+    global_pool_ = segment;
+    global_pool_size_.Increment(1);
+  }
+
+  bool PopFromGlobalPool(Segment** segment) {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    if (global_pool_ == nullptr) return false;
+    global_pool_size_.Decrement(1);
+    *segment = global_pool_;
+    global_pool_ = global_pool_->next();
+    return true;
+  }
+
+  PrivateSegmentHolder private_segments_[kMaxNumTasks];
+  base::Mutex lock_;
+  Segment* global_pool_;
+  base::AtomicNumber<intptr_t> global_pool_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worklist);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_WORKLIST_H_
@@ -10,37 +10,151 @@ namespace tracing {
 
 TraceBufferRingBuffer::TraceBufferRingBuffer(size_t max_chunks,
                                              TraceWriter* trace_writer)
-    : max_chunks_(max_chunks) {
+    : max_chunks_(max_chunks),
+      thread_chunk_index_key_(base::Thread::CreateThreadLocalKey()),
+      thread_chunk_seq_key_(base::Thread::CreateThreadLocalKey()) {
   trace_writer_.reset(trace_writer);
   chunks_.resize(max_chunks);
+  chunk_owned_.resize(max_chunks);
 }
 
-TraceBufferRingBuffer::~TraceBufferRingBuffer() {}
+TraceBufferRingBuffer::~TraceBufferRingBuffer() {
+  base::Thread::DeleteThreadLocalKey(thread_chunk_seq_key_);
+  base::Thread::DeleteThreadLocalKey(thread_chunk_index_key_);
+}
 
 TraceObject* TraceBufferRingBuffer::AddTraceEvent(uint64_t* handle) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
-  if (is_empty_ || chunks_[chunk_index_]->IsFull()) {
-    chunk_index_ = is_empty_ ? 0 : NextChunkIndex(chunk_index_);
-    is_empty_ = false;
-    auto& chunk = chunks_[chunk_index_];
-    if (chunk) {
-      chunk->Reset(current_chunk_seq_++);
-    } else {
-      chunk.reset(new TraceBufferChunk(current_chunk_seq_++));
+  size_t chunk_index;
+  uint32_t chunk_seq;
+  size_t event_index;
+  if (GetThreadChunkIndex(&chunk_index, &chunk_seq) &&
+      EnterLockFreeSection()) {
+    // A chunk is only reset by another thread after waiting for this section
+    // to end.
+    TraceBufferChunk* chunk = chunks_[chunk_index].get();
+    if (chunk->seq() == chunk_seq && !chunk->IsFull()) {
+      TraceObject* trace_object = chunk->AddTraceEvent(&event_index);
+      *handle = MakeHandle(chunk_index, chunk_seq, event_index);
+      LeaveLockFreeSection();
+      return trace_object;
     }
+    LeaveLockFreeSection();
   }
-  auto& chunk = chunks_[chunk_index_];
-  size_t event_index;
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  TraceBufferChunk* chunk = ClaimThreadChunk(&chunk_index);
   TraceObject* trace_object = chunk->AddTraceEvent(&event_index);
-  *handle = MakeHandle(chunk_index_, chunk->seq(), event_index);
+  *handle = MakeHandle(chunk_index, chunk->seq(), event_index);
   return trace_object;
 }
 
+bool TraceBufferRingBuffer::EnterLockFreeSection() {
+  // The full barrier of the increment pairs with the one in
+  // StopLockFreeSections: either the stopping thread sees this thread in the
+  // section, or this thread sees the stop request.
+  base::Barrier_AtomicIncrement(&lock_free_threads_, 1);
+  if (base::Acquire_Load(&stopping_lock_free_sections_) == 0) return true;
+  LeaveLockFreeSection();
+  return false;
+}
+
+void TraceBufferRingBuffer::LeaveLockFreeSection() {
+  if (base::Barrier_AtomicIncrement(&lock_free_threads_, -1) == 0 &&
+      base::Acquire_Load(&stopping_lock_free_sections_) != 0) {
+    base::LockGuard<base::Mutex> guard(&lock_free_sections_mutex_);
+    lock_free_sections_stopped_.NotifyOne();
+  }
+}
+
+void TraceBufferRingBuffer::StopLockFreeSections() {
+  base::NoBarrier_Store(&stopping_lock_free_sections_, 1);
+  base::MemoryBarrier();
+  base::LockGuard<base::Mutex> guard(&lock_free_sections_mutex_);
+  while (base::Acquire_Load(&lock_free_threads_) != 0) {
+    lock_free_sections_stopped_.Wait(&lock_free_sections_mutex_);
+  }
+}
+
+void TraceBufferRingBuffer::ResumeLockFreeSections() {
+  base::Release_Store(&stopping_lock_free_sections_, 0);
+}
+
+bool TraceBufferRingBuffer::GetThreadChunkIndex(size_t* chunk_index,
+                                                uint32_t* chunk_seq) const {
+  int index = base::Thread::GetThreadLocalInt(thread_chunk_index_key_);
+  if (index == 0) return false;
+  *chunk_index = static_cast<size_t>(index - 1);
+  *chunk_seq = static_cast<uint32_t>(
+      base::Thread::GetThreadLocalInt(thread_chunk_seq_key_));
+  return true;
+}
+
+TraceBufferChunk* TraceBufferRingBuffer::ClaimThreadChunk(
+    size_t* chunk_index) {
+  size_t index;
+  uint32_t seq;
+  if (GetThreadChunkIndex(&index, &seq) && chunks_[index]->seq() == seq) {
+    TraceBufferChunk* chunk = chunks_[index].get();
+    if (!chunk->IsFull()) {
+      // The lock-free path was not taken because Flush was in progress.
+      *chunk_index = index;
+      return chunk;
+    }
+    // Return the full chunk to the ring.
+    chunk_owned_[index] = false;
+  }
+  TraceBufferChunk* chunk = ClaimChunk(chunk_index);
+  base::Thread::SetThreadLocalInt(thread_chunk_index_key_,
+                                  static_cast<int>(*chunk_index + 1));
+  base::Thread::SetThreadLocalInt(thread_chunk_seq_key_,
+                                  static_cast<int>(chunk->seq()));
+  return chunk;
+}
+
+TraceBufferChunk* TraceBufferRingBuffer::ClaimChunk(size_t* chunk_index) {
+  size_t index = is_empty_ ? 0 : NextChunkIndex(chunk_index_);
+  size_t skipped = 0;
+  while (chunk_owned_[index] && skipped < max_chunks_) {
+    skipped++;
+    index = NextChunkIndex(index);
+  }
+  // If all chunks are owned, e.g., by threads that exited without releasing
+  // theirs, the oldest one is reclaimed. Its owner, if still alive, claims a
+  // new chunk on its next event.
+  chunk_index_ = index;
+  is_empty_ = false;
+  chunk_owned_[index] = true;
+  auto& chunk = chunks_[index];
+  if (chunk) {
+    // A thread may still be checking the chunk it owned before the last
+    // Flush or before this reclaim.
+    StopLockFreeSections();
+    chunk->Reset(current_chunk_seq_++);
+    ResumeLockFreeSections();
+  } else {
+    chunk.reset(new TraceBufferChunk(current_chunk_seq_++));
+  }
+  *chunk_index = index;
+  return chunk.get();
+}
+
 TraceObject* TraceBufferRingBuffer::GetEventByHandle(uint64_t handle) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
   size_t chunk_index, event_index;
   uint32_t chunk_seq;
   ExtractHandle(handle, &chunk_index, &chunk_seq, &event_index);
+  // Events in the chunk owned by the current thread can be looked up
+  // without locking, which covers most scoped trace events.
+  size_t thread_chunk_index;
+  uint32_t thread_chunk_seq;
+  if (GetThreadChunkIndex(&thread_chunk_index, &thread_chunk_seq) &&
+      thread_chunk_index == chunk_index && thread_chunk_seq == chunk_seq &&
+      EnterLockFreeSection()) {
+    TraceBufferChunk* chunk = chunks_[chunk_index].get();
+    TraceObject* trace_object =
+        chunk->seq() == chunk_seq ? chunk->GetEventAt(event_index) : NULL;
+    LeaveLockFreeSection();
+    return trace_object;
+  }
+  base::LockGuard<base::Mutex> guard(&mutex_);
   if (chunk_index >= chunks_.size()) return NULL;
   auto& chunk = chunks_[chunk_index];
   if (!chunk || chunk->seq() != chunk_seq) return NULL;
@@ -49,6 +163,9 @@ TraceObject* TraceBufferRingBuffer::GetEventByHandle(uint64_t handle) {
 
 bool TraceBufferRingBuffer::Flush() {
   base::LockGuard<base::Mutex> guard(&mutex_);
+  // Make threads take the mutex for new events and wait for those that are
+  // adding an event to their chunk without locking.
+  StopLockFreeSections();
   // This flushes all the traces stored in the buffer.
   if (!is_empty_) {
     for (size_t i = NextChunkIndex(chunk_index_);; i = NextChunkIndex(i)) {
@@ -61,8 +178,14 @@ bool TraceBufferRingBuffer::Flush() {
     }
   }
   trace_writer_->Flush();
-  // This resets the trace buffer.
+  // This resets the trace buffer. Resetting the chunks also makes threads
+  // that still own a chunk claim a new one on their next event.
+  for (size_t i = 0; i < chunks_.size(); ++i) {
+    if (chunks_[i]) chunks_[i]->Reset(current_chunk_seq_++);
+    chunk_owned_[i] = false;
+  }
   is_empty_ = true;
+  ResumeLockFreeSections();
   return true;
 }
 
@@ -9,12 +9,23 @@
 #include <vector>
 
 #include "include/libplatform/v8-tracing.h"
+#include "src/base/atomicops.h"
+#include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
 
 namespace v8 {
 namespace platform {
 namespace tracing {
 
+// Each thread claims a chunk of the ring buffer and adds events to it
+// without locking. The mutex is only taken when a thread needs a new chunk,
+// i.e. once per TraceBufferChunk::kChunkSize events, and for looking up
+// events in chunks that the current thread does not own. Chunks that are
+// still owned by a thread are skipped when the ring wraps around, unless all
+// chunks are owned, e.g., by threads that exited. Then the oldest one is
+// reclaimed. Flush and chunk resets make new events take the mutex and wait
+// for threads that are still using their chunk without locking.
 class TraceBufferRingBuffer : public TraceBuffer {
  public:
   TraceBufferRingBuffer(size_t max_chunks, TraceWriter* trace_writer);
@@ -32,13 +43,46 @@ class TraceBufferRingBuffer : public TraceBuffer {
   size_t Capacity() const { return max_chunks_ * TraceBufferChunk::kChunkSize; }
   size_t NextChunkIndex(size_t index) const;
 
+  // Lock-free accesses to the chunk owned by the current thread are
+  // bracketed by these. EnterLockFreeSection returns false while chunks
+  // owned by other threads are reset, in which case the caller must take
+  // |mutex_|.
+  bool EnterLockFreeSection();
+  void LeaveLockFreeSection();
+
+  // Make threads take |mutex_| and wait until no thread is in a lock-free
+  // section, and vice versa. Must be called with |mutex_| held.
+  void StopLockFreeSections();
+  void ResumeLockFreeSections();
+
+  // Releases the full or stale chunk last claimed by the current thread and
+  // claims a new one. Must be called with |mutex_| held.
+  TraceBufferChunk* ClaimThreadChunk(size_t* chunk_index);
+  // Must be called with |mutex_| held.
+  TraceBufferChunk* ClaimChunk(size_t* chunk_index);
+  // Looks up the chunk last claimed by the current thread. The chunk is
+  // still owned by the thread if its sequence number equals |chunk_seq|.
+  bool GetThreadChunkIndex(size_t* chunk_index, uint32_t* chunk_seq) const;
+
   mutable base::Mutex mutex_;
   size_t max_chunks_;
   std::unique_ptr<TraceWriter> trace_writer_;
   std::vector<std::unique_ptr<TraceBufferChunk>> chunks_;
+  std::vector<bool> chunk_owned_;
+  // Thread-local index (plus one) and sequence number of the chunk last
+  // claimed by a thread.
+  base::Thread::LocalStorageKey thread_chunk_index_key_;
+  base::Thread::LocalStorageKey thread_chunk_seq_key_;
   size_t chunk_index_;
   bool is_empty_ = true;
   uint32_t current_chunk_seq_ = 1;
+  // Number of threads in a lock-free section, and whether a thread holding
+  // |mutex_| waits for them to leave. The last thread to leave signals
+  // |lock_free_sections_stopped_|.
+  base::Atomic32 lock_free_threads_ = 0;
+  base::Atomic32 stopping_lock_free_sections_ = 0;
+  base::Mutex lock_free_sections_mutex_;
+  base::ConditionVariable lock_free_sections_stopped_;
 };
 
 }  // namespace tracing
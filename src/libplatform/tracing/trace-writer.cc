@@ -171,6 +171,165 @@ TraceWriter* TraceWriter::CreateJSONTraceWriter(std::ostream& stream) {
   return new JSONTraceWriter(stream);
 }
 
+BinaryTraceWriter::BinaryTraceWriter(std::ostream& stream) : stream_(stream) {
+  buffer_.append("V8TB");
+  WriteVarint(kFormatVersion);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter() {
+  WriteVarint(kEnd);
+  Flush();
+}
+
+void BinaryTraceWriter::WriteBytes(const char* bytes, size_t length) {
+  buffer_.append(bytes, length);
+}
+
+void BinaryTraceWriter::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    buffer_.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  buffer_.push_back(static_cast<char>(value));
+}
+
+void BinaryTraceWriter::WriteSignedVarint(int64_t value) {
+  WriteVarint((static_cast<uint64_t>(value) << 1) ^
+              static_cast<uint64_t>(value >> 63));
+}
+
+uint64_t BinaryTraceWriter::InternString(const char* str) {
+  auto it = strings_.find(str);
+  if (it != strings_.end()) return it->second;
+  // Id 0 is reserved for the absent string.
+  uint64_t id = strings_.size() + 1;
+  strings_.insert(std::make_pair(std::string(str), id));
+  size_t length = strlen(str);
+  WriteVarint(kString);
+  WriteVarint(id);
+  WriteVarint(length);
+  WriteBytes(str, length);
+  return id;
+}
+
+void BinaryTraceWriter::SwitchToThread(int pid, int tid) {
+  if (current_thread_ != nullptr && pid == current_pid_ &&
+      tid == current_tid_) {
+    return;
+  }
+  current_pid_ = pid;
+  current_tid_ = tid;
+  current_thread_ = &threads_[tid];
+  WriteVarint(kThread);
+  WriteSignedVarint(pid);
+  WriteSignedVarint(tid);
+}
+
+void BinaryTraceWriter::WriteArgValue(uint8_t type,
+                                      TraceObject::ArgValue value) {
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      WriteVarint(value.as_bool ? 1 : 0);
+      break;
+    case TRACE_VALUE_TYPE_UINT:
+      WriteVarint(value.as_uint);
+      break;
+    case TRACE_VALUE_TYPE_INT:
+      WriteSignedVarint(value.as_int);
+      break;
+    case TRACE_VALUE_TYPE_DOUBLE: {
+      uint64_t bits;
+      memcpy(&bits, &value.as_double, sizeof(bits));
+      for (int i = 0; i < 8; ++i) {
+        buffer_.push_back(static_cast<char>(bits >> (8 * i)));
+      }
+      break;
+    }
+    case TRACE_VALUE_TYPE_POINTER:
+      WriteVarint(reinterpret_cast<uintptr_t>(value.as_pointer));
+      break;
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING:
+      if (value.as_string == nullptr) {
+        WriteVarint(0);
+      } else {
+        size_t length = strlen(value.as_string);
+        WriteVarint(length + 1);
+        WriteBytes(value.as_string, length);
+      }
+      break;
+    default:
+      UNREACHABLE();
+      break;
+  }
+}
+
+void BinaryTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
+  SwitchToThread(trace_event->pid(), trace_event->tid());
+  // Strings are interned before the event record starts.
+  uint64_t category = InternString(TracingController::GetCategoryGroupName(
+      trace_event->category_enabled_flag()));
+  uint64_t name = InternString(trace_event->name());
+  bool has_id = trace_event->flags() & TRACE_EVENT_FLAG_HAS_ID;
+  uint64_t scope = 0;
+  if (has_id && trace_event->scope() != nullptr) {
+    scope = InternString(trace_event->scope());
+  }
+  const char** arg_names = trace_event->arg_names();
+  uint64_t arg_name_ids[kTraceMaxNumArgs];
+  for (int i = 0; i < trace_event->num_args(); ++i) {
+    arg_name_ids[i] = InternString(arg_names[i]);
+  }
+
+  WriteVarint(kEvent);
+  buffer_.push_back(trace_event->phase());
+  WriteVarint(category);
+  WriteVarint(name);
+  WriteSignedVarint(trace_event->ts() - current_thread_->last_ts);
+  WriteSignedVarint(trace_event->tts() - current_thread_->last_tts);
+  current_thread_->last_ts = trace_event->ts();
+  current_thread_->last_tts = trace_event->tts();
+  WriteVarint(trace_event->duration());
+  WriteVarint(trace_event->cpu_duration());
+  WriteVarint(trace_event->flags());
+  if (has_id) {
+    WriteVarint(scope);
+    WriteVarint(trace_event->id());
+  }
+  WriteVarint(trace_event->num_args());
+  const uint8_t* arg_types = trace_event->arg_types();
+  TraceObject::ArgValue* arg_values = trace_event->arg_values();
+  std::unique_ptr<v8::ConvertableToTraceFormat>* arg_convertables =
+      trace_event->arg_convertables();
+  for (int i = 0; i < trace_event->num_args(); ++i) {
+    WriteVarint(arg_name_ids[i]);
+    buffer_.push_back(static_cast<char>(arg_types[i]));
+    if (arg_types[i] == TRACE_VALUE_TYPE_CONVERTABLE) {
+      std::string arg_stringified;
+      arg_convertables[i]->AppendAsTraceFormat(&arg_stringified);
+      WriteVarint(arg_stringified.size() + 1);
+      WriteBytes(arg_stringified.data(), arg_stringified.size());
+    } else {
+      WriteArgValue(arg_types[i], arg_values[i]);
+    }
+  }
+  if (buffer_.size() >= kBufferSize) WriteBuffer();
+}
+
+void BinaryTraceWriter::WriteBuffer() {
+  stream_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+void BinaryTraceWriter::Flush() {
+  WriteBuffer();
+  stream_.flush();
+}
+
+TraceWriter* TraceWriter::CreateBinaryTraceWriter(std::ostream& stream) {
+  return new BinaryTraceWriter(stream);
+}
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
@@ -5,6 +5,9 @@
 #ifndef SRC_LIBPLATFORM_TRACING_TRACE_WRITER_H_
 #define SRC_LIBPLATFORM_TRACING_TRACE_WRITER_H_
 
+#include <string>
+#include <unordered_map>
+
 #include "include/libplatform/v8-tracing.h"
 
 namespace v8 {
@@ -26,6 +29,57 @@ class JSONTraceWriter : public TraceWriter {
   bool append_comma_ = false;
 };
 
+// Writes events in a binary format that is much smaller and cheaper to
+// produce than JSON. All integers are LEB128 varints, signed ones are
+// zigzag encoded. The stream starts with the bytes "V8TB" and
+// kFormatVersion, followed by records that start with a RecordTag:
+//   kString: id, length, bytes. Defines an interned string.
+//   kThread: pid, tid. Switches to the stream of the given thread.
+//   kEvent:  phase, category, name, ts delta, tts delta, duration,
+//            cpu duration, flags, [scope, id if TRACE_EVENT_FLAG_HAS_ID],
+//            number of arguments, then per argument: name, type, value.
+//   kEnd:    terminates the trace.
+// Categories, names, scopes and argument names are string ids. Timestamps
+// are deltas to the previous event of the same thread. Argument values are
+// varints for bool, uint and pointer types, zigzag varints for int, 8 raw
+// little-endian bytes for double, and length + 1 followed by the bytes for
+// strings and convertables (0 for a null string).
+class BinaryTraceWriter : public TraceWriter {
+ public:
+  enum RecordTag { kEnd = 0, kString = 1, kThread = 2, kEvent = 3 };
+  static const int kFormatVersion = 1;
+  // Events are buffered and written to the stream in blocks of this size.
+  static const size_t kBufferSize = 64 * 1024;
+
+  explicit BinaryTraceWriter(std::ostream& stream);
+  ~BinaryTraceWriter();
+  void AppendTraceEvent(TraceObject* trace_event) override;
+  void Flush() override;
+
+ private:
+  struct ThreadState {
+    int64_t last_ts = 0;
+    int64_t last_tts = 0;
+  };
+
+  // Returns the id of |str|, writing a string record if it is new.
+  uint64_t InternString(const char* str);
+  void SwitchToThread(int pid, int tid);
+  void WriteArgValue(uint8_t type, TraceObject::ArgValue value);
+  void WriteBuffer();
+  void WriteBytes(const char* bytes, size_t length);
+  void WriteVarint(uint64_t value);
+  void WriteSignedVarint(int64_t value);
+
+  std::ostream& stream_;
+  std::string buffer_;
+  std::unordered_map<std::string, uint64_t> strings_;
+  std::unordered_map<int, ThreadState> threads_;
+  int current_pid_ = 0;
+  int current_tid_ = 0;
+  ThreadState* current_thread_ = nullptr;
+};
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
@@ -5,8 +5,11 @@
 #include "src/log-utils.h"
 
 #include "src/assert-scope.h"
+#include "src/base/atomicops.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "src/objects-inl.h"
+#include "src/profiler/mpsc-queue-inl.h"
 #include "src/string-stream.h"
 #include "src/utils.h"
 #include "src/version.h"
@@ -18,11 +21,95 @@ namespace internal {
 const char* const Log::kLogToTemporaryFile = "&";
 const char* const Log::kLogToConsole = "-";
 
+// Writes chunks of log messages to the log file. Full chunks are passed from
+// the logging threads through a lock-free queue and recycled afterwards.
+class Log::Writer : public base::Thread {
+ public:
+  Writer(Log* log, FILE* output)
+      : base::Thread(base::Thread::Options("v8:LogWriter")),
+        log_(log),
+        output_(output),
+        running_(1),
+        failed_(0),
+        semaphore_(0) {}
+
+  ~Writer() override {
+    Chunk* chunk;
+    while (free_chunks_.Dequeue(&chunk)) delete chunk;
+  }
+
+  // The queues are cache line aligned, which plain new does not guarantee.
+  void* operator new(size_t size) {
+    return AlignedAlloc(size, V8_ALIGNOF(Writer));
+  }
+  void operator delete(void* ptr) { AlignedFree(ptr); }
+
+  // Called with the log mutex held, which makes it the only consumer of
+  // free_chunks_.
+  Chunk* NewChunk() {
+    Chunk* chunk;
+    if (!free_chunks_.Dequeue(&chunk)) chunk = new Chunk();
+    chunk->length = 0;
+    return chunk;
+  }
+
+  void Enqueue(Chunk* chunk) {
+    full_chunks_.Enqueue(chunk);
+    semaphore_.Signal();
+  }
+
+  // Writes all enqueued chunks and stops the thread.
+  void Stop() {
+    base::Release_Store(&running_, 0);
+    semaphore_.Signal();
+    Join();
+  }
+
+  bool failed() const { return base::Acquire_Load(&failed_) != 0; }
+
+  void Run() override {
+    // Shorter intervals would turn the loop into a busy wait.
+    base::TimeDelta flush_interval = base::TimeDelta::FromMilliseconds(
+        Max(1, FLAG_log_async_flush_interval));
+    while (base::Acquire_Load(&running_)) {
+      if (!semaphore_.WaitFor(flush_interval)) log_->FlushChunk();
+      WriteChunks();
+    }
+    WriteChunks();
+  }
+
+ private:
+  void WriteChunks() {
+    bool written = false;
+    Chunk* chunk;
+    while (full_chunks_.Dequeue(&chunk)) {
+      size_t rv = fwrite(chunk->data, 1, chunk->length, output_);
+      if (rv != static_cast<size_t>(chunk->length)) {
+        base::Release_Store(&failed_, 1);
+      }
+      free_chunks_.Enqueue(chunk);
+      written = true;
+    }
+    if (written) fflush(output_);
+  }
+
+  Log* log_;
+  FILE* output_;
+  base::Atomic32 running_;
+  base::Atomic32 failed_;
+  base::Semaphore semaphore_;
+  MpscQueue<Chunk*> full_chunks_;
+  MpscQueue<Chunk*> free_chunks_;
+
+  DISALLOW_COPY_AND_ASSIGN(Writer);
+};
 
 Log::Log(Logger* logger)
   : is_stopped_(false),
     output_handle_(NULL),
     message_buffer_(NULL),
+    writer_(NULL),
+    current_chunk_(NULL),
     logger_(logger) {
 }
 
@@ -53,6 +140,11 @@ void Log::Initialize(const char* log_file_name) {
       OpenFile(log_file_name);
     }
 
+    if (output_handle_ != nullptr && FLAG_log_async) {
+      writer_ = new Writer(this, output_handle_);
+      writer_->Start();
+    }
+
     if (output_handle_ != nullptr) {
       Log::MessageBuilder msg(this);
       msg.Append("v8-version,%d,%d,%d,%d,%d", Version::GetMajor(),
@@ -82,8 +174,46 @@ void Log::OpenFile(const char* name) {
 }
 
 
+int Log::WriteToChunk(const char* msg, int length) {
+  STATIC_ASSERT(kMessageBufferSize <= Chunk::kSize);
+  // Report write errors of the writer thread as failed writes.
+  if (writer_->failed()) return 0;
+  if (current_chunk_ != NULL &&
+      current_chunk_->length + length > Chunk::kSize) {
+    HandOffChunk();
+  }
+  if (current_chunk_ == NULL) current_chunk_ = writer_->NewChunk();
+  DCHECK_LE(current_chunk_->length + length, Chunk::kSize);
+  MemCopy(current_chunk_->data + current_chunk_->length, msg, length);
+  current_chunk_->length += length;
+  return length;
+}
+
+
+void Log::HandOffChunk() {
+  if (current_chunk_ == NULL) return;
+  writer_->Enqueue(current_chunk_);
+  current_chunk_ = NULL;
+}
+
+
+void Log::FlushChunk() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  HandOffChunk();
+}
+
+
 FILE* Log::Close() {
   FILE* result = NULL;
+  if (writer_ != NULL) {
+    {
+      base::LockGuard<base::Mutex> lock_guard(&mutex_);
+      HandOffChunk();
+    }
+    writer_->Stop();
+    delete writer_;
+    writer_ = NULL;
+  }
   if (output_handle_ != NULL) {
     if (strcmp(FLAG_logfile, kLogToTemporaryFile) != 0) {
       fclose(output_handle_);
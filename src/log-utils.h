@@ -111,6 +111,7 @@ class Log {
   // Implementation of writing to a log file.
   int WriteToFile(const char* msg, int length) {
     DCHECK_NOT_NULL(output_handle_);
+    if (writer_ != NULL) return WriteToChunk(msg, length);
     size_t rv = fwrite(msg, 1, length, output_handle_);
     DCHECK_EQ(length, rv);
     USE(rv);
@@ -118,6 +119,27 @@ class Log {
     return length;
   }
 
+  // With --log-async, messages are collected in chunks, which are written to
+  // the log file by a background thread. This avoids blocking the threads
+  // that generate log events on file I/O.
+  class Writer;
+
+  struct Chunk : public Malloced {
+    static const int kSize = 64 * KB;
+    int length;
+    char data[kSize];
+  };
+
+  // Appends the message to the current chunk. mutex_ must be held.
+  int WriteToChunk(const char* msg, int length);
+
+  // Hands the current chunk over to the writer thread. mutex_ must be held.
+  void HandOffChunk();
+
+  // Hands the current chunk over to the writer thread, so that pending
+  // messages show up in the log file. Called by the writer thread.
+  void FlushChunk();
+
   // Whether logging is stopped (e.g. due to insufficient resources).
   bool is_stopped_;
 
@@ -133,6 +155,12 @@ class Log {
   // mutex_ should be acquired before using it.
   char* message_buffer_;
 
+  // Background writer thread and the chunk that is currently filled, if
+  // --log-async is enabled. mutex_ should be acquired before using
+  // current_chunk_.
+  Writer* writer_;
+  Chunk* current_chunk_;
+
   Logger* logger_;
 
   friend class Logger;
@@ -619,6 +619,7 @@ class Ticker: public sampler::Sampler {
   Ticker(Isolate* isolate, int interval)
       : sampler::Sampler(reinterpret_cast<v8::Isolate*>(isolate)),
         profiler_(nullptr),
+        interval_(base::TimeDelta::FromMilliseconds(interval)),
         sampling_thread_(new SamplingThread(this, interval)) {}
 
   ~Ticker() {
@@ -644,6 +645,11 @@ class Ticker: public sampler::Sampler {
   void SampleStack(const v8::RegisterState& state) override {
     if (!profiler_) return;
     Isolate* isolate = reinterpret_cast<Isolate*>(this->isolate());
+    if (V8_UNLIKELY(
+            FLAG_runtime_stats &
+            v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLING)) {
+      isolate->counters()->runtime_call_stats()->AttributeSample(interval_);
+    }
     TickSample sample;
     sample.Init(isolate, state, TickSample::kIncludeCEntryFrame, true);
     profiler_->Insert(&sample);
@@ -651,6 +657,7 @@ class Ticker: public sampler::Sampler {
 
  private:
   Profiler* profiler_;
+  const base::TimeDelta interval_;
   SamplingThread* sampling_thread_;
 };
 
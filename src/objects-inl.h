@@ -1534,6 +1534,18 @@ void HeapObject::synchronized_set_map_word(MapWord map_word) {
 }
 
 
+bool HeapObject::synchronized_compare_and_swap_map_word(MapWord old_map_word,
+                                                        MapWord new_map_word) {
+  base::AtomicWord* map_word_address =
+      reinterpret_cast<base::AtomicWord*>(FIELD_ADDR(this, kMapOffset));
+  base::AtomicWord old_value =
+      static_cast<base::AtomicWord>(old_map_word.value_);
+  return base::Release_CompareAndSwap(
+             map_word_address, old_value,
+             static_cast<base::AtomicWord>(new_map_word.value_)) == old_value;
+}
+
+
 int HeapObject::Size() {
   return SizeFromMap(map());
 }
@@ -1706,6 +1718,11 @@ void AllocationSite::set_deopt_dependent_code(bool deopt) {
   set_pretenure_data(DeoptDependentCodeBit::update(value, deopt));
 }
 
+bool AllocationSite::is_pretenure_decision_pinned() {
+  int value = pretenure_data();
+  return PretenureDecisionPinnedBit::decode(value);
+}
+
 
 int AllocationSite::memento_found_count() {
   int value = pretenure_data();
@@ -1786,7 +1803,7 @@ inline bool AllocationSite::DigestPretenuringFeedback(
           static_cast<double>(found_count) / create_count : 0.0;
   PretenureDecision current_decision = pretenure_decision();
 
-  if (minimum_mementos_created) {
+  if (minimum_mementos_created && !is_pretenure_decision_pinned()) {
     deopt = MakePretenureDecision(
         current_decision, ratio, maximum_size_scavenge);
   }
@@ -40,6 +40,7 @@
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/globals.h"
+#include "src/heap/array-buffer-collector.h"
 #include "src/ic/ic.h"
 #include "src/identity-map.h"
 #include "src/interpreter/bytecode-array-iterator.h"
@@ -2509,6 +2510,8 @@ bool String::MakeExternal(v8::String::ExternalStringResource* resource) {
 
   // Byte size of the external String object.
   int new_size = this->SizeFromMap(new_map);
+  DisallowHeapAllocation no_allocation;
+  heap->NotifyObjectLayoutChange(this, no_allocation);
   heap->CreateFillerObjectAt(this->address() + new_size, size - new_size,
                              ClearRecordedSlots::kNo);
   if (has_pointers) {
@@ -2575,6 +2578,8 @@ bool String::MakeExternal(v8::String::ExternalOneByteStringResource* resource) {
 
   // Byte size of the external String object.
   int new_size = this->SizeFromMap(new_map);
+  DisallowHeapAllocation no_allocation;
+  heap->NotifyObjectLayoutChange(this, no_allocation);
   heap->CreateFillerObjectAt(this->address() + new_size, size - new_size,
                              ClearRecordedSlots::kNo);
   if (has_pointers) {
@@ -15432,11 +15437,33 @@ const double AllocationSite::kPretenureRatio = 0.85;
 
 
 void AllocationSite::ResetPretenureDecision() {
-  set_pretenure_decision(kUndecided);
+  if (!is_pretenure_decision_pinned()) set_pretenure_decision(kUndecided);
   set_memento_found_count(0);
   set_memento_create_count(0);
 }
 
+bool AllocationSite::SetPinnedMode(PinnedMode mode) {
+  if (IsZombie()) return false;
+  PretenureFlag old_mode = GetPretenureMode();
+  int value = pretenure_data();
+  switch (mode) {
+    case kNotPinned:
+      // The heuristics start over from the current decision.
+      set_pretenure_data(PretenureDecisionPinnedBit::update(value, false));
+      return false;
+    case kPinnedTenured:
+      value = PretenureDecisionBits::update(value, kTenure);
+      break;
+    case kPinnedNotTenured:
+      value = PretenureDecisionBits::update(value, kDontTenure);
+      break;
+  }
+  set_pretenure_data(PretenureDecisionPinnedBit::update(value, true));
+  if (GetPretenureMode() == old_mode) return false;
+  set_deopt_dependent_code(true);
+  return true;
+}
+
 
 PretenureFlag AllocationSite::GetPretenureMode() {
   PretenureDecision mode = pretenure_decision();
@@ -15552,8 +15579,8 @@ bool JSObject::UpdateAllocationSite(Handle<JSObject> object,
   {
     DisallowHeapAllocation no_allocation;
 
-    AllocationMemento* memento =
-        heap->FindAllocationMemento<Heap::kForRuntime>(*object);
+    AllocationMemento* memento = heap->FindAllocationMemento<Heap::kForRuntime>(
+        object->map(), *object);
     if (memento == NULL) return false;
 
     // Walk through to the Allocation Site
@@ -17288,6 +17315,7 @@ Handle<String> StringTable::LookupString(Isolate* isolate,
                             : isolate->factory()->thin_string_map();
       int old_size = string->Size();
       DCHECK(old_size >= ThinString::kSize);
+      isolate->heap()->NotifyObjectLayoutChange(*string, no_gc);
       string->synchronized_set_map(*map);
       Handle<ThinString> thin = Handle<ThinString>::cast(string);
       thin->set_actual(*result);
@@ -19280,6 +19308,7 @@ bool JSArrayBuffer::SetupAllocatingData(Handle<JSArrayBuffer> array_buffer,
   // Prevent creating array buffers when serializing.
   DCHECK(!isolate->serializer_enabled());
   if (allocated_length != 0) {
+    isolate->heap()->array_buffer_collector()->EnsureWithinBudget();
     if (initialize) {
       data = isolate->array_buffer_allocator()->Allocate(allocated_length);
     } else {
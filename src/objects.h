@@ -1650,6 +1650,10 @@ class HeapObject: public Object {
   inline void synchronized_set_map(Map* value);
   inline void synchronized_set_map_no_write_barrier(Map* value);
   inline void synchronized_set_map_word(MapWord map_word);
+  // Compare-and-swap of the map word using release semantics. Returns true iff
+  // the map word was |old_map_word| and has been replaced.
+  inline bool synchronized_compare_and_swap_map_word(MapWord old_map_word,
+                                                     MapWord new_map_word);
 
   // During garbage collection, the map word of a heap object does not
   // necessarily contain a map pointer.
@@ -8832,11 +8836,21 @@ class AllocationSite: public Struct {
   class DoNotInlineBit:         public BitField<bool,         29,  1> {};
 
   // Bitfields for pretenure_data
-  class MementoFoundCountBits:  public BitField<int,               0, 26> {};
-  class PretenureDecisionBits:  public BitField<PretenureDecision, 26, 3> {};
-  class DeoptDependentCodeBit:  public BitField<bool,              29, 1> {};
+  class MementoFoundCountBits:  public BitField<int,               0, 25> {};
+  class PretenureDecisionBits:  public BitField<PretenureDecision, 25, 3> {};
+  class DeoptDependentCodeBit:  public BitField<bool,              28, 1> {};
+  class PretenureDecisionPinnedBit: public BitField<bool,          29, 1> {};
   STATIC_ASSERT(PretenureDecisionBits::kMax >= kLastPretenureDecisionValue);
 
+  // Pinning modes for embedder overrides of the pretenuring decision.
+  enum PinnedMode { kNotPinned, kPinnedTenured, kPinnedNotTenured };
+
+  // Sets or clears a pinned pretenuring decision. Pinned decisions are not
+  // changed by DigestPretenuringFeedback or ResetPretenureDecision. Returns
+  // true if dependent code needs to be deoptimized.
+  bool SetPinnedMode(PinnedMode mode);
+  inline bool is_pretenure_decision_pinned();
+
   // Increments the mementos found counter and returns true when the first
   // memento was found for a given allocation site.
   inline bool IncrementMementoFoundCount(int increment = 1);
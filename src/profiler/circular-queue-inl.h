@@ -12,8 +12,11 @@ namespace internal {
 
 template<typename T, unsigned L>
 SamplingCircularQueue<T, L>::SamplingCircularQueue()
-    : enqueue_pos_(buffer_),
-      dequeue_pos_(buffer_) {
+    : enqueue_pos_(0),
+      dequeue_pos_(0) {
+  for (unsigned i = 0; i < L; i++) {
+    base::NoBarrier_Store(&buffer_[i].sequence, i);
+  }
 }
 
 
@@ -24,9 +27,9 @@ SamplingCircularQueue<T, L>::~SamplingCircularQueue() {
 
 template<typename T, unsigned L>
 T* SamplingCircularQueue<T, L>::Peek() {
-  base::MemoryBarrier();
-  if (base::Acquire_Load(&dequeue_pos_->marker) == kFull) {
-    return &dequeue_pos_->record;
+  Entry* entry = EntryAt(dequeue_pos_);
+  if (base::Acquire_Load(&entry->sequence) == Advance(dequeue_pos_, 1)) {
+    return &entry->record;
   }
   return NULL;
 }
@@ -34,34 +37,46 @@ T* SamplingCircularQueue<T, L>::Peek() {
 
 template<typename T, unsigned L>
 void SamplingCircularQueue<T, L>::Remove() {
-  base::Release_Store(&dequeue_pos_->marker, kEmpty);
-  dequeue_pos_ = Next(dequeue_pos_);
+  // Hand the entry over to the producers of the next round.
+  base::Release_Store(&EntryAt(dequeue_pos_)->sequence,
+                      Advance(dequeue_pos_, L));
+  dequeue_pos_ = Advance(dequeue_pos_, 1);
 }
 
 
 template<typename T, unsigned L>
 T* SamplingCircularQueue<T, L>::StartEnqueue() {
-  base::MemoryBarrier();
-  if (base::Acquire_Load(&enqueue_pos_->marker) == kEmpty) {
-    return &enqueue_pos_->record;
+  base::AtomicWord position = base::NoBarrier_Load(&enqueue_pos_);
+  while (true) {
+    Entry* entry = EntryAt(position);
+    intptr_t distance =
+        Distance(position, base::Acquire_Load(&entry->sequence));
+    if (distance == 0) {
+      base::AtomicWord previous = base::NoBarrier_CompareAndSwap(
+          &enqueue_pos_, position, Advance(position, 1));
+      if (previous == position) return &entry->record;
+      // Another producer claimed the entry first.
+      position = previous;
+    } else if (distance < 0) {
+      // The entry still holds a record of the previous round.
+      dropped_count_.Increment(1);
+      return NULL;
+    } else {
+      position = base::NoBarrier_Load(&enqueue_pos_);
+    }
   }
-  return NULL;
-}
-
-
-template<typename T, unsigned L>
-void SamplingCircularQueue<T, L>::FinishEnqueue() {
-  base::Release_Store(&enqueue_pos_->marker, kFull);
-  enqueue_pos_ = Next(enqueue_pos_);
 }
 
 
 template<typename T, unsigned L>
-typename SamplingCircularQueue<T, L>::Entry* SamplingCircularQueue<T, L>::Next(
-    Entry* entry) {
-  Entry* next = entry + 1;
-  if (next == &buffer_[L]) return buffer_;
-  return next;
+void SamplingCircularQueue<T, L>::FinishEnqueue(T* record) {
+  size_t index = (reinterpret_cast<byte*>(record) -
+                  reinterpret_cast<byte*>(buffer_)) / sizeof(Entry);
+  DCHECK_LT(index, L);
+  Entry* entry = &buffer_[index];
+  DCHECK_EQ(&entry->record, record);
+  base::Release_Store(&entry->sequence,
+                      Advance(base::NoBarrier_Load(&entry->sequence), 1));
 }
 
 }  // namespace internal
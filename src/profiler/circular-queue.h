@@ -5,6 +5,7 @@
 #ifndef V8_PROFILER_CIRCULAR_QUEUE_H_
 #define V8_PROFILER_CIRCULAR_QUEUE_H_
 
+#include "src/base/atomic-utils.h"
 #include "src/base/atomicops.h"
 #include "src/globals.h"
 
@@ -13,14 +14,22 @@ namespace internal {
 
 
 // Lock-free cache-friendly sampling circular queue for large
-// records. Intended for fast transfer of large records between a
-// single producer and a single consumer. If the queue is full,
-// StartEnqueue will return NULL. The queue is designed with
-// a goal in mind to evade cache lines thrashing by preventing
-// simultaneous reads and writes to adjanced memory locations.
+// records. Intended for fast transfer of large records between any
+// number of producers and a single consumer. If the queue is full,
+// StartEnqueue will return NULL and the record is counted as dropped.
+// The queue is designed with a goal in mind to evade cache lines
+// thrashing by preventing simultaneous reads and writes to adjanced
+// memory locations.
+//
+// Each entry carries a sequence number (see D. Vyukov's bounded MPMC
+// queue). Producers claim entries by advancing the enqueue position with
+// a compare-and-swap, so no locks are taken, which makes StartEnqueue and
+// FinishEnqueue safe to use from signal handlers.
 template<typename T, unsigned Length>
 class SamplingCircularQueue {
  public:
+  STATIC_ASSERT(Length > 0 && (Length & (Length - 1)) == 0);
+
   // Executed on the application thread.
   SamplingCircularQueue();
   ~SamplingCircularQueue();
@@ -28,9 +37,13 @@ class SamplingCircularQueue {
   // StartEnqueue returns a pointer to a memory location for storing the next
   // record or NULL if all entries are full at the moment.
   T* StartEnqueue();
-  // Notifies the queue that the producer has complete writing data into the
-  // memory returned by StartEnqueue and it can be passed to the consumer.
-  void FinishEnqueue();
+  // Notifies the queue that the producer has complete writing data into
+  // |record|, as returned by StartEnqueue, and it can be passed to the
+  // consumer.
+  void FinishEnqueue(T* record);
+
+  // Number of records that were dropped because the queue was full.
+  unsigned dropped_count() const { return dropped_count_.Value(); }
 
   // Executed on the consumer (analyzer) thread.
   // Retrieves, but does not remove, the head of this queue, returning NULL
@@ -40,24 +53,31 @@ class SamplingCircularQueue {
   void Remove();
 
  private:
-  // Reserved values for the entry marker.
-  enum {
-    kEmpty,  // Marks clean (processed) entries.
-    kFull    // Marks entries already filled by the producer but not yet
-             // completely processed by the consumer.
-  };
-
+  // The sequence of an entry equals the position it can be enqueued at if it
+  // is clean (processed), and that position + 1 once it was filled by a
+  // producer. The consumer resets it to the position of the next round.
   struct V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) Entry {
-    Entry() : marker(kEmpty) {}
     T record;
-    base::Atomic32 marker;
+    base::AtomicWord sequence;
   };
 
-  Entry* Next(Entry* entry);
+  // Positions wrap around, so they are advanced and compared as unsigned.
+  static base::AtomicWord Advance(base::AtomicWord position, uintptr_t delta) {
+    return static_cast<base::AtomicWord>(static_cast<uintptr_t>(position) +
+                                         delta);
+  }
+  static intptr_t Distance(base::AtomicWord from, base::AtomicWord to) {
+    return static_cast<intptr_t>(static_cast<uintptr_t>(to) -
+                                 static_cast<uintptr_t>(from));
+  }
+  Entry* EntryAt(base::AtomicWord position) {
+    return &buffer_[static_cast<uintptr_t>(position) & (Length - 1)];
+  }
 
   Entry buffer_[Length];
-  V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) Entry* enqueue_pos_;
-  V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) Entry* dequeue_pos_;
+  V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) base::AtomicWord enqueue_pos_;
+  V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) base::AtomicWord dequeue_pos_;
+  base::AtomicNumber<unsigned> dropped_count_;
 
   DISALLOW_COPY_AND_ASSIGN(SamplingCircularQueue);
 };
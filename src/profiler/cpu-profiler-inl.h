@@ -50,17 +50,15 @@ void ReportBuiltinEventRecord::UpdateCodeMap(CodeMap* code_map) {
 }
 
 
-TickSample* ProfilerEventsProcessor::StartTickSample() {
+TickSampleEventRecord* ProfilerEventsProcessor::StartTickSample() {
   void* address = ticks_buffer_.StartEnqueue();
   if (address == NULL) return NULL;
-  TickSampleEventRecord* evt =
-      new (address) TickSampleEventRecord(last_code_event_id_.Value());
-  return &evt->sample;
+  return new (address) TickSampleEventRecord(last_code_event_id_.Value());
 }
 
 
-void ProfilerEventsProcessor::FinishTickSample() {
-  ticks_buffer_.FinishEnqueue();
+void ProfilerEventsProcessor::FinishTickSample(TickSampleEventRecord* record) {
+  ticks_buffer_.FinishEnqueue(record);
 }
 
 }  // namespace internal
@@ -7,9 +7,10 @@
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
 #include "src/frames-inl.h"
-#include "src/locked-queue-inl.h"
 #include "src/log-inl.h"
 #include "src/profiler/cpu-profiler-inl.h"
+#include "src/profiler/mpsc-queue-inl.h"
+#include "src/tracing/tracing-category-observer.h"
 #include "src/vm-state-inl.h"
 
 namespace v8 {
@@ -24,15 +25,22 @@ class CpuSampler : public sampler::Sampler {
         processor_(processor) {}
 
   void SampleStack(const v8::RegisterState& regs) override {
-    TickSample* sample = processor_->StartTickSample();
-    if (sample == nullptr) return;
     Isolate* isolate = reinterpret_cast<Isolate*>(this->isolate());
+    if (V8_UNLIKELY(
+            FLAG_runtime_stats &
+            v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLING)) {
+      isolate->counters()->runtime_call_stats()->AttributeSample(
+          processor_->period());
+    }
+    TickSampleEventRecord* record = processor_->StartTickSample();
+    if (record == nullptr) return;
+    TickSample* sample = &record->sample;
     sample->Init(isolate, regs, TickSample::kIncludeCEntryFrame, true);
     if (is_counting_samples_ && !sample->timestamp.IsNull()) {
       if (sample->state == JS) ++js_sample_count_;
       if (sample->state == EXTERNAL) ++external_sample_count_;
     }
-    processor_->FinishTickSample();
+    processor_->FinishTickSample(record);
   }
 
  private:
@@ -48,7 +56,9 @@ ProfilerEventsProcessor::ProfilerEventsProcessor(Isolate* isolate,
       running_(1),
       period_(period),
       last_code_event_id_(0),
-      last_processed_code_event_id_(0) {
+      last_processed_code_event_id_(0),
+      wakeup_pending_(0),
+      wakeup_semaphore_(0) {
   sampler_->IncreaseProfilingDepth();
 }
 
@@ -59,6 +69,7 @@ ProfilerEventsProcessor::~ProfilerEventsProcessor() {
 void ProfilerEventsProcessor::Enqueue(const CodeEventsContainer& event) {
   event.generic.order = last_code_event_id_.Increment(1);
   events_buffer_.Enqueue(event);
+  WakeUp();
 }
 
 
@@ -72,6 +83,7 @@ void ProfilerEventsProcessor::AddDeoptStack(Isolate* isolate, Address from,
   regs.pc = from;
   record.sample.Init(isolate, regs, TickSample::kSkipCEntryFrame, false, false);
   ticks_from_vm_buffer_.Enqueue(record);
+  WakeUp();
 }
 
 void ProfilerEventsProcessor::AddCurrentStack(Isolate* isolate,
@@ -88,14 +100,40 @@ void ProfilerEventsProcessor::AddCurrentStack(Isolate* isolate,
   record.sample.Init(isolate, regs, TickSample::kSkipCEntryFrame, update_stats,
                      false);
   ticks_from_vm_buffer_.Enqueue(record);
+  WakeUp();
 }
 
 
 void ProfilerEventsProcessor::StopSynchronously() {
   if (!base::NoBarrier_AtomicExchange(&running_, 0)) return;
+  WakeUp();
   Join();
 }
 
+void ProfilerEventsProcessor::WakeUp() {
+  // Orders the enqueued event before the check, see ProcessEvents.
+  base::MemoryBarrier();
+  if (base::Acquire_CompareAndSwap(&wakeup_pending_, 0, 1) != 0) return;
+#if !V8_OS_WIN
+  // On Windows, WaitForEvents spins on wakeup_pending_ instead.
+  wakeup_semaphore_.Signal();
+#endif
+}
+
+bool ProfilerEventsProcessor::WaitForEvents(base::TimeDelta timeout) {
+#if V8_OS_WIN
+  // Do not use Sleep on Windows as it is very imprecise.
+  // Could be up to 16ms jitter, which is unacceptable for the purpose.
+  base::TimeTicks deadline = base::TimeTicks::HighResolutionNow() + timeout;
+  while (base::TimeTicks::HighResolutionNow() < deadline) {
+    if (base::Acquire_Load(&wakeup_pending_)) return true;
+  }
+  return false;
+#else
+  return wakeup_semaphore_.WaitFor(timeout);
+#endif
+}
+
 
 bool ProfilerEventsProcessor::ProcessCodeEvent() {
   CodeEventsContainer record;
@@ -142,33 +180,37 @@ ProfilerEventsProcessor::SampleProcessingResult
 }
 
 
+base::TimeTicks ProfilerEventsProcessor::ProcessEvents(
+    base::TimeTicks deadline) {
+  // Events enqueued from now on need another wakeup.
+  base::NoBarrier_Store(&wakeup_pending_, 0);
+  base::MemoryBarrier();
+  base::TimeTicks now;
+  SampleProcessingResult result;
+  // Keep processing existing events until we need to do next sample
+  // or the ticks buffer is empty.
+  do {
+    result = ProcessOneSample();
+    if (result == FoundSampleForNextCodeEvent) {
+      // All ticks of the current last_processed_code_event_id_ are
+      // processed, proceed to the next code event.
+      ProcessCodeEvent();
+    }
+    now = base::TimeTicks::HighResolutionNow();
+  } while (result != NoSamplesInQueue && now < deadline);
+  return now;
+}
+
 void ProfilerEventsProcessor::Run() {
   while (!!base::NoBarrier_Load(&running_)) {
     base::TimeTicks nextSampleTime =
         base::TimeTicks::HighResolutionNow() + period_;
-    base::TimeTicks now;
-    SampleProcessingResult result;
-    // Keep processing existing events until we need to do next sample
-    // or the ticks buffer is empty.
-    do {
-      result = ProcessOneSample();
-      if (result == FoundSampleForNextCodeEvent) {
-        // All ticks of the current last_processed_code_event_id_ are
-        // processed, proceed to the next code event.
-        ProcessCodeEvent();
-      }
-      now = base::TimeTicks::HighResolutionNow();
-    } while (result != NoSamplesInQueue && now < nextSampleTime);
-
-    if (nextSampleTime > now) {
-#if V8_OS_WIN
-      // Do not use Sleep on Windows as it is very imprecise.
-      // Could be up to 16ms jitter, which is unacceptable for the purpose.
-      while (base::TimeTicks::HighResolutionNow() < nextSampleTime) {
-      }
-#else
-      base::OS::Sleep(nextSampleTime - now);
-#endif
+    // Instead of polling, sleep until the next sample is due or until new
+    // code events or VM ticks arrive, so that they are processed promptly.
+    base::TimeTicks now = ProcessEvents(nextSampleTime);
+    while (now < nextSampleTime && WaitForEvents(nextSampleTime - now) &&
+           !!base::NoBarrier_Load(&running_)) {
+      now = ProcessEvents(nextSampleTime);
     }
 
     // Schedule next sample. sampler_ is NULL in tests.
@@ -246,7 +288,8 @@ CpuProfiler::CpuProfiler(Isolate* isolate)
       sampling_interval_(base::TimeDelta::FromMicroseconds(
           FLAG_cpu_profiler_sampling_interval)),
       profiles_(new CpuProfilesCollection(isolate)),
-      is_profiling_(false) {
+      is_profiling_(false),
+      dropped_samples_(0) {
   profiles_->set_cpu_profiler(this);
 }
 
@@ -259,7 +302,8 @@ CpuProfiler::CpuProfiler(Isolate* isolate, CpuProfilesCollection* test_profiles,
       profiles_(test_profiles),
       generator_(test_generator),
       processor_(test_processor),
-      is_profiling_(false) {
+      is_profiling_(false),
+      dropped_samples_(0) {
   profiles_->set_cpu_profiler(this);
 }
 
@@ -292,6 +336,10 @@ void CpuProfiler::CreateEntriesForRuntimeCallStats() {
   }
 }
 
+unsigned CpuProfiler::dropped_samples() const {
+  return dropped_samples_ + (processor_ ? processor_->dropped_samples() : 0);
+}
+
 void CpuProfiler::CollectSample() {
   if (processor_) {
     processor_->AddCurrentStack(isolate_);
@@ -364,6 +412,10 @@ void CpuProfiler::StopProcessor() {
   ProfilerListener* profiler_listener = logger->profiler_listener();
   profiler_listener->RemoveObserver(this);
   processor_->StopSynchronously();
+  unsigned dropped_samples = processor_->dropped_samples();
+  dropped_samples_ += dropped_samples;
+  isolate_->counters()->cpu_profiler_dropped_samples()->Increment(
+      static_cast<int>(dropped_samples));
   logger->TearDownProfilerListener();
   processor_.reset();
   generator_.reset();
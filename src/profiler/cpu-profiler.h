@@ -10,11 +10,12 @@
 #include "src/allocation.h"
 #include "src/base/atomic-utils.h"
 #include "src/base/atomicops.h"
+#include "src/base/platform/semaphore.h"
 #include "src/base/platform/time.h"
 #include "src/isolate.h"
 #include "src/libsampler/sampler.h"
-#include "src/locked-queue.h"
 #include "src/profiler/circular-queue.h"
+#include "src/profiler/mpsc-queue.h"
 #include "src/profiler/profiler-listener.h"
 #include "src/profiler/tick-sample.h"
 
@@ -148,9 +149,12 @@ class ProfilerEventsProcessor : public base::Thread {
   // Tick sample events are filled directly in the buffer of the circular
   // queue (because the structure is of fixed width, but usually not all
   // stack frame entries are filled.) This method returns a pointer to the
-  // next record of the buffer.
-  inline TickSample* StartTickSample();
-  inline void FinishTickSample();
+  // next record of the buffer, or NULL if the sample has to be dropped.
+  inline TickSampleEventRecord* StartTickSample();
+  inline void FinishTickSample(TickSampleEventRecord* record);
+
+  // Number of tick samples dropped because the ticks buffer was full.
+  unsigned dropped_samples() const { return ticks_buffer_.dropped_count(); }
 
   // SamplingCircularQueue has stricter alignment requirements than a normal new
   // can fulfil, so we need to provide our own new/delete here.
@@ -158,6 +162,7 @@ class ProfilerEventsProcessor : public base::Thread {
   void operator delete(void* ptr);
 
   sampler::Sampler* sampler() { return sampler_.get(); }
+  base::TimeDelta period() const { return period_; }
 
  private:
   // Called from events processing thread (Run() method.)
@@ -169,20 +174,34 @@ class ProfilerEventsProcessor : public base::Thread {
     NoSamplesInQueue
   };
   SampleProcessingResult ProcessOneSample();
+  // Processes samples and code events until the queues are drained or
+  // |deadline| is reached. Returns the current time.
+  base::TimeTicks ProcessEvents(base::TimeTicks deadline);
+
+  // Wakes up the processor thread if it is waiting for events. Must not be
+  // called from a signal handler.
+  void WakeUp();
+  // Waits until WakeUp is called or |timeout| elapses. Returns false on
+  // timeout.
+  bool WaitForEvents(base::TimeDelta timeout);
 
   ProfileGenerator* generator_;
   std::unique_ptr<sampler::Sampler> sampler_;
   base::Atomic32 running_;
   const base::TimeDelta period_;  // Samples & code events processing period.
-  LockedQueue<CodeEventsContainer> events_buffer_;
-  static const size_t kTickSampleBufferSize = 1 * MB;
-  static const size_t kTickSampleQueueLength =
-      kTickSampleBufferSize / sizeof(TickSampleEventRecord);
+  MpscQueue<CodeEventsContainer> events_buffer_;
+  // Must be a power of two. This amounts to about 1MB of tick samples on
+  // 64-bit platforms.
+  static const unsigned kTickSampleQueueLength = 512;
   SamplingCircularQueue<TickSampleEventRecord,
                         kTickSampleQueueLength> ticks_buffer_;
-  LockedQueue<TickSampleEventRecord> ticks_from_vm_buffer_;
+  MpscQueue<TickSampleEventRecord> ticks_from_vm_buffer_;
   base::AtomicNumber<unsigned> last_code_event_id_;
   unsigned last_processed_code_event_id_;
+  // Set while a wakeup is signaled but not yet consumed by the processor
+  // thread, so that producers signal the semaphore at most once per round.
+  base::Atomic32 wakeup_pending_;
+  base::Semaphore wakeup_semaphore_;
 };
 
 class CpuProfiler : public CodeEventObserver {
@@ -196,6 +215,7 @@ class CpuProfiler : public CodeEventObserver {
   ~CpuProfiler() override;
 
   void set_sampling_interval(base::TimeDelta value);
+  base::TimeDelta sampling_interval() const { return sampling_interval_; }
   void CollectSample();
   void StartProfiling(const char* title, bool record_samples = false);
   void StartProfiling(String* title, bool record_samples);
@@ -213,6 +233,8 @@ class CpuProfiler : public CodeEventObserver {
   ProfileGenerator* generator() const { return generator_.get(); }
   ProfilerEventsProcessor* processor() const { return processor_.get(); }
   Isolate* isolate() const { return isolate_; }
+  // Number of tick samples dropped since the profiler was created.
+  unsigned dropped_samples() const;
 
  private:
   void StartProcessorIfNotStarted();
@@ -230,6 +252,8 @@ class CpuProfiler : public CodeEventObserver {
   std::vector<std::unique_ptr<CodeEntry>> static_entries_;
   bool saved_is_logging_;
   bool is_profiling_;
+  // Samples dropped by processors that were already stopped.
+  unsigned dropped_samples_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfiler);
 };
@@ -97,6 +97,29 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
   return result;
 }
 
+bool HeapProfiler::TakeStreamingSnapshot(
+    v8::OutputStream* stream, v8::ActivityControl* control,
+    v8::HeapProfiler::ObjectNameResolver* resolver) {
+  HeapSnapshot* snapshot = new HeapSnapshot(this);
+  HeapSnapshotStreamWriter writer(stream);
+  snapshot->set_stream_writer(&writer);
+  bool success;
+  {
+    HeapSnapshotGenerator generator(snapshot, control, resolver, heap());
+    success = generator.GenerateSnapshot();
+  }
+  if (success) writer.Finalize(snapshot);
+  success = success && !writer.aborted();
+  delete snapshot;
+  ids_->RemoveDeadEntries();
+  is_tracking_object_moves_ = true;
+
+  heap()->isolate()->debug()->feature_tracker()->Track(
+      DebugFeatureTracker::kHeapSnapshot);
+
+  return success;
+}
+
 bool HeapProfiler::StartSamplingHeapProfiler(
     uint64_t sample_interval, int stack_depth,
     v8::HeapProfiler::SamplingFlags flags) {
@@ -123,6 +146,14 @@ v8::AllocationProfile* HeapProfiler::GetAllocationProfile() {
 }
 
 
+bool HeapProfiler::WriteAllocationProfileDelta(OutputStream* stream) {
+  if (!sampling_heap_profiler_ || !sampling_heap_profiler_->delta_mode()) {
+    return false;
+  }
+  return sampling_heap_profiler_->WriteAllocationProfileDelta(stream);
+}
+
+
 void HeapProfiler::StartHeapObjectsTracking(bool track_allocations) {
   ids_->UpdateHeapObjectsMap();
   is_tracking_object_moves_ = true;
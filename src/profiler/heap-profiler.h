@@ -30,12 +30,18 @@ class HeapProfiler {
   HeapSnapshot* TakeSnapshot(
       v8::ActivityControl* control,
       v8::HeapProfiler::ObjectNameResolver* resolver);
+  // Generates a snapshot that is written to |stream| as it is taken, see
+  // HeapSnapshotStreamWriter. The snapshot is not retained.
+  bool TakeStreamingSnapshot(v8::OutputStream* stream,
+                             v8::ActivityControl* control,
+                             v8::HeapProfiler::ObjectNameResolver* resolver);
 
   bool StartSamplingHeapProfiler(uint64_t sample_interval, int stack_depth,
                                  v8::HeapProfiler::SamplingFlags);
   void StopSamplingHeapProfiler();
   bool is_sampling_allocations() { return !!sampling_heap_profiler_; }
   AllocationProfile* GetAllocationProfile();
+  bool WriteAllocationProfileDelta(OutputStream* stream);
 
   void StartHeapObjectsTracking(bool track_allocations);
   void StopHeapObjectsTracking();
@@ -69,6 +69,11 @@ HeapEntry::HeapEntry(HeapSnapshot* snapshot,
 void HeapEntry::SetNamedReference(HeapGraphEdge::Type type,
                                   const char* name,
                                   HeapEntry* entry) {
+  if (HeapSnapshotStreamWriter* writer = snapshot_->stream_writer()) {
+    writer->WriteNamedEdge(type, name, this->index(), entry->index());
+    ++children_count_;
+    return;
+  }
   HeapGraphEdge edge(type, name, this->index(), entry->index());
   snapshot_->edges().push_back(edge);
   ++children_count_;
@@ -78,6 +83,11 @@ void HeapEntry::SetNamedReference(HeapGraphEdge::Type type,
 void HeapEntry::SetIndexedReference(HeapGraphEdge::Type type,
                                     int index,
                                     HeapEntry* entry) {
+  if (HeapSnapshotStreamWriter* writer = snapshot_->stream_writer()) {
+    writer->WriteIndexedEdge(type, index, this->index(), entry->index());
+    ++children_count_;
+    return;
+  }
   HeapGraphEdge edge(type, index, this->index(), entry->index());
   snapshot_->edges().push_back(edge);
   ++children_count_;
@@ -187,7 +197,8 @@ HeapSnapshot::HeapSnapshot(HeapProfiler* profiler)
     : profiler_(profiler),
       root_index_(HeapEntry::kNoEntry),
       gc_roots_index_(HeapEntry::kNoEntry),
-      max_snapshot_js_object_id_(0) {
+      max_snapshot_js_object_id_(0),
+      stream_writer_(NULL) {
   STATIC_ASSERT(
       sizeof(HeapGraphEdge) ==
       SnapshotSizeConstants<kPointerSize>::kExpectedHeapGraphEdgeSize);
@@ -2536,7 +2547,8 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
 
   if (!FillReferences()) return false;
 
-  snapshot_->FillChildren();
+  // Streamed snapshots do not retain their edges.
+  if (snapshot_->stream_writer() == NULL) snapshot_->FillChildren();
   snapshot_->RememberLastJSObjectId();
 
   progress_counter_ = progress_total_;
@@ -2552,6 +2564,8 @@ void HeapSnapshotGenerator::ProgressStep() {
 
 bool HeapSnapshotGenerator::ProgressReport(bool force) {
   const int kProgressReportGranularity = 10000;
+  HeapSnapshotStreamWriter* writer = snapshot_->stream_writer();
+  if (writer != NULL && writer->aborted()) return false;
   if (control_ != NULL
       && (force || progress_counter_ % kProgressReportGranularity == 0)) {
       return
@@ -2607,6 +2621,12 @@ class OutputStreamWriter {
     chunk_[chunk_pos_++] = c;
     MaybeWriteChunk();
   }
+  // Unlike AddCharacter, accepts any byte value for binary output.
+  void AddByte(uint8_t b) {
+    DCHECK(chunk_pos_ < chunk_size_);
+    chunk_[chunk_pos_++] = static_cast<char>(b);
+    MaybeWriteChunk();
+  }
   void AddString(const char* s) {
     AddSubstring(s, StrLength(s));
   }
@@ -3132,5 +3152,95 @@ void HeapSnapshotJSONSerializer::SerializeStrings() {
 }
 
 
+HeapSnapshotStreamWriter::HeapSnapshotStreamWriter(v8::OutputStream* stream)
+    : writer_(new OutputStreamWriter(stream)),
+      strings_(StringsMatch),
+      next_string_id_(1) {
+  writer_->AddString("V8HS");
+  WriteVarint(kFormatVersion);
+}
+
+
+HeapSnapshotStreamWriter::~HeapSnapshotStreamWriter() { delete writer_; }
+
+
+bool HeapSnapshotStreamWriter::aborted() { return writer_->aborted(); }
+
+
+void HeapSnapshotStreamWriter::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    writer_->AddByte(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  writer_->AddByte(static_cast<uint8_t>(value));
+}
+
+
+unsigned HeapSnapshotStreamWriter::GetStringId(const char* s) {
+  base::HashMap::Entry* cache_entry =
+      strings_.LookupOrInsert(const_cast<char*>(s), StringHash(s));
+  if (cache_entry->value == NULL) {
+    unsigned id = next_string_id_++;
+    cache_entry->value = reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+    int length = StrLength(s);
+    WriteVarint(kString);
+    WriteVarint(id);
+    WriteVarint(length);
+    writer_->AddSubstring(s, length);
+  }
+  uintptr_t id = reinterpret_cast<uintptr_t>(cache_entry->value);
+  return static_cast<unsigned>(id);
+}
+
+
+void HeapSnapshotStreamWriter::WriteEdge(HeapGraphEdge::Type type,
+                                         unsigned name_or_index, int from,
+                                         int to) {
+  if (writer_->aborted()) return;
+  WriteVarint(kEdge);
+  WriteVarint(type);
+  WriteVarint(from);
+  WriteVarint(name_or_index);
+  WriteVarint(to);
+}
+
+
+void HeapSnapshotStreamWriter::WriteNamedEdge(HeapGraphEdge::Type type,
+                                              const char* name, int from,
+                                              int to) {
+  if (writer_->aborted()) return;
+  WriteEdge(type, GetStringId(name), from, to);
+}
+
+
+void HeapSnapshotStreamWriter::WriteIndexedEdge(HeapGraphEdge::Type type,
+                                                int index, int from, int to) {
+  WriteEdge(type, index, from, to);
+}
+
+
+void HeapSnapshotStreamWriter::WriteNode(HeapEntry* entry) {
+  unsigned name = GetStringId(entry->name());
+  WriteVarint(kNode);
+  WriteVarint(entry->type());
+  WriteVarint(name);
+  WriteVarint(entry->id());
+  WriteVarint(entry->self_size());
+  WriteVarint(entry->children_count());
+  WriteVarint(entry->trace_node_id());
+}
+
+
+void HeapSnapshotStreamWriter::Finalize(HeapSnapshot* snapshot) {
+  List<HeapEntry>& entries = snapshot->entries();
+  for (int i = 0; i < entries.length(); ++i) {
+    WriteNode(&entries[i]);
+    if (writer_->aborted()) return;
+  }
+  WriteVarint(kEnd);
+  writer_->Finalize();
+}
+
+
 }  // namespace internal
 }  // namespace v8
@@ -19,6 +19,7 @@ namespace internal {
 class AllocationTracker;
 class AllocationTraceNode;
 class HeapEntry;
+class HeapSnapshotStreamWriter;
 class HeapIterator;
 class HeapProfiler;
 class HeapSnapshot;
@@ -180,6 +181,14 @@ class HeapSnapshot {
   List<HeapEntry*>* GetSortedEntriesList();
   void FillChildren();
 
+  // In streaming mode edges are handed to the writer as soon as they are
+  // created and are not retained by the snapshot. Such a snapshot has no
+  // children and cannot be serialized or queried after generation.
+  void set_stream_writer(HeapSnapshotStreamWriter* writer) {
+    stream_writer_ = writer;
+  }
+  HeapSnapshotStreamWriter* stream_writer() { return stream_writer_; }
+
   void Print(int max_depth);
 
  private:
@@ -196,6 +205,7 @@ class HeapSnapshot {
   std::deque<HeapGraphEdge*> children_;
   List<HeapEntry*> sorted_entries_;
   SnapshotObjectId max_snapshot_js_object_id_;
+  HeapSnapshotStreamWriter* stream_writer_;
 
   friend class HeapSnapshotTester;
 
@@ -624,6 +634,63 @@ class HeapSnapshotJSONSerializer {
   DISALLOW_COPY_AND_ASSIGN(HeapSnapshotJSONSerializer);
 };
 
+// Writes a heap snapshot in a compact binary format while it is being
+// generated, see HeapSnapshot::set_stream_writer. Edges are written as soon
+// as they are discovered, nodes follow once the heap has been traversed.
+// Every string is written once, right before its first use.
+//
+// All numbers are unsigned LEB128. The stream starts with the bytes "V8HS"
+// and kFormatVersion, followed by records that start with a RecordTag:
+//   kString: id, length, bytes
+//   kEdge:   type, from_node, name_or_index, to_node
+//   kNode:   type, name, id, self_size, edge_count, trace_node_id
+//   kEnd:    terminates the stream
+// Nodes are referenced by their index in node record order, names by their
+// string id.
+class HeapSnapshotStreamWriter {
+ public:
+  enum RecordTag { kEnd = 0, kString = 1, kEdge = 2, kNode = 3 };
+  static const int kFormatVersion = 1;
+
+  explicit HeapSnapshotStreamWriter(v8::OutputStream* stream);
+  ~HeapSnapshotStreamWriter();
+
+  void WriteNamedEdge(HeapGraphEdge::Type type, const char* name, int from,
+                      int to);
+  void WriteIndexedEdge(HeapGraphEdge::Type type, int index, int from,
+                        int to);
+  // Writes the node records and the end record and flushes the stream.
+  void Finalize(HeapSnapshot* snapshot);
+  bool aborted();
+
+ private:
+  INLINE(static bool StringsMatch(void* key1, void* key2)) {
+    return strcmp(reinterpret_cast<char*>(key1),
+                  reinterpret_cast<char*>(key2)) == 0;
+  }
+
+  INLINE(static uint32_t StringHash(const void* string)) {
+    const char* s = reinterpret_cast<const char*>(string);
+    int len = static_cast<int>(strlen(s));
+    return StringHasher::HashSequentialString(
+        s, len, v8::internal::kZeroHashSeed);
+  }
+
+  // Returns the id of the given string, writing a string record first if
+  // the string has not been seen yet.
+  unsigned GetStringId(const char* s);
+  void WriteEdge(HeapGraphEdge::Type type, unsigned name_or_index, int from,
+                 int to);
+  void WriteNode(HeapEntry* entry);
+  void WriteVarint(uint64_t value);
+
+  OutputStreamWriter* writer_;
+  base::CustomMatcherHashMap strings_;
+  unsigned next_string_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotStreamWriter);
+};
+
 
 }  // namespace internal
 }  // namespace v8
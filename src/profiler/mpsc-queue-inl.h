@@ -0,0 +1,75 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_MPSC_QUEUE_INL_H_
+#define V8_PROFILER_MPSC_QUEUE_INL_H_
+
+#include "src/profiler/mpsc-queue.h"
+
+namespace v8 {
+namespace internal {
+
+template <typename Record>
+struct MpscQueue<Record>::Node : Malloced {
+  Node() : next(nullptr) {}
+  Record value;
+  base::AtomicValue<Node*> next;
+};
+
+template <typename Record>
+inline MpscQueue<Record>::MpscQueue() {
+  head_ = new Node();
+  tail_.SetValue(head_);
+}
+
+template <typename Record>
+inline MpscQueue<Record>::~MpscQueue() {
+  // Destroy all remaining nodes. Note that we do not destroy the actual values.
+  Node* cur_node = head_;
+  while (cur_node != nullptr) {
+    Node* old_node = cur_node;
+    cur_node = cur_node->next.Value();
+    delete old_node;
+  }
+}
+
+template <typename Record>
+inline void MpscQueue<Record>::Enqueue(const Record& record) {
+  Node* n = new Node();
+  n->value = record;
+  Node* prev;
+  do {
+    prev = tail_.Value();
+  } while (!tail_.TrySetValue(prev, n));
+  // Publishes the node to the consumer.
+  prev->next.SetValue(n);
+}
+
+template <typename Record>
+inline bool MpscQueue<Record>::Dequeue(Record* record) {
+  Node* next = head_->next.Value();
+  if (next == nullptr) return false;
+  *record = next->value;
+  delete head_;
+  head_ = next;
+  return true;
+}
+
+template <typename Record>
+inline bool MpscQueue<Record>::IsEmpty() const {
+  return head_->next.Value() == nullptr;
+}
+
+template <typename Record>
+inline bool MpscQueue<Record>::Peek(Record* record) const {
+  Node* next = head_->next.Value();
+  if (next == nullptr) return false;
+  *record = next->value;
+  return true;
+}
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_MPSC_QUEUE_INL_H_
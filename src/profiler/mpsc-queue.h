@@ -0,0 +1,45 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_MPSC_QUEUE_H_
+#define V8_PROFILER_MPSC_QUEUE_H_
+
+#include "src/allocation.h"
+#include "src/base/atomic-utils.h"
+
+namespace v8 {
+namespace internal {
+
+// Lock-free unbounded size queue for multiple producers and a single
+// consumer, based on the MPSC node-based queue by D. Vyukov. See:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+//
+// Producers never wait for each other or for the consumer. A record may
+// become visible to the consumer slightly after Enqueue returned if a
+// concurrent Enqueue has not linked its node yet. Dequeue, Peek and IsEmpty
+// must only be called from the consumer thread.
+template <typename Record>
+class MpscQueue final BASE_EMBEDDED {
+ public:
+  inline MpscQueue();
+  inline ~MpscQueue();
+  inline void Enqueue(const Record& record);
+  inline bool Dequeue(Record* record);
+  inline bool IsEmpty() const;
+  inline bool Peek(Record* record) const;
+
+ private:
+  struct Node;
+
+  // The consumer owns the head node, whose value was already dequeued.
+  Node* head_;
+  V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) base::AtomicValue<Node*> tail_;
+
+  DISALLOW_COPY_AND_ASSIGN(MpscQueue);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_MPSC_QUEUE_H_
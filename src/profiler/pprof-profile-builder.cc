@@ -0,0 +1,193 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/profiler/pprof-profile-builder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Field numbers from profile.proto.
+enum ProfileField {
+  kProfileSampleType = 1,
+  kProfileSample = 2,
+  kProfileLocation = 4,
+  kProfileFunction = 5,
+  kProfileStringTable = 6,
+  kProfileTimeNanos = 9,
+  kProfileDurationNanos = 10,
+  kProfilePeriodType = 11,
+  kProfilePeriod = 12
+};
+
+enum ValueTypeField { kValueTypeType = 1, kValueTypeUnit = 2 };
+
+enum SampleField {
+  kSampleLocationId = 1,
+  kSampleValue = 2,
+  kSampleLabel = 3
+};
+
+enum LabelField { kLabelKey = 1, kLabelNum = 3, kLabelNumUnit = 4 };
+
+enum LocationField { kLocationId = 1, kLocationLine = 4 };
+
+enum LineField { kLineFunctionId = 1, kLineLine = 2 };
+
+enum FunctionField {
+  kFunctionId = 1,
+  kFunctionName = 2,
+  kFunctionSystemName = 3,
+  kFunctionFileName = 4,
+  kFunctionStartLine = 5
+};
+
+const int kWireTypeVarint = 0;
+const int kWireTypeLengthDelimited = 2;
+
+}  // namespace
+
+PprofProfileBuilder::PprofProfileBuilder()
+    : next_function_id_(1), next_location_id_(1) {
+  // The first entry of the string table must be the empty string.
+  InternString("");
+}
+
+void PprofProfileBuilder::WriteVarint(Buffer* buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer->push_back(static_cast<uint8_t>(value));
+}
+
+void PprofProfileBuilder::WriteVarintField(Buffer* buffer, int field,
+                                           uint64_t value) {
+  WriteVarint(buffer, (field << 3) | kWireTypeVarint);
+  WriteVarint(buffer, value);
+}
+
+void PprofProfileBuilder::WriteBytesField(Buffer* buffer, int field,
+                                          const void* data, size_t length) {
+  WriteVarint(buffer, (field << 3) | kWireTypeLengthDelimited);
+  WriteVarint(buffer, length);
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  buffer->insert(buffer->end(), bytes, bytes + length);
+}
+
+template <typename T>
+void PprofProfileBuilder::WritePackedField(Buffer* buffer, int field,
+                                           const std::vector<T>& values) {
+  if (values.empty()) return;
+  Buffer packed;
+  for (T value : values) WriteVarint(&packed, static_cast<uint64_t>(value));
+  WriteBytesField(buffer, field, packed.data(), packed.size());
+}
+
+int64_t PprofProfileBuilder::InternString(const char* s) {
+  auto it = strings_.find(s);
+  if (it != strings_.end()) return it->second;
+  int64_t index = static_cast<int64_t>(strings_.size());
+  strings_.insert(std::make_pair(std::string(s), index));
+  WriteBytesField(&profile_, kProfileStringTable, s, strlen(s));
+  return index;
+}
+
+void PprofProfileBuilder::AddSampleType(const char* type, const char* unit) {
+  Buffer value_type;
+  WriteVarintField(&value_type, kValueTypeType, InternString(type));
+  WriteVarintField(&value_type, kValueTypeUnit, InternString(unit));
+  WriteBytesField(&profile_, kProfileSampleType, value_type.data(),
+                  value_type.size());
+}
+
+void PprofProfileBuilder::SetPeriod(const char* type, const char* unit,
+                                    int64_t period) {
+  Buffer value_type;
+  WriteVarintField(&value_type, kValueTypeType, InternString(type));
+  WriteVarintField(&value_type, kValueTypeUnit, InternString(unit));
+  WriteBytesField(&profile_, kProfilePeriodType, value_type.data(),
+                  value_type.size());
+  WriteVarintField(&profile_, kProfilePeriod, period);
+}
+
+void PprofProfileBuilder::SetTime(int64_t time_nanos,
+                                  int64_t duration_nanos) {
+  WriteVarintField(&profile_, kProfileTimeNanos, time_nanos);
+  WriteVarintField(&profile_, kProfileDurationNanos, duration_nanos);
+}
+
+uint64_t PprofProfileBuilder::AddFunction(const char* name,
+                                          const char* file_name,
+                                          int64_t start_line) {
+  uint64_t id = next_function_id_++;
+  int64_t name_index = InternString(name);
+  Buffer function;
+  WriteVarintField(&function, kFunctionId, id);
+  WriteVarintField(&function, kFunctionName, name_index);
+  WriteVarintField(&function, kFunctionSystemName, name_index);
+  WriteVarintField(&function, kFunctionFileName, InternString(file_name));
+  WriteVarintField(&function, kFunctionStartLine, start_line);
+  WriteBytesField(&profile_, kProfileFunction, function.data(),
+                  function.size());
+  return id;
+}
+
+uint64_t PprofProfileBuilder::AddLocation(const std::vector<Line>& lines) {
+  uint64_t id = next_location_id_++;
+  Buffer location;
+  WriteVarintField(&location, kLocationId, id);
+  for (const Line& line : lines) {
+    Buffer encoded_line;
+    WriteVarintField(&encoded_line, kLineFunctionId, line.function_id);
+    WriteVarintField(&encoded_line, kLineLine, line.line);
+    WriteBytesField(&location, kLocationLine, encoded_line.data(),
+                    encoded_line.size());
+  }
+  WriteBytesField(&profile_, kProfileLocation, location.data(),
+                  location.size());
+  return id;
+}
+
+void PprofProfileBuilder::AddSample(const std::vector<uint64_t>& location_ids,
+                                    const std::vector<int64_t>& values,
+                                    const std::vector<Label>& labels) {
+  Buffer sample;
+  WritePackedField(&sample, kSampleLocationId, location_ids);
+  WritePackedField(&sample, kSampleValue, values);
+  for (const Label& label : labels) {
+    Buffer encoded_label;
+    WriteVarintField(&encoded_label, kLabelKey, InternString(label.key));
+    WriteVarintField(&encoded_label, kLabelNum, label.num);
+    WriteVarintField(&encoded_label, kLabelNumUnit,
+                     InternString(label.num_unit));
+    WriteBytesField(&sample, kSampleLabel, encoded_label.data(),
+                    encoded_label.size());
+  }
+  WriteBytesField(&profile_, kProfileSample, sample.data(), sample.size());
+}
+
+bool PprofProfileBuilder::WriteTo(v8::OutputStream* stream) {
+  size_t chunk_size = static_cast<size_t>(stream->GetChunkSize());
+  DCHECK_LT(0u, chunk_size);
+  for (size_t pos = 0; pos < profile_.size(); pos += chunk_size) {
+    size_t length = std::min(chunk_size, profile_.size() - pos);
+    char* chunk = reinterpret_cast<char*>(profile_.data() + pos);
+    if (stream->WriteAsciiChunk(chunk, static_cast<int>(length)) ==
+        v8::OutputStream::kAbort) {
+      return false;
+    }
+  }
+  stream->EndOfStream();
+  return true;
+}
+
+}  // namespace internal
+}  // namespace v8
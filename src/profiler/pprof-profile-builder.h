@@ -0,0 +1,82 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_PPROF_PROFILE_BUILDER_H_
+#define V8_PROFILER_PPROF_PROFILE_BUILDER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/v8-profiler.h"
+#include "src/base/macros.h"
+
+namespace v8 {
+namespace internal {
+
+// Builds a profile in the pprof protocol buffer format, see
+// https://github.com/google/pprof/blob/master/proto/profile.proto.
+// The message is encoded incrementally as functions, locations and samples
+// are added, so no protobuf runtime is needed. Ids of functions and
+// locations are assigned by the builder and start at 1.
+class PprofProfileBuilder {
+ public:
+  struct Line {
+    uint64_t function_id;
+    int64_t line;
+  };
+
+  // A numeric sample label, e.g. the allocation size of a heap sample.
+  struct Label {
+    const char* key;
+    int64_t num;
+    const char* num_unit;
+  };
+
+  PprofProfileBuilder();
+
+  // Returns the index of |s| in the string table, adding it if needed.
+  int64_t InternString(const char* s);
+
+  // Sample types must be added in the order of the values of each sample.
+  void AddSampleType(const char* type, const char* unit);
+  void SetPeriod(const char* type, const char* unit, int64_t period);
+  void SetTime(int64_t time_nanos, int64_t duration_nanos);
+
+  uint64_t AddFunction(const char* name, const char* file_name,
+                       int64_t start_line);
+  // |lines| lists the innermost inlined function first.
+  uint64_t AddLocation(const std::vector<Line>& lines);
+  // |location_ids| lists the leaf frame first.
+  void AddSample(const std::vector<uint64_t>& location_ids,
+                 const std::vector<int64_t>& values,
+                 const std::vector<Label>& labels = std::vector<Label>());
+
+  // Writes the encoded profile and ends the stream. Returns false if the
+  // stream aborted.
+  bool WriteTo(v8::OutputStream* stream);
+
+ private:
+  typedef std::vector<uint8_t> Buffer;
+
+  static void WriteVarint(Buffer* buffer, uint64_t value);
+  static void WriteVarintField(Buffer* buffer, int field, uint64_t value);
+  static void WriteBytesField(Buffer* buffer, int field, const void* data,
+                              size_t length);
+  template <typename T>
+  static void WritePackedField(Buffer* buffer, int field,
+                               const std::vector<T>& values);
+
+  Buffer profile_;
+  std::unordered_map<std::string, int64_t> strings_;
+  uint64_t next_function_id_;
+  uint64_t next_location_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(PprofProfileBuilder);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_PPROF_PROFILE_BUILDER_H_
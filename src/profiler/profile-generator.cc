@@ -10,6 +10,7 @@
 #include "src/global-handles.h"
 #include "src/objects-inl.h"
 #include "src/profiler/cpu-profiler.h"
+#include "src/profiler/pprof-profile-builder.h"
 #include "src/profiler/profile-generator-inl.h"
 #include "src/tracing/trace-event.h"
 #include "src/tracing/traced-value.h"
@@ -92,6 +93,11 @@ CodeEntry::~CodeEntry() {
       delete entry;
     }
   }
+  for (auto& inline_stack : inlined_position_stacks_) {
+    for (auto entry : inline_stack) {
+      delete entry;
+    }
+  }
 }
 
 
@@ -152,6 +158,26 @@ const std::vector<CodeEntry*>* CodeEntry::GetInlineStack(int pc_offset) const {
   return it != inline_locations_.end() ? &it->second : NULL;
 }
 
+int CodeEntry::AddInlinedPositionStack(std::vector<CodeEntry*> inline_stack) {
+  inlined_position_stacks_.push_back(std::move(inline_stack));
+  return static_cast<int>(inlined_position_stacks_.size()) - 1;
+}
+
+void CodeEntry::AddInlinedPosition(int pc_offset, int stack_index) {
+  DCHECK(stack_index == kNotInlined ||
+         static_cast<size_t>(stack_index) < inlined_position_stacks_.size());
+  inlined_positions_[pc_offset] = stack_index;
+}
+
+const std::vector<CodeEntry*>* CodeEntry::GetInlinedPositionStack(
+    int pc_offset) const {
+  auto it = inlined_positions_.upper_bound(pc_offset);
+  if (it == inlined_positions_.begin()) return NULL;
+  int stack_index = (--it)->second;
+  if (stack_index == kNotInlined) return NULL;
+  return &inlined_position_stacks_[stack_index];
+}
+
 void CodeEntry::AddDeoptInlinedFrames(
     int deopt_id, std::vector<CpuProfileDeoptFrame> inlined_frames) {
   deopt_inlined_frames_.insert(
@@ -502,6 +528,107 @@ void CpuProfile::FinishProfile() {
                               "ProfileChunk", this, "data", std::move(value));
 }
 
+namespace {
+
+class PprofNodeWriter {
+ public:
+  PprofNodeWriter(PprofProfileBuilder* builder, int64_t tick_nanos)
+      : builder_(builder), tick_nanos_(tick_nanos) {}
+
+  void WriteNode(const ProfileNode* node) {
+    if (node->self_ticks()) WriteSamples(node);
+    const List<ProfileNode*>* children = node->children();
+    if (children->is_empty()) return;
+    stack_.push_back(GetLocation(node, 0));
+    for (int i = 0; i < children->length(); i++) {
+      WriteNode(children->at(i));
+    }
+    stack_.pop_back();
+  }
+
+ private:
+  // Emits one sample per source line that was hit in |node|, so that pprof
+  // can attribute ticks to lines. Ticks without line information end up in
+  // a sample with line 0.
+  void WriteSamples(const ProfileNode* node) {
+    unsigned line_count = node->GetHitLineCount();
+    std::vector<v8::CpuProfileNode::LineTick> line_ticks(line_count);
+    if (line_count == 0 || !node->GetLineTicks(line_ticks.data(), line_count)) {
+      line_ticks.clear();
+    }
+    int64_t unattributed_ticks = node->self_ticks();
+    for (const auto& line_tick : line_ticks) {
+      WriteSample(node, line_tick.line, line_tick.hit_count);
+      unattributed_ticks -= line_tick.hit_count;
+    }
+    if (unattributed_ticks > 0) WriteSample(node, 0, unattributed_ticks);
+  }
+
+  void WriteSample(const ProfileNode* node, int64_t line, int64_t ticks) {
+    std::vector<uint64_t> location_ids;
+    location_ids.reserve(stack_.size() + 1);
+    location_ids.push_back(GetLocation(node, line));
+    location_ids.insert(location_ids.end(), stack_.rbegin(), stack_.rend());
+    std::vector<int64_t> values = {ticks, ticks * tick_nanos_};
+    builder_->AddSample(location_ids, values);
+  }
+
+  uint64_t GetLocation(const ProfileNode* node, int64_t line) {
+    uint64_t function_id = GetFunction(node);
+    auto key = std::make_pair(function_id, line);
+    auto it = locations_.find(key);
+    if (it != locations_.end()) return it->second;
+    std::vector<PprofProfileBuilder::Line> lines = {{function_id, line}};
+    uint64_t location_id = builder_->AddLocation(lines);
+    locations_.insert(std::make_pair(key, location_id));
+    return location_id;
+  }
+
+  // Nodes of the same function share a pprof function, even if they belong
+  // to different code objects, e.g. inlined and non-inlined code.
+  uint64_t GetFunction(const ProfileNode* node) {
+    unsigned node_function_id = node->function_id();
+    auto it = functions_.find(node_function_id);
+    if (it != functions_.end()) return it->second;
+    CodeEntry* entry = node->entry();
+    std::string name = std::string(entry->name_prefix()) + entry->name();
+    int line_number = entry->line_number();
+    uint64_t function_id = builder_->AddFunction(
+        name.c_str(), entry->resource_name(),
+        line_number == v8::CpuProfileNode::kNoLineNumberInfo ? 0
+                                                             : line_number);
+    functions_.insert(std::make_pair(node_function_id, function_id));
+    return function_id;
+  }
+
+  PprofProfileBuilder* builder_;
+  const int64_t tick_nanos_;
+  // Locations of the callers of the current node, outermost first.
+  std::vector<uint64_t> stack_;
+  std::map<unsigned, uint64_t> functions_;
+  std::map<std::pair<uint64_t, int64_t>, uint64_t> locations_;
+};
+
+}  // namespace
+
+bool CpuProfile::WritePprof(v8::OutputStream* stream) const {
+  int64_t duration_nanos = (end_time_ - start_time_).InMicroseconds() * 1000;
+  int64_t tick_nanos = profiler_->sampling_interval().InMicroseconds() * 1000;
+  PprofProfileBuilder builder;
+  builder.AddSampleType("samples", "count");
+  builder.AddSampleType("cpu", "nanoseconds");
+  builder.SetPeriod("cpu", "nanoseconds", tick_nanos);
+  builder.SetTime((start_time_ - base::TimeTicks()).InMicroseconds() * 1000,
+                  duration_nanos);
+  PprofNodeWriter writer(&builder, tick_nanos);
+  // The root node is not a frame of its own.
+  const List<ProfileNode*>* children = top_down_.root()->children();
+  for (int i = 0; i < children->length(); i++) {
+    writer.WriteNode(children->at(i));
+  }
+  return builder.WriteTo(stream);
+}
+
 void CpuProfile::Print() {
   base::OS::Print("[Top down]:\n");
   top_down_.Print();
@@ -679,6 +806,13 @@ void ProfileGenerator::RecordTickSample(const TickSample& sample) {
           src_line = pc_entry->line_number();
         }
         src_line_not_found = false;
+        // Code inlined into optimized code shows up as frames of its own.
+        const std::vector<CodeEntry*>* inline_stack =
+            pc_entry->GetInlinedPositionStack(pc_offset);
+        if (inline_stack) {
+          entries.insert(entries.end(), inline_stack->rbegin(),
+                         inline_stack->rend());
+        }
         entries.push_back(pc_entry);
 
         if (pc_entry->builtin_id() == Builtins::kFunctionPrototypeApply ||
@@ -705,6 +839,11 @@ void ProfileGenerator::RecordTickSample(const TickSample& sample) {
             static_cast<int>(stack_pos - entry->instruction_start());
         const std::vector<CodeEntry*>* inline_stack =
             entry->GetInlineStack(pc_offset);
+        if (!inline_stack) {
+          // Not a deoptimization point, so resolve the call instruction
+          // preceding the return address from the source positions.
+          inline_stack = entry->GetInlinedPositionStack(pc_offset - 1);
+        }
         if (inline_stack) {
           entries.insert(entries.end(), inline_stack->rbegin(),
                          inline_stack->rend());
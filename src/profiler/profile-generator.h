@@ -92,6 +92,16 @@ class CodeEntry {
   void AddInlineStack(int pc_offset, std::vector<CodeEntry*> inline_stack);
   const std::vector<CodeEntry*>* GetInlineStack(int pc_offset) const;
 
+  // Inline stacks derived from the source position table. They cover the
+  // range of code from |pc_offset| up to the next added position, so that
+  // any pc of optimized code can be resolved, not only call sites. Stacks
+  // list the outermost inlined function first, like the ones added with
+  // AddInlineStack. Returns the index to pass to AddInlinedPosition.
+  int AddInlinedPositionStack(std::vector<CodeEntry*> inline_stack);
+  // Pass kNotInlined as |stack_index| for code of the function itself.
+  void AddInlinedPosition(int pc_offset, int stack_index);
+  const std::vector<CodeEntry*>* GetInlinedPositionStack(int pc_offset) const;
+
   void AddDeoptInlinedFrames(int deopt_id, std::vector<CpuProfileDeoptFrame>);
   bool HasDeoptInlinedFramesFor(int deopt_id) const;
 
@@ -104,6 +114,7 @@ class CodeEntry {
   static const char* const kEmptyResourceName;
   static const char* const kEmptyBailoutReason;
   static const char* const kNoDeoptReason;
+  static const int kNotInlined = -1;
 
   static const char* const kProgramEntryName;
   static const char* const kIdleEntryName;
@@ -162,6 +173,10 @@ class CodeEntry {
   Address instruction_start_;
   // Should be an unordered_map, but it doesn't currently work on Win & MacOS.
   std::map<int, std::vector<CodeEntry*>> inline_locations_;
+  std::vector<std::vector<CodeEntry*>> inlined_position_stacks_;
+  // Mapping from the start of a code range to an inlined_position_stacks_
+  // index or kNotInlined.
+  std::map<int, int> inlined_positions_;
   std::map<int, std::vector<CpuProfileDeoptFrame>> deopt_inlined_frames_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeEntry);
@@ -290,6 +305,9 @@ class CpuProfile {
 
   void UpdateTicksScale();
 
+  // Writes the profile in the pprof format, see PprofProfileBuilder.
+  bool WritePprof(v8::OutputStream* stream) const;
+
   void Print();
 
  private:
@@ -4,6 +4,9 @@
 
 #include "src/profiler/profiler-listener.h"
 
+#include <algorithm>
+#include <map>
+
 #include "src/deoptimizer.h"
 #include "src/objects-inl.h"
 #include "src/profiler/cpu-profiler.h"
@@ -93,8 +96,8 @@ void ProfilerListener::CodeCreateEvent(CodeEventListener::LogEventsAndTags tag,
                                          : BytecodeArray::kHeaderSize;
     for (SourcePositionTableIterator it(abstract_code->source_position_table());
          !it.done(); it.Advance()) {
-      // TODO(alph,tebbi) Skipping inlined positions for now, because they might
-      // refer to a different script.
+      // Inlined positions might refer to a different script. They are
+      // recorded by RecordInlinedSourcePositions.
       if (it.source_position().InliningId() != SourcePosition::kNotInlined)
         continue;
       int position = it.source_position().ScriptOffset();
@@ -108,6 +111,7 @@ void ProfilerListener::CodeCreateEvent(CodeEventListener::LogEventsAndTags tag,
       GetName(InferScriptName(script_name, shared)), line, column, line_table,
       abstract_code->instruction_start());
   RecordInliningInfo(rec->entry, abstract_code);
+  RecordInlinedSourcePositions(rec->entry, abstract_code, line_table);
   RecordDeoptInlinedFrames(rec->entry, abstract_code);
   rec->entry->FillFunctionInfo(shared);
   rec->size = abstract_code->ExecutableSize();
@@ -245,6 +249,79 @@ void ProfilerListener::RecordInliningInfo(CodeEntry* entry,
   }
 }
 
+void ProfilerListener::RecordInlinedSourcePositions(
+    CodeEntry* entry, AbstractCode* abstract_code,
+    JITLineInfoTable* line_table) {
+  if (abstract_code->kind() != AbstractCode::OPTIMIZED_FUNCTION) return;
+  Code* code = abstract_code->GetCode();
+  if (code->deoptimization_data()->length() == 0) return;
+  DeoptimizationInputData* deopt_input_data =
+      DeoptimizationInputData::cast(code->deoptimization_data());
+  // Positions with the same inlining id share their inline stack.
+  std::map<int, int> stack_indices;
+  for (SourcePositionTableIterator it(code->source_position_table());
+       !it.done(); it.Advance()) {
+    SourcePosition position = it.source_position();
+    // Offsets are relative to the code object, as in the line table.
+    int pc_offset = it.code_offset() + Code::kHeaderSize;
+    if (!position.isInlined()) {
+      entry->AddInlinedPosition(pc_offset, CodeEntry::kNotInlined);
+      continue;
+    }
+    InliningPosition inlining =
+        deopt_input_data->InliningPositions()->get(position.InliningId());
+    SharedFunctionInfo* shared =
+        deopt_input_data->GetInlinedFunction(inlining.inlined_function_id);
+    // Ticks at this position belong to the innermost inlined function, so
+    // the line refers to its script.
+    if (line_table && shared->script()->IsScript()) {
+      Script* script = Script::cast(shared->script());
+      int line_number = script->GetLineNumber(position.ScriptOffset()) + 1;
+      if (line_number > 0) line_table->SetPosition(pc_offset, line_number);
+    }
+    auto found = stack_indices.find(position.InliningId());
+    if (found != stack_indices.end()) {
+      entry->AddInlinedPosition(pc_offset, found->second);
+      continue;
+    }
+    std::vector<CodeEntry*> inline_stack;
+    for (int inlining_id = position.InliningId();
+         inlining_id != SourcePosition::kNotInlined;
+         inlining_id = inlining.position.InliningId()) {
+      inlining = deopt_input_data->InliningPositions()->get(inlining_id);
+      inline_stack.push_back(NewInlinedCodeEntry(
+          entry,
+          deopt_input_data->GetInlinedFunction(inlining.inlined_function_id)));
+    }
+    // The stack was collected from the innermost function outwards.
+    std::reverse(inline_stack.begin(), inline_stack.end());
+    int stack_index = entry->AddInlinedPositionStack(std::move(inline_stack));
+    stack_indices.insert(std::make_pair(position.InliningId(), stack_index));
+    entry->AddInlinedPosition(pc_offset, stack_index);
+  }
+}
+
+CodeEntry* ProfilerListener::NewInlinedCodeEntry(CodeEntry* entry,
+                                                 SharedFunctionInfo* shared) {
+  const char* resource_name = entry->resource_name();
+  int line_number = CpuProfileNode::kNoLineNumberInfo;
+  if (shared->script()->IsScript()) {
+    Script* script = Script::cast(shared->script());
+    Name* script_name = script->name()->IsName() ? Name::cast(script->name())
+                                                 : nullptr;
+    if (script_name) {
+      resource_name = GetName(InferScriptName(script_name, shared));
+    }
+    line_number = script->GetLineNumber(shared->start_position()) + 1;
+  }
+  CodeEntry* inline_entry = new CodeEntry(
+      entry->tag(), GetFunctionName(shared->DebugName()),
+      CodeEntry::kEmptyNamePrefix, resource_name, line_number,
+      CpuProfileNode::kNoColumnNumberInfo, NULL, entry->instruction_start());
+  inline_entry->FillFunctionInfo(shared);
+  return inline_entry;
+}
+
 void ProfilerListener::RecordDeoptInlinedFrames(CodeEntry* entry,
                                                 AbstractCode* abstract_code) {
   if (abstract_code->kind() != AbstractCode::OPTIMIZED_FUNCTION) return;
@@ -76,6 +76,10 @@ class ProfilerListener : public CodeEventListener {
 
  private:
   void RecordInliningInfo(CodeEntry* entry, AbstractCode* abstract_code);
+  void RecordInlinedSourcePositions(CodeEntry* entry,
+                                    AbstractCode* abstract_code,
+                                    JITLineInfoTable* line_table);
+  CodeEntry* NewInlinedCodeEntry(CodeEntry* entry, SharedFunctionInfo* shared);
   void RecordDeoptInlinedFrames(CodeEntry* entry, AbstractCode* abstract_code);
   Name* InferScriptName(Name* name, SharedFunctionInfo* info);
   V8_INLINE void DispatchCodeEvent(const CodeEventsContainer& evt_rec) {
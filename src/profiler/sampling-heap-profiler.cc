@@ -12,6 +12,7 @@
 #include "src/frames-inl.h"
 #include "src/heap/heap.h"
 #include "src/isolate.h"
+#include "src/profiler/pprof-profile-builder.h"
 #include "src/profiler/strings-storage.h"
 
 namespace v8 {
@@ -64,7 +65,9 @@ SamplingHeapProfiler::SamplingHeapProfiler(
       samples_(),
       stack_depth_(stack_depth),
       rate_(rate),
-      flags_(flags) {
+      flags_(flags),
+      node_count_(0),
+      delta_start_ms_(base::OS::TimeCurrentMillis()) {
   CHECK_GT(rate_, 0u);
   heap->new_space()->AddAllocationObserver(new_space_observer_.get());
   AllSpaces spaces(heap);
@@ -109,6 +112,9 @@ void SamplingHeapProfiler::SampleObject(Address soon_object, size_t size) {
 
   AllocationNode* node = AddStack();
   node->allocations_[size]++;
+  // Delta profiles only report allocations, so there is no need to track
+  // when the sampled object dies.
+  if (delta_mode()) return;
   Sample* sample = new Sample(size, node, loc, this);
   samples_.insert(sample);
   sample->global.SetWeak(sample, OnWeakCallback, WeakCallbackType::kParameter);
@@ -138,20 +144,51 @@ void SamplingHeapProfiler::OnWeakCallback(
 }
 
 SamplingHeapProfiler::AllocationNode*
-SamplingHeapProfiler::AllocationNode::FindOrAddChildNode(const char* name,
-                                                         int script_id,
-                                                         int start_position) {
+SamplingHeapProfiler::AllocationNode::FindChildNode(const char* name,
+                                                    int script_id,
+                                                    int start_position) {
   FunctionId id = function_id(script_id, start_position, name);
   auto it = children_.find(id);
-  if (it != children_.end()) {
-    DCHECK(strcmp(it->second->name_, name) == 0);
-    return it->second;
-  }
+  if (it == children_.end()) return nullptr;
+  DCHECK(strcmp(it->second->name_, name) == 0);
+  return it->second;
+}
+
+SamplingHeapProfiler::AllocationNode*
+SamplingHeapProfiler::AllocationNode::AddChildNode(const char* name,
+                                                   int script_id,
+                                                   int start_position) {
+  FunctionId id = function_id(script_id, start_position, name);
+  DCHECK(children_.find(id) == children_.end());
   auto child = new AllocationNode(this, name, script_id, start_position);
   children_.insert(std::make_pair(id, child));
   return child;
 }
 
+SamplingHeapProfiler::AllocationNode*
+SamplingHeapProfiler::AllocationNode::FindOrAddChildNode(const char* name,
+                                                         int script_id,
+                                                         int start_position) {
+  AllocationNode* child = FindChildNode(name, script_id, start_position);
+  if (child != nullptr) return child;
+  return AddChildNode(name, script_id, start_position);
+}
+
+SamplingHeapProfiler::AllocationNode*
+SamplingHeapProfiler::FindOrAddBoundedChildNode(AllocationNode* parent,
+                                                const char* name,
+                                                int script_id,
+                                                int start_position) {
+  AllocationNode* child =
+      parent->FindChildNode(name, script_id, start_position);
+  if (child != nullptr) return child;
+  if (delta_mode()) {
+    if (node_count_ >= FLAG_sampling_heap_profiler_max_nodes) return nullptr;
+    node_count_++;
+  }
+  return parent->AddChildNode(name, script_id, start_position);
+}
+
 SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::AddStack() {
   AllocationNode* node = &profile_root_;
 
@@ -189,7 +226,12 @@ SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::AddStack() {
         name = "(JS)";
         break;
     }
-    return node->FindOrAddChildNode(name, v8::UnboundScript::kNoScriptId, 0);
+    AllocationNode* child = FindOrAddBoundedChildNode(
+        node, name, v8::UnboundScript::kNoScriptId, 0);
+    if (child != nullptr) return child;
+    isolate_->counters()->sampling_heap_profiler_truncated_samples()
+        ->Increment();
+    return node;
   }
 
   // We need to process the stack in reverse order as the top of the stack is
@@ -202,7 +244,16 @@ SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::AddStack() {
       Script* script = Script::cast(shared->script());
       script_id = script->id();
     }
-    node = node->FindOrAddChildNode(name, script_id, shared->start_position());
+    AllocationNode* child = FindOrAddBoundedChildNode(
+        node, name, script_id, shared->start_position());
+    if (child == nullptr) {
+      // The node table is full. Attribute the sample to the deepest frame
+      // that is already known.
+      isolate_->counters()->sampling_heap_profiler_truncated_samples()
+          ->Increment();
+      break;
+    }
+    node = child;
   }
   return node;
 }
@@ -265,17 +316,113 @@ v8::AllocationProfile* SamplingHeapProfiler::GetAllocationProfile() {
   // To resolve positions to line/column numbers, we will need to look up
   // scripts. Build a map to allow fast mapping from script id to script.
   std::map<int, Handle<Script>> scripts;
-  {
-    Script::Iterator iterator(isolate_);
-    while (Script* script = iterator.Next()) {
-      scripts[script->id()] = handle(script);
-    }
-  }
+  CollectScripts(&scripts);
   auto profile = new v8::internal::AllocationProfile();
   TranslateAllocationNode(profile, &profile_root_, scripts);
   return profile;
 }
 
+void SamplingHeapProfiler::CollectScripts(
+    std::map<int, Handle<Script>>* scripts) {
+  Script::Iterator iterator(isolate_);
+  while (Script* script = iterator.Next()) {
+    (*scripts)[script->id()] = handle(script);
+  }
+}
+
+uint64_t SamplingHeapProfiler::GetDeltaLocation(
+    PprofProfileBuilder* builder, AllocationNode* node,
+    const std::map<int, Handle<Script>>& scripts, LocationMap* locations) {
+  AllocationNode::FunctionId id = AllocationNode::function_id(
+      node->script_id_, node->script_position_, node->name_);
+  auto it = locations->find(id);
+  if (it != locations->end()) return it->second;
+  const char* file_name = "";
+  int line = 0;
+  auto script_it = scripts.find(node->script_id_);
+  if (node->script_id_ != v8::UnboundScript::kNoScriptId &&
+      script_it != scripts.end()) {
+    Script* script = *script_it->second;
+    if (script->name()->IsName()) {
+      file_name = names_->GetName(Name::cast(script->name()));
+    }
+    line = 1 + script->GetLineNumber(node->script_position_);
+  }
+  uint64_t function_id = builder->AddFunction(node->name_, file_name, line);
+  uint64_t location_id = builder->AddLocation({{function_id, line}});
+  locations->insert(std::make_pair(id, location_id));
+  return location_id;
+}
+
+void SamplingHeapProfiler::AddDeltaSamples(
+    PprofProfileBuilder* builder, AllocationNode* node,
+    const std::map<int, Handle<Script>>& scripts, LocationMap* locations,
+    std::vector<uint64_t>* location_stack) {
+  if (node != &profile_root_) {
+    location_stack->push_back(
+        GetDeltaLocation(builder, node, scripts, locations));
+  }
+  if (!node->allocations_.empty()) {
+    // pprof expects the leaf frame first.
+    std::vector<uint64_t> location_ids(location_stack->rbegin(),
+                                       location_stack->rend());
+    for (auto alloc : node->allocations_) {
+      v8::AllocationProfile::Allocation scaled =
+          ScaleSample(alloc.first, alloc.second);
+      int64_t size = static_cast<int64_t>(scaled.size);
+      int64_t count = static_cast<int64_t>(scaled.count);
+      builder->AddSample(location_ids, {count, count * size},
+                         {{"bytes", size, "bytes"}});
+    }
+  }
+  for (auto it : node->children_) {
+    AddDeltaSamples(builder, it.second, scripts, locations, location_stack);
+  }
+  if (node != &profile_root_) location_stack->pop_back();
+}
+
+void SamplingHeapProfiler::ResetDelta(double now_ms) {
+  for (auto child : profile_root_.children_) {
+    delete child.second;
+  }
+  profile_root_.children_.clear();
+  profile_root_.allocations_.clear();
+  node_count_ = 0;
+  delta_start_ms_ = now_ms;
+}
+
+bool SamplingHeapProfiler::WriteAllocationProfileDelta(
+    v8::OutputStream* stream) {
+  DCHECK(delta_mode());
+  HandleScope scope(isolate_);
+  std::map<int, Handle<Script>> scripts;
+  CollectScripts(&scripts);
+  // Computing line ends allocates on the JS heap, which may take samples.
+  // Do it upfront so that the node tree does not change while it is
+  // translated below.
+  for (auto& entry : scripts) {
+    Script::InitLineEnds(entry.second);
+  }
+  double now_ms = base::OS::TimeCurrentMillis();
+  const int64_t kNanosPerMilli = 1000000;
+  PprofProfileBuilder builder;
+  builder.AddSampleType("alloc_objects", "count");
+  builder.AddSampleType("alloc_space", "bytes");
+  builder.SetPeriod("space", "bytes", static_cast<int64_t>(rate_));
+  builder.SetTime(static_cast<int64_t>(delta_start_ms_ * kNanosPerMilli),
+                  static_cast<int64_t>((now_ms - delta_start_ms_) *
+                                       kNanosPerMilli));
+  {
+    DisallowHeapAllocation no_allocation;
+    LocationMap locations;
+    std::vector<uint64_t> location_stack;
+    AddDeltaSamples(&builder, &profile_root_, scripts, &locations,
+                    &location_stack);
+    ResetDelta(now_ms);
+  }
+  return builder.WriteTo(stream);
+}
+
 
 }  // namespace internal
 }  // namespace v8
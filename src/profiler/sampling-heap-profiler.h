@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 #include "include/v8-profiler.h"
 #include "src/heap/heap.h"
 #include "src/profiler/strings-storage.h"
@@ -21,6 +22,7 @@ class RandomNumberGenerator;
 
 namespace internal {
 
+class PprofProfileBuilder;
 class SamplingAllocationObserver;
 
 class AllocationProfile : public v8::AllocationProfile {
@@ -47,6 +49,16 @@ class SamplingHeapProfiler {
 
   v8::AllocationProfile* GetAllocationProfile();
 
+  // Writes the allocations sampled since the previous call (or since the
+  // profiler was started) to |stream| as a pprof profile and starts a new
+  // delta. Only available with kSamplingDeltaProfiles. Returns false if the
+  // stream aborted.
+  bool WriteAllocationProfileDelta(v8::OutputStream* stream);
+
+  bool delta_mode() const {
+    return flags_ & v8::HeapProfiler::kSamplingDeltaProfiles;
+  }
+
   StringsStorage* names() const { return names_; }
 
   class AllocationNode;
@@ -102,6 +114,10 @@ class SamplingHeapProfiler {
       DCHECK(static_cast<unsigned>(start_position) < (1u << 31));
       return (static_cast<uint64_t>(script_id) << 32) + (start_position << 1);
     }
+    AllocationNode* FindChildNode(const char* name, int script_id,
+                                  int start_position);
+    AllocationNode* AddChildNode(const char* name, int script_id,
+                                 int start_position);
     AllocationNode* FindOrAddChildNode(const char* name, int script_id,
                                        int start_position);
     // TODO(alph): make use of unordered_map's here. Pay attention to
@@ -139,6 +155,25 @@ class SamplingHeapProfiler {
   v8::AllocationProfile::Allocation ScaleSample(size_t size,
                                                 unsigned int count);
   AllocationNode* AddStack();
+  // Like AllocationNode::FindOrAddChildNode, but returns nullptr instead of
+  // growing the tree beyond --sampling-heap-profiler-max-nodes in delta mode.
+  AllocationNode* FindOrAddBoundedChildNode(AllocationNode* parent,
+                                            const char* name, int script_id,
+                                            int start_position);
+  void CollectScripts(std::map<int, Handle<Script>>* scripts);
+
+  // Methods that construct delta profiles. Locations are keyed by the
+  // function id of the allocation nodes.
+  typedef std::map<uint64_t, uint64_t> LocationMap;
+  void AddDeltaSamples(PprofProfileBuilder* builder, AllocationNode* node,
+                       const std::map<int, Handle<Script>>& scripts,
+                       LocationMap* locations,
+                       std::vector<uint64_t>* location_stack);
+  uint64_t GetDeltaLocation(PprofProfileBuilder* builder,
+                            AllocationNode* node,
+                            const std::map<int, Handle<Script>>& scripts,
+                            LocationMap* locations);
+  void ResetDelta(double now_ms);
 
   Isolate* const isolate_;
   Heap* const heap_;
@@ -150,6 +185,10 @@ class SamplingHeapProfiler {
   const int stack_depth_;
   const uint64_t rate_;
   v8::HeapProfiler::SamplingFlags flags_;
+  // Number of nodes below the root, only maintained in delta mode.
+  int node_count_;
+  // Wall clock time at which the current delta started.
+  double delta_start_ms_;
 
   friend class SamplingAllocationObserver;
 
@@ -61,6 +61,13 @@ void V8::InitializeOncePerProcessImpl() {
     FLAG_random_seed = 12347;
   }
 
+  if (FLAG_bytecode_flush_age < 1 ||
+      FLAG_bytecode_flush_age > BytecodeArray::kLastBytecodeAge) {
+    V8_Fatal(__FILE__, __LINE__,
+             "--bytecode-flush-age must be between 1 and %d",
+             BytecodeArray::kLastBytecodeAge);
+  }
+
   if (FLAG_stress_compaction) {
     FLAG_force_marking_deque_overflows = true;
     FLAG_gc_global = true;
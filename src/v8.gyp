@@ -928,11 +928,15 @@
         'handles.cc',
         'handles.h',
         'heap-symbols.h',
+        'heap/array-buffer-collector.cc',
+        'heap/array-buffer-collector.h',
         'heap/array-buffer-tracker-inl.h',
         'heap/array-buffer-tracker.cc',
         'heap/array-buffer-tracker.h',
         'heap/code-stats.cc',
         'heap/code-stats.h',
+        'heap/concurrent-marking.cc',
+        'heap/concurrent-marking.h',
         'heap/embedder-tracing.cc',
         'heap/embedder-tracing.h',
         'heap/memory-reducer.cc',
@@ -949,6 +953,7 @@
         'heap/incremental-marking-job.h',
         'heap/incremental-marking.cc',
         'heap/incremental-marking.h',
+        'heap/local-allocator.h',
         'heap/mark-compact-inl.h',
         'heap/mark-compact.cc',
         'heap/mark-compact.h',
@@ -971,6 +976,7 @@
         'heap/spaces.h',
         'heap/store-buffer.cc',
         'heap/store-buffer.h',
+        'heap/worklist.h',
         'i18n.cc',
         'i18n.h',
         'icu_util.cc',
@@ -1145,6 +1151,10 @@
         'profiler/heap-snapshot-generator-inl.h',
         'profiler/heap-snapshot-generator.cc',
         'profiler/heap-snapshot-generator.h',
+        'profiler/mpsc-queue-inl.h',
+        'profiler/mpsc-queue.h',
+        'profiler/pprof-profile-builder.cc',
+        'profiler/pprof-profile-builder.h',
         'profiler/profiler-listener.cc',
         'profiler/profiler-listener.h',
         'profiler/profile-generator-inl.h',
@@ -0,0 +1,180 @@
+#!/usr/bin/env python
+#
+# Copyright 2017 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+#
+# Converts a trace written by the binary trace writer of libplatform
+# (TraceWriter::CreateBinaryTraceWriter) to the JSON trace format produced by
+# the JSON trace writer, which can be loaded into chrome://tracing.
+#
+# Usage: trace-binary-to-json.py <binary-trace> [<json-trace>]
+#
+
+import json
+import math
+import struct
+import sys
+
+MAGIC = b"V8TB"
+FORMAT_VERSION = 1
+
+# Record tags, see BinaryTraceWriter::RecordTag.
+END = 0
+STRING = 1
+THREAD = 2
+EVENT = 3
+
+# See base/trace_event/common/trace_event_common.h.
+TRACE_EVENT_FLAG_HAS_ID = 1 << 1
+TYPE_BOOL = 1
+TYPE_UINT = 2
+TYPE_INT = 3
+TYPE_DOUBLE = 4
+TYPE_POINTER = 5
+TYPE_STRING = 6
+TYPE_COPY_STRING = 7
+TYPE_CONVERTABLE = 8
+
+
+class Reader(object):
+  def __init__(self, data):
+    self.data = bytearray(data)
+    self.pos = 0
+
+  def byte(self):
+    value = self.data[self.pos]
+    self.pos += 1
+    return value
+
+  def bytes(self, length):
+    value = self.data[self.pos:self.pos + length]
+    self.pos += length
+    return bytes(value)
+
+  def varint(self):
+    result = 0
+    shift = 0
+    while True:
+      b = self.byte()
+      result |= (b & 0x7f) << shift
+      if b < 0x80:
+        return result
+      shift += 7
+
+  def signed_varint(self):
+    value = self.varint()
+    return (value >> 1) ^ -(value & 1)
+
+
+def format_double(value):
+  # Mirrors JSONTraceWriter::AppendArgValue.
+  if math.isnan(value):
+    return '"NaN"'
+  if math.isinf(value):
+    return '"-Infinity"' if value < 0 else '"Infinity"'
+  real = repr(value)
+  if '.' not in real and 'e' not in real and 'E' not in real:
+    real += '.0'
+  return real
+
+
+def read_string_value(reader):
+  length = reader.varint()
+  if length == 0:
+    return None
+  return reader.bytes(length - 1).decode('utf-8', 'replace')
+
+
+def format_arg(reader, arg_type):
+  if arg_type == TYPE_BOOL:
+    return 'true' if reader.varint() else 'false'
+  if arg_type == TYPE_UINT:
+    return str(reader.varint())
+  if arg_type == TYPE_INT:
+    return str(reader.signed_varint())
+  if arg_type == TYPE_DOUBLE:
+    return format_double(struct.unpack('<d', reader.bytes(8))[0])
+  if arg_type == TYPE_POINTER:
+    return '"0x%x"' % reader.varint()
+  if arg_type in (TYPE_STRING, TYPE_COPY_STRING):
+    value = read_string_value(reader)
+    return '"NULL"' if value is None else json.dumps(value)
+  if arg_type == TYPE_CONVERTABLE:
+    # Convertables are already stored in the JSON trace format.
+    return read_string_value(reader)
+  raise Exception('Unknown argument type %d' % arg_type)
+
+
+def convert(data, out):
+  reader = Reader(data)
+  if reader.bytes(len(MAGIC)) != MAGIC:
+    raise Exception('Not a binary V8 trace')
+  version = reader.varint()
+  if version != FORMAT_VERSION:
+    raise Exception('Unsupported trace format version %d' % version)
+  strings = {}
+  threads = {}
+  pid = tid = 0
+  thread = None
+  separator = ''
+  out.write('{"traceEvents":[')
+  while reader.pos < len(reader.data):
+    tag = reader.varint()
+    if tag == END:
+      break
+    elif tag == STRING:
+      string_id = reader.varint()
+      strings[string_id] = reader.bytes(reader.varint()).decode('utf-8',
+                                                                'replace')
+    elif tag == THREAD:
+      pid = reader.signed_varint()
+      tid = reader.signed_varint()
+      thread = threads.setdefault(tid, {'ts': 0, 'tts': 0})
+    elif tag == EVENT:
+      phase = chr(reader.byte())
+      category = strings[reader.varint()]
+      name = strings[reader.varint()]
+      thread['ts'] += reader.signed_varint()
+      thread['tts'] += reader.signed_varint()
+      duration = reader.varint()
+      cpu_duration = reader.varint()
+      flags = reader.varint()
+      event = ('{"pid":%d,"tid":%d,"ts":%d,"tts":%d,"ph":"%s","cat":"%s",'
+               '"name":"%s","dur":%d,"tdur":%d' %
+               (pid, tid, thread['ts'], thread['tts'], phase, category, name,
+                duration, cpu_duration))
+      if flags & TRACE_EVENT_FLAG_HAS_ID:
+        scope = reader.varint()
+        if scope != 0:
+          event += ',"scope":"%s"' % strings[scope]
+        event += ',"id":"0x%x"' % reader.varint()
+      args = []
+      for _ in range(reader.varint()):
+        arg_name = strings[reader.varint()]
+        arg_type = reader.byte()
+        args.append('"%s":%s' % (arg_name, format_arg(reader, arg_type)))
+      out.write('%s%s,"args":{%s}}' % (separator, event, ','.join(args)))
+      separator = ','
+    else:
+      raise Exception('Unknown record tag %d' % tag)
+  out.write(']}')
+
+
+def main(argv):
+  if len(argv) not in (2, 3):
+    print("Usage: %s <binary-trace> [<json-trace>]" % argv[0])
+    return 1
+  with open(argv[1], 'rb') as f:
+    data = f.read()
+  if len(argv) == 3:
+    with open(argv[2], 'w') as out:
+      convert(data, out)
+  else:
+    convert(data, sys.stdout)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv))